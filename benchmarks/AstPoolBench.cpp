@@ -0,0 +1,101 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include "Ast/AstArena.hpp"
+#include "Ast/AstWalker.hpp"
+#include "Corpus.hpp"
+#include "Driver/Context.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+using namespace lbc;
+
+// Traverse an analysed corpus whose nodes were allocated per group, or all
+// from the shared context arena as before the pools. Cache misses are
+// reported with --benchmark_perf_counters=CACHE-MISSES,DTLB-LOAD-MISSES
+// when Google Benchmark is built with libpfm.
+
+namespace {
+
+/**
+ * A parsed and analysed corpus.
+ */
+struct Program final {
+    Program(const std::size_t functions, const AstArena::Pooling pooling) {
+        context.getAstArena().setPooling(pooling);
+        Parser parser { context, bench::addSource(context, bench::corpus(functions)) };
+        const auto parsed = parser.parse();
+        if (not parsed.has_value()) {
+            return;
+        }
+        SemanticAnalyser analyser { context };
+        if (analyser.analyse(**parsed).has_value()) {
+            module = *parsed;
+        }
+    }
+
+    Context context;
+    AstModule* module = nullptr;
+};
+
+/**
+ * Read the types of every expression, the way a pass over expressions does.
+ * Other nodes are only passed through on the way down.
+ */
+void expressions(benchmark::State& state, const AstArena::Pooling pooling) {
+    Program program(static_cast<std::size_t>(state.range(0)), pooling);
+    if (program.module == nullptr) {
+        state.SkipWithError("compile failed");
+        return;
+    }
+
+    AstWalker walker;
+    std::size_t nodes = 0;
+    for (auto _ : state) {
+        nodes = 0;
+        const auto result = walker.postOrder(*program.module, [&](const AstRoot& node) -> DiagResult<void> {
+            if (const auto* expr = llvm::dyn_cast<AstExpr>(&node)) {
+                benchmark::DoNotOptimize(expr->getType());
+                nodes++;
+            }
+            return {};
+        });
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(nodes));
+}
+
+/**
+ * Read the kind of every statement in the top level and body statement lists.
+ */
+void statements(benchmark::State& state, const AstArena::Pooling pooling) {
+    Program program(static_cast<std::size_t>(state.range(0)), pooling);
+    if (program.module == nullptr) {
+        state.SkipWithError("compile failed");
+        return;
+    }
+
+    std::size_t nodes = 0;
+    for (auto _ : state) {
+        nodes = 0;
+        for (const auto* stmt : program.module->getStmtList()->getStmts()) {
+            benchmark::DoNotOptimize(stmt->getKind());
+            nodes++;
+            if (const auto* func = llvm::dyn_cast<AstFuncStmt>(stmt)) {
+                for (const auto* inner : func->getStmtList()->getStmts()) {
+                    benchmark::DoNotOptimize(inner->getKind());
+                    nodes++;
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(nodes));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(expressions, perGroup, AstArena::Pooling::PerGroup)->Name("AstPool/expressionsPerGroup")->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(expressions, shared, AstArena::Pooling::Shared)->Name("AstPool/expressionsShared")->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(statements, perGroup, AstArena::Pooling::PerGroup)->Name("AstPool/statementsPerGroup")->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(statements, shared, AstArena::Pooling::Shared)->Name("AstPool/statementsShared")->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
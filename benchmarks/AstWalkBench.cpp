@@ -0,0 +1,111 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include "Ast/Ast.hpp"
+#include "Ast/AstWalker.hpp"
+#include "Corpus.hpp"
+#include "Driver/Context.hpp"
+#include "Parser/Parser.hpp"
+using namespace lbc;
+
+// Both walks visit the same nodes in the same post-order. The counters
+// report how deep each one had to go: native stack bytes for the recursive
+// walk, explicit stack entries for AstWalker.
+
+namespace {
+
+/**
+ * A program assigning one left leaning chain of `terms` additions.
+ */
+auto chain(const std::size_t terms) -> std::string {
+    std::string source = "DIM x AS INTEGER = 1\nx = x";
+    for (std::size_t term = 1; term < terms; term++) {
+        source += " + x";
+    }
+    source += "\n";
+    return source;
+}
+
+/**
+ * Parse a chain once, the walks only read the tree.
+ */
+struct Tree final {
+    explicit Tree(const std::size_t terms)
+    : source(chain(terms))
+    , parser(context, bench::addSource(context, source)) {}
+
+    std::string source;
+    Context context;
+    Parser parser;
+};
+
+/// Lowest stack address seen by the recursive walk
+std::uintptr_t stackLow = 0;
+
+/**
+ * Post-order walk on the native call stack.
+ */
+auto recurse(AstRoot& node) -> std::size_t {
+    const char marker = 0;
+    stackLow = std::min(stackLow, reinterpret_cast<std::uintptr_t>(&marker)); // NOLINT(*-reinterpret-cast)
+    std::size_t count = 0;
+    forEachChild(node, [&](AstRoot& child) { count += recurse(child); });
+    benchmark::DoNotOptimize(node.getKind());
+    return count + 1;
+}
+
+/**
+ * Walk the tree recursively.
+ */
+void recursive(benchmark::State& state) {
+    Tree tree(static_cast<std::size_t>(state.range(0)));
+    const auto module = tree.parser.parse();
+    if (!module.has_value()) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+
+    const char top = 0;
+    const auto stackTop = reinterpret_cast<std::uintptr_t>(&top); // NOLINT(*-reinterpret-cast)
+    stackLow = stackTop;
+    std::size_t nodes = 0;
+    for (auto _ : state) {
+        nodes = recurse(**module);
+        benchmark::DoNotOptimize(nodes);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(nodes));
+    state.counters["stackBytes"] = static_cast<double>(stackTop - stackLow);
+}
+
+/**
+ * Walk the tree on AstWalker's explicit stack.
+ */
+void iterative(benchmark::State& state) {
+    Tree tree(static_cast<std::size_t>(state.range(0)));
+    const auto module = tree.parser.parse();
+    if (!module.has_value()) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+
+    AstWalker walker;
+    std::size_t nodes = 0;
+    for (auto _ : state) {
+        nodes = 0;
+        const auto result = walker.postOrder(**module, [&](const AstRoot& node) -> DiagResult<void> {
+            benchmark::DoNotOptimize(node.getKind());
+            nodes++;
+            return {};
+        });
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(nodes));
+    state.counters["maxDepth"] = static_cast<double>(walker.getMaxDepth());
+}
+
+} // namespace
+
+BENCHMARK(recursive)->Name("AstWalk/recursive")->RangeMultiplier(8)->Range(64, 16384)->Unit(benchmark::kMicrosecond);
+BENCHMARK(iterative)->Name("AstWalk/iterative")->RangeMultiplier(8)->Range(64, 16384)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,113 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include <llvm/IR/Module.h>
+#include "Corpus.hpp"
+#include "Driver/Context.hpp"
+#include "Gen/Generator.hpp"
+#include "IR/gen/IrGenerator.hpp"
+#include "IR/lib/Module.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+using namespace lbc;
+
+namespace {
+
+/**
+ * The frontend stages of one iteration. Kept alive between iterations, so the
+ * previous pipeline is torn down while timing is paused.
+ */
+struct Frontend final {
+    std::optional<Context> context;
+    std::optional<Parser> parser;
+    std::optional<SemanticAnalyser> sema;
+    std::optional<ir::gen::IrGenerator> irGen;
+
+    /**
+     * Parse and analyse source in a fresh context. Returns the AST, or nullptr
+     * if a stage failed.
+     */
+    [[nodiscard]] auto analyse(const std::string& source) -> AstModule* {
+        irGen.reset();
+        sema.reset();
+        parser.reset();
+        context.emplace();
+        parser.emplace(*context, bench::addSource(*context, source));
+        const auto module = parser->parse();
+        if (!module.has_value()) {
+            return nullptr;
+        }
+        sema.emplace(*context);
+        if (!sema->analyse(**module).has_value()) {
+            return nullptr;
+        }
+        return *module;
+    }
+};
+
+/**
+ * Lower an analysed AST of the corpus to lbc IR.
+ */
+void irGenerator(benchmark::State& state) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    Frontend frontend;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto* ast = frontend.analyse(source);
+        if (ast == nullptr) {
+            state.SkipWithError("frontend failed");
+            return;
+        }
+        frontend.irGen.emplace(*frontend.context);
+        state.ResumeTiming();
+
+        const auto module = frontend.irGen->generate(*ast);
+        if (!module.has_value()) {
+            state.SkipWithError("IR generation failed");
+            return;
+        }
+        benchmark::DoNotOptimize(*module);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(source.size()));
+}
+
+/**
+ * Lower lbc IR of the corpus to an LLVM module.
+ */
+void generator(benchmark::State& state) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    Frontend frontend;
+    std::optional<gen::Generator> generate;
+    std::unique_ptr<llvm::Module> module;
+    for (auto _ : state) {
+        state.PauseTiming();
+        generate.reset();
+        module.reset();
+        auto* ast = frontend.analyse(source);
+        if (ast == nullptr) {
+            state.SkipWithError("frontend failed");
+            return;
+        }
+        frontend.irGen.emplace(*frontend.context);
+        const auto ir = frontend.irGen->generate(*ast);
+        if (!ir.has_value()) {
+            state.SkipWithError("IR generation failed");
+            return;
+        }
+        generate.emplace(*frontend.context);
+        state.ResumeTiming();
+
+        module = generate->generate(**ir);
+        benchmark::DoNotOptimize(module.get());
+    }
+    generate.reset();
+    module.reset();
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(source.size()));
+}
+
+} // namespace
+
+BENCHMARK(irGenerator)->Name("IrGenerator/generate")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(generator)->Name("Generator/generate")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
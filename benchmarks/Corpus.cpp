@@ -0,0 +1,203 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "Corpus.hpp"
+#include <map>
+#include <random>
+#include "Driver/Context.hpp"
+using namespace lbc;
+
+namespace {
+
+/// Binary operators valid between any two INTEGER operands
+constexpr std::array<llvm::StringRef, 3> kOperators { " + ", " - ", " * " };
+
+/**
+ * Writes one program, tracking the names that are in scope.
+ */
+class ProgramWriter final {
+public:
+    explicit ProgramWriter(const bench::CorpusOptions& options)
+    : m_options(options)
+    , m_rng(options.seed) {}
+
+    [[nodiscard]] auto write() -> std::string {
+        for (std::size_t idx = 0; idx < m_options.functions; idx++) {
+            definition(idx);
+        }
+        topLevel();
+        return std::move(m_out);
+    }
+
+private:
+    /// A definition that later code may call
+    struct Callable final {
+        std::string name;
+        bool isFunction;
+    };
+
+    /// Uniform value below bound. Plain modulo keeps the sequence identical on every platform
+    [[nodiscard]] auto next(const std::size_t bound) -> std::size_t {
+        return static_cast<std::size_t>(m_rng() % bound);
+    }
+
+    [[nodiscard]] auto chance(const std::size_t oneIn) -> bool {
+        return next(oneIn) == 0;
+    }
+
+    [[nodiscard]] auto pick(const std::vector<std::string>& names) -> const std::string& {
+        return names[next(names.size())];
+    }
+
+    void definition(const std::size_t index) {
+        // the first definition is a function, so later bodies have something to call
+        const bool isFunction = index == 0 || !chance(3);
+        auto name = (isFunction ? "F" : "S") + std::to_string(index);
+        m_out += isFunction ? "FUNCTION " : "SUB ";
+        m_out += name;
+        m_out += "(a AS INTEGER, b AS INTEGER)";
+        if (isFunction) {
+            m_out += " AS INTEGER";
+        }
+        m_out += '\n';
+
+        m_locals = { "a", "b" };
+        if (m_options.dimListLength > 0) {
+            dimList();
+        }
+
+        for (std::size_t idx = 0; idx < m_options.statements; idx++) {
+            statement();
+        }
+
+        if (isFunction) {
+            m_out += "    RETURN ";
+            expression(0, m_options.expressionTerms);
+            m_out += '\n';
+        }
+        m_out += isFunction ? "END FUNCTION\n\n" : "END SUB\n\n";
+
+        // added after the body, so definitions never recurse
+        if (isFunction) {
+            m_functions.push_back(name);
+        } else {
+            m_subs.push_back(name);
+        }
+        m_callables.push_back({ .name = std::move(name), .isFunction = isFunction });
+    }
+
+    void dimList() {
+        m_out += "    DIM ";
+        for (std::size_t idx = 0; idx < m_options.dimListLength; idx++) {
+            if (idx > 0) {
+                m_out += ", ";
+            }
+            m_out += "v" + std::to_string(idx);
+            if (chance(2)) {
+                m_out += " AS INTEGER";
+            }
+            m_out += " = ";
+            expression(0, m_options.expressionTerms);
+        }
+        m_out += '\n';
+        for (std::size_t idx = 0; idx < m_options.dimListLength; idx++) {
+            m_locals.push_back("v" + std::to_string(idx));
+        }
+    }
+
+    void statement() {
+        m_out += "    ";
+        if (!m_subs.empty() && chance(3)) {
+            // arguments are kept flat: a leading "(" would read as a function call
+            m_out += pick(m_subs);
+            m_out += ' ';
+            expression(m_options.nestingDepth, 2);
+            m_out += ", ";
+            expression(m_options.nestingDepth, 2);
+        } else {
+            m_out += pick(m_locals);
+            m_out += " = ";
+            expression(0, m_options.expressionTerms);
+        }
+        m_out += '\n';
+    }
+
+    void expression(const std::size_t depth, const std::size_t terms) {
+        for (std::size_t idx = 0; idx < terms; idx++) {
+            if (idx > 0) {
+                m_out += kOperators.at(next(kOperators.size()));
+            }
+            operand(depth, idx == 0);
+        }
+    }
+
+    void operand(const std::size_t depth, const bool first) {
+        // the first operand of every level opens the next one down to the deepest
+        // level; other operands only branch off a top level expression
+        if (depth < m_options.nestingDepth && (first || (depth == 0 && chance(8)))) {
+            m_out += '(';
+            expression(depth + 1, 2 + next(2));
+            m_out += ')';
+            return;
+        }
+
+        switch (next(4)) {
+        case 0:
+            m_out += std::to_string(next(1000));
+            return;
+        case 1:
+            if (depth < m_options.nestingDepth && !m_functions.empty()) {
+                m_out += pick(m_functions);
+                m_out += '(';
+                expression(m_options.nestingDepth, 1 + next(2));
+                m_out += ", ";
+                expression(m_options.nestingDepth, 1 + next(2));
+                m_out += ')';
+                return;
+            }
+            [[fallthrough]];
+        default:
+            m_out += pick(m_locals);
+            return;
+        }
+    }
+
+    void topLevel() {
+        for (std::size_t idx = 0; idx < m_callables.size(); idx++) {
+            const auto& callable = m_callables[idx];
+            if (callable.isFunction) {
+                m_out += "DIM r" + std::to_string(idx) + " = " + callable.name + "(1, 2)\n";
+            } else {
+                m_out += callable.name + " 1, 2\n";
+            }
+        }
+    }
+
+    const bench::CorpusOptions& m_options;
+    std::mt19937_64 m_rng;
+    std::string m_out;
+    std::vector<Callable> m_callables;
+    std::vector<std::string> m_functions;
+    std::vector<std::string> m_subs;
+    std::vector<std::string> m_locals;
+};
+
+} // namespace
+
+auto bench::generateProgram(const CorpusOptions& options) -> std::string {
+    return ProgramWriter { options }.write();
+}
+
+auto bench::corpus(const std::size_t functions) -> const std::string& {
+    static std::map<std::size_t, std::string> cache;
+    auto [iter, inserted] = cache.try_emplace(functions);
+    if (inserted) {
+        iter->second = generateProgram({ .functions = functions });
+    }
+    return iter->second;
+}
+
+auto bench::addSource(Context& context, const llvm::StringRef source) -> unsigned {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "bench");
+    return context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+}
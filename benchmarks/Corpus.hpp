@@ -0,0 +1,48 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+namespace lbc {
+class Context;
+}
+
+namespace lbc::bench {
+
+/**
+ * Shape of a generated benchmark program.
+ */
+struct CorpusOptions final {
+    std::uint64_t seed = 0x1BC;      ///< generator seed, equal seeds give equal programs
+    std::size_t functions = 64;      ///< number of SUB and FUNCTION definitions
+    std::size_t statements = 16;     ///< statements in each body
+    std::size_t expressionTerms = 8; ///< operands in a top level expression
+    std::size_t nestingDepth = 6;    ///< deepest parenthesised sub-expression
+    std::size_t dimListLength = 8;   ///< variables declared by the DIM opening each body
+};
+
+/**
+ * Generate a valid BASIC program with the given shape.
+ *
+ * Every body opens with a long DIM list, followed by assignments, SUB calls
+ * and a RETURN for functions. Expressions mix literals, variables, calls to
+ * earlier functions and nested parenthesised sub-expressions. Only INTEGER
+ * values are used, so every program passes semantic analysis. The top level
+ * calls each definition once. Output depends only on the options, using a
+ * fixed engine and no library distributions, so numbers are reproducible
+ * across platforms.
+ */
+[[nodiscard]] auto generateProgram(const CorpusOptions& options) -> std::string;
+
+/**
+ * Program with the default shape and the given number of definitions,
+ * generated once and cached for the lifetime of the process.
+ */
+[[nodiscard]] auto corpus(std::size_t functions) -> const std::string&;
+
+/**
+ * Add source text to the context's source manager and return its buffer id.
+ */
+[[nodiscard]] auto addSource(Context& context, llvm::StringRef source) -> unsigned;
+
+} // namespace lbc::bench
@@ -0,0 +1,157 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include "Corpus.hpp"
+#include "Driver/Context.hpp"
+#include "Lexer/Lexer.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+using namespace lbc;
+
+// Each iteration works on a fresh Context. The objects of the previous
+// iteration are destroyed while timing is paused, so teardown is not measured.
+
+namespace {
+
+/**
+ * Lex the whole corpus token by token.
+ */
+void lexer(benchmark::State& state) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    std::optional<Context> context;
+    std::optional<Lexer> lex;
+    std::size_t tokens = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        lex.reset();
+        context.emplace();
+        lex.emplace(*context, bench::addSource(*context, source));
+        state.ResumeTiming();
+
+        while (true) {
+            const auto token = lex->next();
+            if (!token.has_value()) {
+                state.SkipWithError("lexer error");
+                return;
+            }
+            tokens++;
+            if (token->kind() == TokenKind::EndOfFile) {
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(source.size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Lex and parse the corpus into an AST. Up front tokenising lets the
+ * parser parse SUB and FUNCTION bodies in parallel.
+ */
+void parser(benchmark::State& state, const Parser::Tokenise tokenise) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    std::optional<Context> context;
+    std::optional<Parser> parse;
+    for (auto _ : state) {
+        state.PauseTiming();
+        parse.reset();
+        context.emplace();
+        parse.emplace(*context, bench::addSource(*context, source), tokenise);
+        state.ResumeTiming();
+
+        const auto module = parse->parse();
+        if (!module.has_value()) {
+            state.SkipWithError("parse failed");
+            return;
+        }
+        benchmark::DoNotOptimize(*module);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(source.size()));
+}
+
+/**
+ * Analyse a freshly parsed AST of the corpus.
+ */
+void sema(benchmark::State& state) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    std::optional<Context> context;
+    std::optional<Parser> parse;
+    std::optional<SemanticAnalyser> analyser;
+    for (auto _ : state) {
+        state.PauseTiming();
+        analyser.reset();
+        parse.reset();
+        context.emplace();
+        parse.emplace(*context, bench::addSource(*context, source));
+        const auto module = parse->parse();
+        if (!module.has_value()) {
+            state.SkipWithError("parse failed");
+            return;
+        }
+        analyser.emplace(*context);
+        state.ResumeTiming();
+
+        if (!analyser->analyse(**module).has_value()) {
+            state.SkipWithError("semantic analysis failed");
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(source.size()));
+}
+
+/**
+ * Source with a single expression of @p terms operands, typed BYTE. Typed
+ * operands alternate with literals, so every binary expression coerces a
+ * literal, or only literals are used, so the whole chain is coerced at once.
+ */
+auto longExpression(const std::size_t terms, const bool literalsOnly) -> std::string {
+    std::string source = "DIM b AS BYTE = 1\nDIM x AS BYTE = 1";
+    for (std::size_t term = 1; term < terms; term++) {
+        source += (literalsOnly || term % 2 == 0) ? std::format(" + {}", term % 100) : std::string { " + b" };
+    }
+    source += "\n";
+    return source;
+}
+
+/**
+ * Analyse a single long expression chain. Typing visits every node once,
+ * so the time per term stays flat as the chain grows.
+ */
+void expression(benchmark::State& state, const bool literalsOnly) {
+    const auto terms = static_cast<std::size_t>(state.range(0));
+    const auto source = longExpression(terms, literalsOnly);
+    std::optional<Context> context;
+    std::optional<Parser> parse;
+    std::optional<SemanticAnalyser> analyser;
+    for (auto _ : state) {
+        state.PauseTiming();
+        analyser.reset();
+        parse.reset();
+        context.emplace();
+        parse.emplace(*context, bench::addSource(*context, source));
+        const auto module = parse->parse();
+        if (!module.has_value()) {
+            state.SkipWithError("parse failed");
+            return;
+        }
+        analyser.emplace(*context);
+        state.ResumeTiming();
+
+        if (!analyser->analyse(**module).has_value()) {
+            state.SkipWithError("semantic analysis failed");
+            return;
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(terms));
+}
+
+} // namespace
+
+BENCHMARK(lexer)->Name("Lexer/next")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(parser, onDemand, Parser::Tokenise::OnDemand)->Name("Parser/parse")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(parser, upfront, Parser::Tokenise::Upfront)->Name("Parser/parseUpfront")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(sema)->Name("SemanticAnalyser/analyse")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(expression, mixed, false)->Name("SemanticAnalyser/expression")->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(expression, literals, true)->Name("SemanticAnalyser/literalExpression")->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
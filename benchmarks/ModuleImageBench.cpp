@@ -0,0 +1,108 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include <llvm/Support/FileSystem.h>
+#include "Ast/AstImage.hpp"
+#include "Corpus.hpp"
+#include "Driver/Context.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+using namespace lbc;
+
+// Bring an analysed module into a fresh Context, either by loading its image
+// or by parsing and analysing the source again. The objects of the previous
+// iteration are destroyed while timing is paused, so teardown is not measured.
+
+namespace {
+
+/**
+ * Image of an analysed corpus in a temporary file.
+ */
+struct Image final {
+    NO_COPY_AND_MOVE(Image)
+
+    explicit Image(const std::size_t functions) {
+        Context context;
+        Parser parser { context, bench::addSource(context, bench::corpus(functions)) };
+        const auto parsed = parser.parse();
+        if (not parsed.has_value()) {
+            return;
+        }
+        SemanticAnalyser analyser { context };
+        if (not analyser.analyse(**parsed).has_value()) {
+            return;
+        }
+        path = context.createTempFile("lbca");
+        AstImageWriter writer { context };
+        if (path.empty() || not writer.write(**parsed, path).has_value()) {
+            path.clear();
+        }
+    }
+
+    ~Image() {
+        if (not path.empty()) {
+            std::ignore = llvm::sys::fs::remove(path);
+        }
+    }
+
+    std::string path;
+};
+
+/**
+ * Load the image of the corpus.
+ */
+void load(benchmark::State& state) {
+    const Image image { static_cast<std::size_t>(state.range(0)) };
+    if (image.path.empty()) {
+        state.SkipWithError("compile failed");
+        return;
+    }
+    std::optional<Context> context;
+    for (auto _ : state) {
+        state.PauseTiming();
+        context.emplace();
+        state.ResumeTiming();
+
+        AstImageReader reader { *context };
+        const auto module = reader.load(image.path);
+        if (not module.has_value()) {
+            state.SkipWithError("load failed");
+            return;
+        }
+        benchmark::DoNotOptimize(*module);
+    }
+}
+
+/**
+ * Parse and analyse the corpus, the work an image replaces.
+ */
+void compile(benchmark::State& state) {
+    const auto& source = bench::corpus(static_cast<std::size_t>(state.range(0)));
+    std::optional<Context> context;
+    for (auto _ : state) {
+        state.PauseTiming();
+        context.emplace();
+        const auto id = bench::addSource(*context, source);
+        state.ResumeTiming();
+
+        Parser parser { *context, id };
+        const auto module = parser.parse();
+        if (not module.has_value()) {
+            state.SkipWithError("parse failed");
+            return;
+        }
+        SemanticAnalyser analyser { *context };
+        if (not analyser.analyse(**module).has_value()) {
+            state.SkipWithError("semantic analysis failed");
+            return;
+        }
+        benchmark::DoNotOptimize(*module);
+    }
+}
+
+} // namespace
+
+BENCHMARK(load)->Name("ModuleImage/load")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(compile)->Name("ModuleImage/compile")->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,90 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "Driver/Context.hpp"
+#include "Type/Aggregate.hpp"
+#include "Type/Compound.hpp"
+using namespace lbc;
+
+// Hash-cons types from several threads sharing one TypeFactory. Lookups of
+// existing types are what sema does most, creation is where threads contend
+// for a shard's arena as well as its lock. Compare items per second across
+// thread counts to see how much the shards contend.
+
+namespace {
+
+/// Context shared by the threads of a run, set up and torn down by thread 0
+std::unique_ptr<Context> shared; // NOLINT(*-avoid-non-const-global-variables)
+
+/** Types every thread builds compound types from. */
+auto bases(TypeFactory& tf) -> std::array<const Type*, 8> {
+    return { tf.getBool(), tf.getZString(), tf.getByte(), tf.getShort(), tf.getInteger(), tf.getULongInt(), tf.getSingle(), tf.getDouble() };
+}
+
+/**
+ * Get pointer, reference, const and function types that already exist.
+ */
+void lookup(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared = std::make_unique<Context>();
+    }
+
+    std::size_t items = 0;
+    for (auto _ : state) {
+        auto& tf = shared->getTypeFactory();
+        for (const auto* base : bases(tf)) {
+            const auto* ptr = tf.getPointer(base);
+            std::array<const Type*, 2> params { base, ptr };
+            benchmark::DoNotOptimize(tf.getPointer(ptr));
+            benchmark::DoNotOptimize(tf.getReference(base));
+            benchmark::DoNotOptimize(tf.getConst(base));
+            benchmark::DoNotOptimize(tf.getFunction(params, base));
+            items += 5;
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(items));
+
+    if (state.thread_index() == 0) {
+        shared.reset();
+    }
+}
+
+/**
+ * Create a new pointer type on every call, each thread extending a chain
+ * of its own so no two threads create the same type.
+ */
+void create(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared = std::make_unique<Context>();
+    }
+
+    const Type* current = nullptr;
+    std::size_t items = 0;
+    for (auto _ : state) {
+        auto& tf = shared->getTypeFactory();
+        if (current == nullptr) {
+            // CONST INTEGER PTR ... PTR, with a pointer per thread index, is unique to the thread
+            current = tf.getInteger();
+            for (auto level = 0; level < state.thread_index(); level++) {
+                current = tf.getPointer(current);
+            }
+            current = tf.getConst(current);
+        }
+        current = tf.getPointer(current);
+        benchmark::DoNotOptimize(current);
+        items++;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(items));
+
+    if (state.thread_index() == 0) {
+        shared.reset();
+    }
+}
+
+} // namespace
+
+BENCHMARK(lookup)->Name("TypeFactory/lookup")->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(create)->Name("TypeFactory/create")->ThreadRange(1, 16)->UseRealTime();
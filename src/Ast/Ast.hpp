@@ -8,10 +8,12 @@
 // clang-format off
 #pragma once
 #include "pch.hpp"
+#include "Diag/SourceRange.hpp"
 #include "Symbol/LiteralValue.hpp"
 #include "Lexer/TokenKind.hpp"
 #include "Ast/ValueCategory.hpp"
 #include "Symbol/ExternKind.hpp"
+#include "Symbol/Identifier.hpp"
 namespace lbc {
 
 class Type;
@@ -36,10 +38,13 @@ enum class AstKind : std::uint8_t {
     FuncStmt,
     ReturnStmt,
     DimStmt,
+    ConstStmt,
     AssignStmt,
     IfStmt,
     Extern,
+    Import,
     VarDecl,
+    ConstDecl,
     FuncDecl,
     FuncParamDecl,
     CastExpr,
@@ -69,11 +74,14 @@ class AstDeclareStmt;
 class AstFuncStmt;
 class AstReturnStmt;
 class AstDimStmt;
+class AstConstStmt;
 class AstAssignStmt;
 class AstIfStmt;
 class AstExtern;
+class AstImport;
 class AstDecl;
 class AstVarDecl;
+class AstConstDecl;
 class AstFuncDecl;
 class AstFuncParamDecl;
 class AstExpr;
@@ -102,7 +110,7 @@ protected:
      */
     constexpr explicit AstRoot(
         const AstKind kind,
-        const llvm::SMRange range
+        const SourceRange range
     )
     : m_kind(kind)
     , m_range(range) {}
@@ -114,7 +122,7 @@ public:
     }
 
     /// Number of leaf nodes
-    static constexpr std::size_t NODE_COUNT = 24;
+    static constexpr std::size_t NODE_COUNT = 27;
 
     /// Get the kind discriminator for this node
     [[nodiscard]] constexpr auto getKind() const -> AstKind {
@@ -128,24 +136,24 @@ public:
     }
 
     /// Get the range
-    [[nodiscard]] constexpr auto getRange() const -> llvm::SMRange {
+    [[nodiscard]] constexpr auto getRange() const -> SourceRange {
         return m_range;
     }
 
-    /// Get the next
-    [[nodiscard]] constexpr auto getNext() const -> AstRoot* {
-        return m_next;
+    /// Set the range
+    void setRange(const SourceRange range) {
+        m_range = range;
     }
 
-    /// Set the next
-    void setNext(AstRoot* next) {
-        m_next = next;
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        fn(m_range);
     }
 
 private:
     AstKind m_kind;
-    llvm::SMRange m_range;
-    AstRoot* m_next = nullptr;
+    SourceRange m_range;
     static constexpr std::array<llvm::StringRef, NODE_COUNT> kClassNames {
         "AstModule",
         "AstBuiltInType",
@@ -158,10 +166,13 @@ private:
         "AstFuncStmt",
         "AstReturnStmt",
         "AstDimStmt",
+        "AstConstStmt",
         "AstAssignStmt",
         "AstIfStmt",
         "AstExtern",
+        "AstImport",
         "AstVarDecl",
+        "AstConstDecl",
         "AstFuncDecl",
         "AstFuncParamDecl",
         "AstCastExpr",
@@ -183,7 +194,7 @@ public:
      * Construct an AstModule node
      */
     constexpr AstModule(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstStmtList* stmtList
     )
     : AstRoot(AstKind::Module, range)
@@ -199,6 +210,13 @@ public:
         return m_stmtList;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstRoot::forEachField(fn);
+        fn(m_stmtList);
+    }
+
 private:
     AstStmtList* m_stmtList;
 };
@@ -230,6 +248,13 @@ public:
         m_type = type;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstRoot::forEachField(fn);
+        fn(m_type);
+    }
+
 private:
     const Type* m_type = nullptr;
 };
@@ -243,7 +268,7 @@ public:
      * Construct an AstBuiltInType node
      */
     constexpr AstBuiltInType(
-        const llvm::SMRange range,
+        const SourceRange range,
         const TokenKind tokenKind
     )
     : AstType(AstKind::BuiltInType, range)
@@ -259,6 +284,13 @@ public:
         return m_tokenKind;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstType::forEachField(fn);
+        fn(m_tokenKind);
+    }
+
 private:
     TokenKind m_tokenKind;
 };
@@ -272,7 +304,7 @@ public:
      * Construct an AstPointerType node
      */
     constexpr AstPointerType(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstType* typeExpr
     )
     : AstType(AstKind::PointerType, range)
@@ -288,6 +320,13 @@ public:
         return m_typeExpr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstType::forEachField(fn);
+        fn(m_typeExpr);
+    }
+
 private:
     AstType* m_typeExpr;
 };
@@ -301,7 +340,7 @@ public:
      * Construct an AstReferenceType node
      */
     constexpr AstReferenceType(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstType* typeExpr
     )
     : AstType(AstKind::ReferenceType, range)
@@ -317,6 +356,13 @@ public:
         return m_typeExpr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstType::forEachField(fn);
+        fn(m_typeExpr);
+    }
+
 private:
     AstType* m_typeExpr;
 };
@@ -330,7 +376,7 @@ public:
      * Construct an AstConstType node
      */
     constexpr AstConstType(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstType* typeExpr
     )
     : AstType(AstKind::ConstType, range)
@@ -346,6 +392,13 @@ public:
         return m_typeExpr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstType::forEachField(fn);
+        fn(m_typeExpr);
+    }
+
 private:
     AstType* m_typeExpr;
 };
@@ -364,7 +417,7 @@ protected:
 public:
     /// LLVM RTTI support
     [[nodiscard]] static constexpr auto classof(const AstRoot* node) -> bool {
-        return node->getKind() >= AstKind::StmtList && node->getKind() <= AstKind::Extern;
+        return node->getKind() >= AstKind::StmtList && node->getKind() <= AstKind::Import;
     }
 };
 
@@ -377,7 +430,7 @@ public:
      * Construct an AstStmtList node
      */
     constexpr AstStmtList(
-        const llvm::SMRange range,
+        const SourceRange range,
         const std::span<AstDecl*> decls,
         const std::span<AstStmt*> stmts
     )
@@ -395,11 +448,21 @@ public:
         return m_decls;
     }
 
+    /// Set the decls
+    void setDecls(const std::span<AstDecl*> decls) {
+        m_decls = decls;
+    }
+
     /// Get the stmts
     [[nodiscard]] constexpr auto getStmts() const -> std::span<AstStmt*> {
         return m_stmts;
     }
 
+    /// Set the stmts
+    void setStmts(const std::span<AstStmt*> stmts) {
+        m_stmts = stmts;
+    }
+
     /// Get the symbolTable
     [[nodiscard]] constexpr auto getSymbolTable() const -> SymbolTable* {
         return m_symbolTable;
@@ -410,6 +473,15 @@ public:
         m_symbolTable = symbolTable;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_decls);
+        fn(m_stmts);
+        fn(m_symbolTable);
+    }
+
 private:
     std::span<AstDecl*> m_decls;
     std::span<AstStmt*> m_stmts;
@@ -425,7 +497,7 @@ public:
      * Construct an AstExprStmt node
      */
     constexpr AstExprStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* expr
     )
     : AstStmt(AstKind::ExprStmt, range)
@@ -446,6 +518,13 @@ public:
         m_expr = expr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_expr);
+    }
+
 private:
     AstExpr* m_expr;
 };
@@ -459,7 +538,7 @@ public:
      * Construct an AstDeclareStmt node
      */
     constexpr AstDeclareStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstFuncDecl* decl
     )
     : AstStmt(AstKind::DeclareStmt, range)
@@ -475,6 +554,13 @@ public:
         return m_decl;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_decl);
+    }
+
 private:
     AstFuncDecl* m_decl;
 };
@@ -488,7 +574,7 @@ public:
      * Construct an AstFuncStmt node
      */
     constexpr AstFuncStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstFuncDecl* decl,
         AstStmtList* stmtList
     )
@@ -511,7 +597,27 @@ public:
         return m_stmtList;
     }
 
+    /// Get the deferred
+    [[nodiscard]] constexpr auto getDeferred() const -> bool {
+        return m_deferred;
+    }
+
+    /// Set the deferred
+    void setDeferred(const bool deferred) {
+        m_deferred = deferred;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_deferred);
+        fn(m_decl);
+        fn(m_stmtList);
+    }
+
 private:
+    bool m_deferred = false;
     AstFuncDecl* m_decl;
     AstStmtList* m_stmtList;
 };
@@ -525,7 +631,7 @@ public:
      * Construct an AstReturnStmt node
      */
     constexpr AstReturnStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* expr
     )
     : AstStmt(AstKind::ReturnStmt, range)
@@ -546,6 +652,13 @@ public:
         m_expr = expr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_expr);
+    }
+
 private:
     AstExpr* m_expr;
 };
@@ -559,7 +672,7 @@ public:
      * Construct an AstDimStmt node
      */
     constexpr AstDimStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         const std::span<AstVarDecl*> decls
     )
     : AstStmt(AstKind::DimStmt, range)
@@ -575,10 +688,53 @@ public:
         return m_decls;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_decls);
+    }
+
 private:
     std::span<AstVarDecl*> m_decls;
 };
 
+/**
+ * CONST declaration statement
+ */
+class [[nodiscard]] AstConstStmt final : public AstStmt {
+public:
+    /**
+     * Construct an AstConstStmt node
+     */
+    constexpr AstConstStmt(
+        const SourceRange range,
+        const std::span<AstConstDecl*> decls
+    )
+    : AstStmt(AstKind::ConstStmt, range)
+    , m_decls(decls) {}
+
+    /// LLVM RTTI support
+    [[nodiscard]] static constexpr auto classof(const AstRoot* node) -> bool {
+        return node->getKind() == AstKind::ConstStmt;
+    }
+
+    /// Get the decls
+    [[nodiscard]] constexpr auto getDecls() const -> std::span<AstConstDecl*> {
+        return m_decls;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_decls);
+    }
+
+private:
+    std::span<AstConstDecl*> m_decls;
+};
+
 /**
  * Assignment statement
  */
@@ -588,7 +744,7 @@ public:
      * Construct an AstAssignStmt node
      */
     constexpr AstAssignStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* assignee,
         AstExpr* expr
     )
@@ -621,6 +777,14 @@ public:
         m_expr = expr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_assignee);
+        fn(m_expr);
+    }
+
 private:
     AstExpr* m_assignee;
     AstExpr* m_expr;
@@ -635,7 +799,7 @@ public:
      * Construct an AstIfStmt node
      */
     constexpr AstIfStmt(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* condition,
         AstStmt* thenStmt,
         AstStmt* elseStmt
@@ -670,6 +834,15 @@ public:
         return m_elseStmt;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_condition);
+        fn(m_thenStmt);
+        fn(m_elseStmt);
+    }
+
 private:
     AstExpr* m_condition;
     AstStmt* m_thenStmt;
@@ -685,7 +858,7 @@ public:
      * Construct an AstExtern node
      */
     constexpr AstExtern(
-        const llvm::SMRange range,
+        const SourceRange range,
         const ExternKind externKind,
         const std::span<AstStmt*> stmts
     )
@@ -708,11 +881,67 @@ public:
         return m_stmts;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_externKind);
+        fn(m_stmts);
+    }
+
 private:
     ExternKind m_externKind;
     std::span<AstStmt*> m_stmts;
 };
 
+/**
+ * IMPORT statement
+ */
+class [[nodiscard]] AstImport final : public AstStmt {
+public:
+    /**
+     * Construct an AstImport node
+     */
+    constexpr AstImport(
+        const SourceRange range,
+        const llvm::StringRef name
+    )
+    : AstStmt(AstKind::Import, range)
+    , m_name(name) {}
+
+    /// LLVM RTTI support
+    [[nodiscard]] static constexpr auto classof(const AstRoot* node) -> bool {
+        return node->getKind() == AstKind::Import;
+    }
+
+    /// Get the name
+    [[nodiscard]] constexpr auto getName() const -> llvm::StringRef {
+        return m_name;
+    }
+
+    /// Get the module
+    [[nodiscard]] constexpr auto getModule() const -> AstModule* {
+        return m_module;
+    }
+
+    /// Set the module
+    void setModule(AstModule* module) {
+        m_module = module;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstStmt::forEachField(fn);
+        fn(m_name);
+        fn(m_module);
+    }
+
+private:
+    llvm::StringRef m_name;
+    AstModule* m_module = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 // Decl nodes
 // -----------------------------------------------------------------------------
@@ -727,8 +956,8 @@ protected:
      */
     constexpr AstDecl(
         const AstKind kind,
-        const llvm::SMRange range,
-        const llvm::StringRef name
+        const SourceRange range,
+        const Identifier name
     )
     : AstRoot(kind, range)
     , m_name(name) {}
@@ -740,7 +969,7 @@ public:
     }
 
     /// Get the name
-    [[nodiscard]] constexpr auto getName() const -> llvm::StringRef {
+    [[nodiscard]] constexpr auto getName() const -> Identifier {
         return m_name;
     }
 
@@ -774,8 +1003,18 @@ public:
         m_symbol = symbol;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstRoot::forEachField(fn);
+        fn(m_name);
+        fn(m_sourceName);
+        fn(m_type);
+        fn(m_symbol);
+    }
+
 private:
-    llvm::StringRef m_name;
+    Identifier m_name;
     llvm::StringRef m_sourceName = {};
     const Type* m_type = nullptr;
     Symbol* m_symbol = nullptr;
@@ -790,8 +1029,8 @@ public:
      * Construct an AstVarDecl node
      */
     constexpr AstVarDecl(
-        const llvm::SMRange range,
-        const llvm::StringRef name,
+        const SourceRange range,
+        const Identifier name,
         AstType* typeExpr,
         AstExpr* expr
     )
@@ -819,6 +1058,65 @@ public:
         m_expr = expr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstDecl::forEachField(fn);
+        fn(m_typeExpr);
+        fn(m_expr);
+    }
+
+private:
+    AstType* m_typeExpr;
+    AstExpr* m_expr;
+};
+
+/**
+ * Constant declaration
+ */
+class [[nodiscard]] AstConstDecl final : public AstDecl {
+public:
+    /**
+     * Construct an AstConstDecl node
+     */
+    constexpr AstConstDecl(
+        const SourceRange range,
+        const Identifier name,
+        AstType* typeExpr,
+        AstExpr* expr
+    )
+    : AstDecl(AstKind::ConstDecl, range, name)
+    , m_typeExpr(typeExpr)
+    , m_expr(expr) {}
+
+    /// LLVM RTTI support
+    [[nodiscard]] static constexpr auto classof(const AstRoot* node) -> bool {
+        return node->getKind() == AstKind::ConstDecl;
+    }
+
+    /// Get the typeExpr
+    [[nodiscard]] constexpr auto getTypeExpr() const -> AstType* {
+        return m_typeExpr;
+    }
+
+    /// Get the expr
+    [[nodiscard]] constexpr auto getExpr() const -> AstExpr* {
+        return m_expr;
+    }
+
+    /// Set the expr
+    void setExpr(AstExpr* expr) {
+        m_expr = expr;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstDecl::forEachField(fn);
+        fn(m_typeExpr);
+        fn(m_expr);
+    }
+
 private:
     AstType* m_typeExpr;
     AstExpr* m_expr;
@@ -833,8 +1131,8 @@ public:
      * Construct an AstFuncDecl node
      */
     constexpr AstFuncDecl(
-        const llvm::SMRange range,
-        const llvm::StringRef name,
+        const SourceRange range,
+        const Identifier name,
         const std::span<AstFuncParamDecl*> params,
         AstType* retTypeExpr
     )
@@ -877,6 +1175,16 @@ public:
         m_variadic = variadic;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstDecl::forEachField(fn);
+        fn(m_params);
+        fn(m_retTypeExpr);
+        fn(m_impl);
+        fn(m_variadic);
+    }
+
 private:
     std::span<AstFuncParamDecl*> m_params;
     AstType* m_retTypeExpr;
@@ -893,8 +1201,8 @@ public:
      * Construct an AstFuncParamDecl node
      */
     constexpr AstFuncParamDecl(
-        const llvm::SMRange range,
-        const llvm::StringRef name,
+        const SourceRange range,
+        const Identifier name,
         AstType* typeExpr
     )
     : AstDecl(AstKind::FuncParamDecl, range, name)
@@ -910,6 +1218,13 @@ public:
         return m_typeExpr;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstDecl::forEachField(fn);
+        fn(m_typeExpr);
+    }
+
 private:
     AstType* m_typeExpr;
 };
@@ -961,10 +1276,31 @@ public:
         m_operand = operand;
     }
 
+    /// Get the original
+    [[nodiscard]] constexpr auto getOriginal() const -> AstExpr* {
+        return m_original;
+    }
+
+    /// Set the original
+    void setOriginal(AstExpr* original) {
+        m_original = original;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstRoot::forEachField(fn);
+        fn(m_valueCategory);
+        fn(m_type);
+        fn(m_operand);
+        fn(m_original);
+    }
+
 private:
-    const Type* m_type = nullptr;
     ValueCategory m_valueCategory = ValueCategory::Value;
+    const Type* m_type = nullptr;
     ir::lib::Value* m_operand = nullptr;
+    AstExpr* m_original = nullptr;
 };
 
 /**
@@ -976,7 +1312,7 @@ public:
      * Construct an AstCastExpr node
      */
     constexpr AstCastExpr(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* expr,
         AstType* typeExpr,
         const bool implicit
@@ -1021,6 +1357,15 @@ public:
         m_implicit = implicit;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_expr);
+        fn(m_typeExpr);
+        fn(m_implicit);
+    }
+
 private:
     AstExpr* m_expr;
     AstType* m_typeExpr;
@@ -1036,8 +1381,8 @@ public:
      * Construct an AstVarExpr node
      */
     constexpr AstVarExpr(
-        const llvm::SMRange range,
-        const llvm::StringRef name
+        const SourceRange range,
+        const Identifier name
     )
     : AstExpr(AstKind::VarExpr, range)
     , m_name(name) {}
@@ -1048,7 +1393,7 @@ public:
     }
 
     /// Get the name
-    [[nodiscard]] constexpr auto getName() const -> llvm::StringRef {
+    [[nodiscard]] constexpr auto getName() const -> Identifier {
         return m_name;
     }
 
@@ -1062,8 +1407,16 @@ public:
         m_symbol = symbol;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_name);
+        fn(m_symbol);
+    }
+
 private:
-    llvm::StringRef m_name;
+    Identifier m_name;
     Symbol* m_symbol = nullptr;
 };
 
@@ -1076,7 +1429,7 @@ public:
      * Construct an AstCallExpr node
      */
     constexpr AstCallExpr(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* callee,
         const std::span<AstExpr*> args
     )
@@ -1104,6 +1457,14 @@ public:
         return m_args;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_callee);
+        fn(m_args);
+    }
+
 private:
     AstExpr* m_callee;
     std::span<AstExpr*> m_args;
@@ -1118,11 +1479,13 @@ public:
      * Construct an AstLiteralExpr node
      */
     constexpr AstLiteralExpr(
-        const llvm::SMRange range,
-        const LiteralValue& value
+        const SourceRange range,
+        const LiteralValue& value,
+        const TokenKind typeSuffix
     )
     : AstExpr(AstKind::LiteralExpr, range)
-    , m_value(value) {}
+    , m_value(value)
+    , m_typeSuffix(typeSuffix) {}
 
     /// LLVM RTTI support
     [[nodiscard]] static constexpr auto classof(const AstRoot* node) -> bool {
@@ -1134,8 +1497,22 @@ public:
         return m_value;
     }
 
+    /// Get the typeSuffix
+    [[nodiscard]] constexpr auto getTypeSuffix() const -> TokenKind {
+        return m_typeSuffix;
+    }
+
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_value);
+        fn(m_typeSuffix);
+    }
+
 private:
     LiteralValue m_value;
+    TokenKind m_typeSuffix;
 };
 
 /**
@@ -1147,7 +1524,7 @@ public:
      * Construct an AstUnaryExpr node
      */
     constexpr AstUnaryExpr(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* expr,
         const TokenKind op
     )
@@ -1175,6 +1552,14 @@ public:
         return m_op;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_expr);
+        fn(m_op);
+    }
+
 private:
     AstExpr* m_expr;
     TokenKind m_op;
@@ -1189,7 +1574,7 @@ public:
      * Construct an AstBinaryExpr node
      */
     constexpr AstBinaryExpr(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* left,
         AstExpr* right,
         const TokenKind op
@@ -1229,6 +1614,15 @@ public:
         return m_op;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_left);
+        fn(m_right);
+        fn(m_op);
+    }
+
 private:
     AstExpr* m_left;
     AstExpr* m_right;
@@ -1244,7 +1638,7 @@ public:
      * Construct an AstMemberExpr node
      */
     constexpr AstMemberExpr(
-        const llvm::SMRange range,
+        const SourceRange range,
         AstExpr* left,
         AstExpr* right,
         const TokenKind op
@@ -1284,10 +1678,116 @@ public:
         return m_op;
     }
 
+    /// Call fn with every data member, base class members first
+    template <typename Fn>
+    constexpr void forEachField(Fn&& fn) {
+        AstExpr::forEachField(fn);
+        fn(m_left);
+        fn(m_right);
+        fn(m_op);
+    }
+
 private:
     AstExpr* m_left;
     AstExpr* m_right;
     TokenKind m_op;
 };
 
+// -----------------------------------------------------------------------------
+// Node sizes
+// -----------------------------------------------------------------------------
+
+#if INTPTR_MAX == INT64_MAX && !defined(_MSC_VER)
+static_assert(sizeof(AstRoot) == 12, "AstRoot layout differs from Ast.td");
+static_assert(sizeof(AstModule) == 24, "AstModule layout differs from Ast.td");
+static_assert(sizeof(AstType) == 24, "AstType layout differs from Ast.td");
+static_assert(sizeof(AstBuiltInType) == 32, "AstBuiltInType layout differs from Ast.td");
+static_assert(sizeof(AstPointerType) == 32, "AstPointerType layout differs from Ast.td");
+static_assert(sizeof(AstReferenceType) == 32, "AstReferenceType layout differs from Ast.td");
+static_assert(sizeof(AstConstType) == 32, "AstConstType layout differs from Ast.td");
+static_assert(sizeof(AstStmt) == 12, "AstStmt layout differs from Ast.td");
+static_assert(sizeof(AstStmtList) == 56, "AstStmtList layout differs from Ast.td");
+static_assert(sizeof(AstExprStmt) == 24, "AstExprStmt layout differs from Ast.td");
+static_assert(sizeof(AstDeclareStmt) == 24, "AstDeclareStmt layout differs from Ast.td");
+static_assert(sizeof(AstFuncStmt) == 32, "AstFuncStmt layout differs from Ast.td");
+static_assert(sizeof(AstReturnStmt) == 24, "AstReturnStmt layout differs from Ast.td");
+static_assert(sizeof(AstDimStmt) == 32, "AstDimStmt layout differs from Ast.td");
+static_assert(sizeof(AstConstStmt) == 32, "AstConstStmt layout differs from Ast.td");
+static_assert(sizeof(AstAssignStmt) == 32, "AstAssignStmt layout differs from Ast.td");
+static_assert(sizeof(AstIfStmt) == 40, "AstIfStmt layout differs from Ast.td");
+static_assert(sizeof(AstExtern) == 32, "AstExtern layout differs from Ast.td");
+static_assert(sizeof(AstImport) == 40, "AstImport layout differs from Ast.td");
+static_assert(sizeof(AstDecl) == 56, "AstDecl layout differs from Ast.td");
+static_assert(sizeof(AstVarDecl) == 72, "AstVarDecl layout differs from Ast.td");
+static_assert(sizeof(AstConstDecl) == 72, "AstConstDecl layout differs from Ast.td");
+static_assert(sizeof(AstFuncDecl) == 96, "AstFuncDecl layout differs from Ast.td");
+static_assert(sizeof(AstFuncParamDecl) == 64, "AstFuncParamDecl layout differs from Ast.td");
+static_assert(sizeof(AstExpr) == 32, "AstExpr layout differs from Ast.td");
+static_assert(sizeof(AstCastExpr) == 56, "AstCastExpr layout differs from Ast.td");
+static_assert(sizeof(AstVarExpr) == 48, "AstVarExpr layout differs from Ast.td");
+static_assert(sizeof(AstCallExpr) == 56, "AstCallExpr layout differs from Ast.td");
+static_assert(sizeof(AstLiteralExpr) == 64, "AstLiteralExpr layout differs from Ast.td");
+static_assert(sizeof(AstUnaryExpr) == 48, "AstUnaryExpr layout differs from Ast.td");
+static_assert(sizeof(AstBinaryExpr) == 56, "AstBinaryExpr layout differs from Ast.td");
+static_assert(sizeof(AstMemberExpr) == 56, "AstMemberExpr layout differs from Ast.td");
+#endif
+
+// -----------------------------------------------------------------------------
+// Node pools
+// -----------------------------------------------------------------------------
+
+/**
+ * Slab pools nodes are allocated from. Each top level group has its own,
+ * so nodes of one group are contiguous in memory.
+ */
+enum class AstPool : std::uint8_t {
+    Root,
+    Type,
+    Stmt,
+    Decl,
+    Expr,
+};
+
+/// Number of node pools
+inline constexpr std::size_t AST_POOL_COUNT = 5;
+
+/**
+ * Get the pool nodes of given kind are allocated from
+ */
+[[nodiscard]] constexpr auto getAstPool(const AstKind kind) -> AstPool {
+    if (kind >= AstKind::BuiltInType && kind <= AstKind::ConstType) {
+        return AstPool::Type;
+    }
+    if (kind >= AstKind::StmtList && kind <= AstKind::Import) {
+        return AstPool::Stmt;
+    }
+    if (kind >= AstKind::VarDecl && kind <= AstKind::FuncParamDecl) {
+        return AstPool::Decl;
+    }
+    if (kind >= AstKind::CastExpr && kind <= AstKind::MemberExpr) {
+        return AstPool::Expr;
+    }
+    return AstPool::Root;
+}
+
+/**
+ * Get the pool nodes of class T are allocated from
+ */
+template <std::derived_from<AstRoot> T>
+[[nodiscard]] consteval auto getAstPool() -> AstPool {
+    if constexpr (std::derived_from<T, AstType>) {
+        return AstPool::Type;
+    }
+    if constexpr (std::derived_from<T, AstStmt>) {
+        return AstPool::Stmt;
+    }
+    if constexpr (std::derived_from<T, AstDecl>) {
+        return AstPool::Decl;
+    }
+    if constexpr (std::derived_from<T, AstExpr>) {
+        return AstPool::Expr;
+    }
+    return AstPool::Root;
+}
+
 } // namespace lbc
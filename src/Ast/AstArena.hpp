@@ -0,0 +1,88 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include "Ast.hpp"
+namespace lbc {
+
+/**
+ * Allocates AST nodes from slab pools, one per top level group (see
+ * AstPool). Expressions, statements, declarations and type expressions
+ * each end up contiguous in memory instead of interleaved with each other
+ * and with symbols, types and strings, so passes that walk one group touch
+ * fewer cache lines and pages.
+ *
+ * Node lists and other parser data come from the shared allocator the
+ * arena is constructed with. With Pooling::Shared every node comes from it
+ * as well, which is the layout used before the pools and is kept to
+ * measure them.
+ *
+ * Not thread safe, work on other threads uses Context::createAstArena().
+ */
+class AstArena final {
+public:
+    NO_COPY_AND_MOVE(AstArena)
+
+    /// Where nodes are allocated
+    enum class Pooling : std::uint8_t {
+        PerGroup, ///< a slab pool per AstPool
+        Shared,   ///< the shared allocator, mixed with everything else
+    };
+
+    /**
+     * Create an arena backed by @p shared for everything but the nodes.
+     */
+    explicit AstArena(llvm::BumpPtrAllocator& shared)
+    : m_shared(shared) {}
+
+    /**
+     * Allocate and construct a node of type T in its group's pool.
+     */
+    template<std::derived_from<AstRoot> T, typename... Args>
+    [[nodiscard]] auto create(Args&&... args) -> T* {
+        return std::construct_at<T>(getPool(getAstPool<T>()).template Allocate<T>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * Get the allocator nodes of @p pool are allocated from.
+     */
+    [[nodiscard]] auto getPool(const AstPool pool) -> llvm::BumpPtrAllocator& {
+        if (m_pooling == Pooling::Shared) {
+            return m_shared;
+        }
+        return m_pools.at(static_cast<std::size_t>(pool));
+    }
+
+    /**
+     * Get the shared allocator for data that is not a node.
+     */
+    [[nodiscard]] auto getAllocator() -> llvm::BumpPtrAllocator& { return m_shared; }
+
+    /**
+     * Check if @p node was allocated from this arena's pools.
+     */
+    [[nodiscard]] auto owns(const AstRoot& node) -> bool {
+        auto& pool = m_pools.at(static_cast<std::size_t>(getAstPool(node.getKind())));
+        return pool.identifyObject(&node).has_value();
+    }
+
+    /// Get where nodes are allocated
+    [[nodiscard]] auto getPooling() const -> Pooling { return m_pooling; }
+
+    /**
+     * Change where nodes are allocated. Only before the first node.
+     */
+    void setPooling(const Pooling pooling) {
+        assert(std::ranges::all_of(m_pools, [](const auto& pool) { return pool.getBytesAllocated() == 0; })
+               && "pooling changed after nodes were allocated");
+        m_pooling = pooling;
+    }
+
+private:
+    llvm::BumpPtrAllocator& m_shared;                              ///< lists, and nodes when shared
+    std::array<llvm::BumpPtrAllocator, AST_POOL_COUNT> m_pools {}; ///< node slabs by AstPool
+    Pooling m_pooling = Pooling::PerGroup;                         ///< where nodes go
+};
+
+} // namespace lbc
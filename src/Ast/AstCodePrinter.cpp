@@ -2,6 +2,8 @@
 // Created by Albert Varaksin on 15/02/2026.
 //
 #include "AstCodePrinter.hpp"
+#include <llvm/ADT/SmallVector.h>
+#include "Lexer/Number.hpp"
 #include "Lexer/TokenKind.hpp"
 #include "Type/Type.hpp"
 using namespace lbc;
@@ -79,6 +81,15 @@ void AstCodePrinter::accept(const AstDimStmt& ast) {
     }
 }
 
+void AstCodePrinter::accept(const AstConstStmt& ast) {
+    m_output << "CONST ";
+    Joiner commas(m_output);
+    for (const auto* decl : ast.getDecls()) {
+        commas();
+        accept(*decl);
+    }
+}
+
 void AstCodePrinter::accept(const AstAssignStmt& ast) {
     visit(*ast.getAssignee());
     m_output << " = ";
@@ -142,8 +153,12 @@ void AstCodePrinter::accept(const AstExtern& ast) {
     m_output << "END EXTERN";
 }
 
+void AstCodePrinter::accept(const AstImport& ast) {
+    m_output << "IMPORT " << ast.getName();
+}
+
 void AstCodePrinter::accept(const AstVarDecl& ast) {
-    m_output << ast.getName();
+    m_output << ast.getName().str();
     m_output << " AS ";
     emitType(ast);
     if (const auto* expr = ast.getExpr()) {
@@ -152,13 +167,21 @@ void AstCodePrinter::accept(const AstVarDecl& ast) {
     }
 }
 
+void AstCodePrinter::accept(const AstConstDecl& ast) {
+    m_output << ast.getName().str();
+    m_output << " AS ";
+    emitType(ast);
+    m_output << " = ";
+    visit(*ast.getExpr());
+}
+
 void AstCodePrinter::accept(const AstFuncDecl& ast) {
     const bool isSub = ast.getRetTypeExpr() == nullptr;
     m_output << (isSub ? "SUB" : "FUNCTION");
 
-    if (not ast.getName().empty()) {
+    if (ast.getName().isValid()) {
         m_output << " ";
-        m_output << ast.getName();
+        m_output << ast.getName().str();
     }
 
     m_output << "(";
@@ -176,7 +199,7 @@ void AstCodePrinter::accept(const AstFuncDecl& ast) {
 }
 
 void AstCodePrinter::accept(const AstFuncParamDecl& ast) {
-    m_output << ast.getName();
+    m_output << ast.getName().str();
     m_output << " AS ";
     emitType(ast);
 }
@@ -193,7 +216,7 @@ void AstCodePrinter::accept(const AstCastExpr& ast) {
 }
 
 void AstCodePrinter::accept(const AstVarExpr& ast) const {
-    m_output << ast.getName();
+    m_output << ast.getName().str();
 }
 
 void AstCodePrinter::accept(const AstCallExpr& ast) {
@@ -246,6 +269,7 @@ void AstCodePrinter::accept(const AstLiteralExpr& ast) const {
         }
     };
     std::visit(visitor, ast.getValue().storage());
+    m_output << number::suffixSpelling(ast.getTypeSuffix());
 }
 
 void AstCodePrinter::accept(const AstUnaryExpr& ast) {
@@ -255,14 +279,26 @@ void AstCodePrinter::accept(const AstUnaryExpr& ast) {
     m_output << ")";
 }
 
+// A chain like `a + b + ... + n` nests on its left operands. It is printed
+// in a loop, so a long chain does not recurse once per term.
 void AstCodePrinter::accept(const AstBinaryExpr& ast) {
-    m_output << "(";
-    visit(*ast.getLeft());
-    m_output << " ";
-    m_output << ast.getOp().string();
-    m_output << " ";
-    visit(*ast.getRight());
-    m_output << ")";
+    llvm::SmallVector<const AstBinaryExpr*, 8> chain { &ast };
+    while (const auto* left = llvm::dyn_cast<AstBinaryExpr>(chain.back()->getLeft())) {
+        chain.push_back(left);
+    }
+
+    for (std::size_t index = 0; index < chain.size(); index++) {
+        m_output << "(";
+    }
+    visit(*chain.back()->getLeft());
+    for (auto index = chain.size(); index-- > 0;) {
+        const auto* expr = chain[index];
+        m_output << " ";
+        m_output << expr->getOp().string();
+        m_output << " ";
+        visit(*expr->getRight());
+        m_output << ")";
+    }
 }
 
 void AstCodePrinter::accept(const AstMemberExpr& ast) {
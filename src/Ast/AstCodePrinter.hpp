@@ -29,10 +29,13 @@ private:
     void accept(const AstFuncStmt& ast);
     void accept(const AstReturnStmt& ast);
     void accept(const AstDimStmt& ast);
+    void accept(const AstConstStmt& ast);
     void accept(const AstAssignStmt& ast);
     void accept(const AstIfStmt& ast);
     void accept(const AstExtern& ast);
+    void accept(const AstImport& ast);
     void accept(const AstVarDecl& ast);
+    void accept(const AstConstDecl& ast);
     void accept(const AstFuncDecl& ast);
     void accept(const AstFuncParamDecl& ast);
     void accept(const AstCastExpr& ast);
@@ -27,11 +27,14 @@ class AstDeclareStmt;
 class AstFuncStmt;
 class AstReturnStmt;
 class AstDimStmt;
+class AstConstStmt;
 class AstAssignStmt;
 class AstIfStmt;
 class AstExtern;
+class AstImport;
 class AstDecl;
 class AstVarDecl;
+class AstConstDecl;
 class AstFuncDecl;
 class AstFuncParamDecl;
 class AstExpr;
@@ -0,0 +1,688 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "AstImage.hpp"
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/MathExtras.h>
+#include <llvm/Support/raw_ostream.h>
+#include "AstArena.hpp"
+#include "AstWalker.hpp"
+#include "Symbol/Symbol.hpp"
+using namespace lbc;
+using namespace lbc::image;
+
+namespace {
+
+/// Records and nodes start at a multiple of this
+constexpr std::size_t kAlignment = 8;
+
+/// A pointer to an AST node
+template<typename T>
+constexpr bool isNodePointer = std::is_pointer_v<T> && std::derived_from<std::remove_cv_t<std::remove_pointer_t<T>>, AstRoot>;
+
+/// A list of AST nodes
+template<typename T>
+constexpr bool isNodeList = false;
+
+template<typename T>
+    requires std::derived_from<T, AstRoot>
+constexpr bool isNodeList<std::span<T*>> = true;
+
+/** Store an image offset or a 1-based record index in a pointer. */
+template<typename T>
+[[nodiscard]] auto encoded(const std::uint64_t value) -> T {
+    return std::bit_cast<T>(static_cast<std::uintptr_t>(value));
+}
+
+/** Read back the value stored by encoded(). */
+template<typename T>
+[[nodiscard]] auto encoding(const T pointer) -> std::uint64_t {
+    return std::bit_cast<std::uintptr_t>(pointer);
+}
+
+/** Place @p count records of @p size bytes at the next aligned offset. */
+auto place(std::size_t& offset, const std::size_t count, const std::size_t size) -> Section {
+    offset = llvm::alignTo(offset, kAlignment);
+    const Section section { static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(count) };
+    offset += count * size;
+    return section;
+}
+
+/** Copy @p value into @p image at @p offset. */
+template<typename T>
+void store(const std::span<char> image, const std::size_t offset, const T& value) {
+    std::memcpy(image.subspan(offset, sizeof(T)).data(), &value, sizeof(T));
+}
+
+/** Get the location base of the buffer @p range lies in, 0 without one. */
+auto sourceBase(Context& context, const SourceRange range) -> std::uint32_t {
+    std::uint32_t base = 0;
+    if (range.isValid()) {
+        for (unsigned id = 1; id <= context.getSourceMgr().getNumBuffers(); id++) {
+            const auto start = context.getLocationBase(id);
+            if (start > range.getOffset()) {
+                break;
+            }
+            base = start;
+        }
+    }
+    return base;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Writer
+// -----------------------------------------------------------------------------
+
+auto AstImageWriter::write(AstModule& module, const llvm::StringRef path) -> DiagResult<void> {
+    TRY_DECL(image, serialise(module))
+
+    std::error_code error;
+    llvm::raw_fd_ostream output { path, error };
+    if (error) {
+        return diag(diagnostics::cannotOpenOutput(path.str(), error.message()));
+    }
+    output.write(image.data(), image.size());
+    output.close();
+    if (output.has_error()) {
+        const auto message = output.error().message();
+        output.clear_error();
+        return diag(diagnostics::cannotOpenOutput(path.str(), message));
+    }
+    return {};
+}
+
+auto AstImageWriter::writeInterface(const AstModule& module, const llvm::StringRef path) -> DiagResult<void> {
+    auto& arena = m_context.getAstArena();
+    auto* table = m_context.create<SymbolTable>(nullptr);
+
+    // Declare every SUB and FUNCTION the module defines
+    std::vector<AstDecl*> decls;
+    std::vector<AstStmt*> stmts;
+    for (auto* stmt : module.getStmtList()->getStmts()) {
+        if (const auto* func = llvm::dyn_cast<AstFuncStmt>(stmt)) {
+            auto* decl = func->getDecl();
+            decls.push_back(decl);
+            stmts.push_back(arena.create<AstDeclareStmt>(decl->getRange(), decl));
+            table->insert(decl->getSymbol());
+        }
+    }
+
+    auto declSpan = m_context.span<AstDecl*>(decls.size());
+    std::ranges::copy(decls, declSpan.begin());
+    auto stmtSpan = m_context.span<AstStmt*>(stmts.size());
+    std::ranges::copy(stmts, stmtSpan.begin());
+
+    auto* stmtList = arena.create<AstStmtList>(module.getStmtList()->getRange(), declSpan, stmtSpan);
+    stmtList->setSymbolTable(table);
+    return write(*arena.create<AstModule>(module.getRange(), stmtList), path);
+}
+
+auto AstImageWriter::serialise(AstModule& module) -> DiagResult<std::vector<char>> {
+    m_nodes.clear();
+    m_nodeOffsets.clear();
+    m_types.clear();
+    m_typeRefs.clear();
+    m_symbols.clear();
+    m_symbolRefs.clear();
+    m_tables.clear();
+    m_tableRefs.clear();
+    m_data.clear();
+    m_strings.clear();
+    m_identifiers.clear();
+    TRY(collect(module))
+
+    Header header {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.pointerBytes = static_cast<std::uint8_t>(sizeof(void*));
+    header.integerBytes = static_cast<std::uint8_t>(m_context.getTypeFactory().getInteger()->getBytes());
+    header.nodeKinds = static_cast<std::uint32_t>(AstRoot::NODE_COUNT);
+    header.sourceBase = sourceBase(m_context, module.getRange());
+
+    // Records, sized from what was collected
+    std::size_t typeRefs = 0;
+    for (const auto* type : m_types) {
+        if (const auto* func = llvm::dyn_cast<TypeFunction>(type)) {
+            typeRefs += func->getParams().size();
+        }
+    }
+    std::size_t symbolRefs = 0;
+    for (const auto* symbol : m_symbols) {
+        symbolRefs += symbol->getRelatedSymbols().size();
+    }
+    for (const auto* table : m_tables) {
+        symbolRefs += table->size();
+    }
+
+    std::size_t offset = sizeof(Header);
+    header.types = place(offset, m_types.size(), sizeof(TypeRecord));
+    header.typeRefs = place(offset, typeRefs, sizeof(std::uint32_t));
+    header.symbols = place(offset, m_symbols.size(), sizeof(SymbolRecord));
+    header.symbolRefs = place(offset, symbolRefs, sizeof(std::uint32_t));
+    header.tables = place(offset, m_tables.size(), sizeof(TableRecord));
+    header.nodes = place(offset, m_nodes.size(), sizeof(std::uint32_t));
+
+    // Nodes, in post-order
+    for (auto* node : m_nodes) {
+        offset = llvm::alignTo(offset, kAlignment);
+        m_nodeOffsets.try_emplace(node, static_cast<std::uint32_t>(offset));
+        offset += visit(*node, [](const auto& ast) { return sizeof(ast); });
+    }
+    header.module = m_nodeOffsets.lookup(&module);
+
+    // Node lists and strings follow, appended while nodes are encoded
+    offset = llvm::alignTo(offset, kAlignment);
+    if (offset > std::numeric_limits<std::uint32_t>::max()) {
+        llvm::report_fatal_error("module image exceeds 4 GiB");
+    }
+    m_dataOffset = static_cast<std::uint32_t>(offset);
+
+    std::vector<char> image(offset);
+    emitTypes(image, header);
+    emitTables(image, header, emitSymbols(image, header));
+    emitNodes(image, header);
+
+    header.size = static_cast<std::uint32_t>(image.size() + m_data.size());
+    store(std::span(image), 0, header);
+    image.insert(image.end(), m_data.begin(), m_data.end());
+    return image;
+}
+
+auto AstImageWriter::collect(AstModule& module) -> DiagResult<void> {
+    AstWalker walker;
+    return walker.postOrder(module, [&](AstRoot& node) -> DiagResult<void> {
+        // A deferred body has no nodes to write
+        if (const auto* func = llvm::dyn_cast<AstFuncStmt>(&node); func != nullptr && func->getDeferred()) {
+            return notImplemented();
+        }
+        m_nodes.push_back(&node);
+        visit(node, [&](auto& ast) {
+            ast.forEachField([&]<typename T>(T& field) {
+                if constexpr (std::is_same_v<T, const Type*>) {
+                    addType(field);
+                } else if constexpr (std::is_same_v<T, Symbol*>) {
+                    addSymbol(field);
+                } else if constexpr (std::is_same_v<T, SymbolTable*>) {
+                    addTable(field);
+                }
+            });
+        });
+        return {};
+    });
+}
+
+void AstImageWriter::addType(const Type* type) {
+    if (type == nullptr || m_typeRefs.contains(type)) {
+        return;
+    }
+    if (const auto* func = llvm::dyn_cast<TypeFunction>(type)) {
+        addType(func->getReturnType());
+        for (const auto* param : func->getParams()) {
+            addType(param);
+        }
+    } else {
+        addType(type->getBaseType());
+    }
+    m_types.push_back(type);
+    m_typeRefs.try_emplace(type, static_cast<std::uint32_t>(m_types.size()));
+}
+
+void AstImageWriter::addSymbol(Symbol* symbol) {
+    if (symbol == nullptr || m_symbolRefs.contains(symbol)) {
+        return;
+    }
+    m_symbols.push_back(symbol);
+    m_symbolRefs.try_emplace(symbol, static_cast<std::uint32_t>(m_symbols.size()));
+    addType(symbol->getType());
+    for (auto* related : symbol->getRelatedSymbols()) {
+        addSymbol(related);
+    }
+}
+
+void AstImageWriter::addTable(SymbolTable* table) {
+    if (table == nullptr || m_tableRefs.contains(table)) {
+        return;
+    }
+    addTable(static_cast<SymbolTable*>(table->getParent())); // NOLINT(*-static-cast-downcast)
+    m_tables.push_back(table);
+    m_tableRefs.try_emplace(table, static_cast<std::uint32_t>(m_tables.size()));
+    table->forEach([&](Symbol* symbol) { addSymbol(symbol); });
+}
+
+void AstImageWriter::emitTypes(const std::span<char> image, const Header& header) {
+    std::uint32_t refs = 0;
+    for (std::size_t index = 0; index < m_types.size(); index++) {
+        const auto* type = m_types[index];
+        TypeRecord record {};
+        record.kind = std::to_underlying(type->getKind());
+        if (const auto* func = llvm::dyn_cast<TypeFunction>(type)) {
+            record.variadic = func->isVariadic();
+            record.base = m_typeRefs.lookup(func->getReturnType());
+            record.params = refs;
+            record.paramCount = static_cast<std::uint32_t>(func->getParams().size());
+            for (const auto* param : func->getParams()) {
+                store(image, header.typeRefs.offset + (refs++ * sizeof(std::uint32_t)), m_typeRefs.lookup(param));
+            }
+        } else {
+            record.base = m_typeRefs.lookup(type->getBaseType());
+        }
+        store(image, header.types.offset + (index * sizeof(TypeRecord)), record);
+    }
+}
+
+auto AstImageWriter::emitSymbols(const std::span<char> image, const Header& header) -> std::uint32_t {
+    std::uint32_t refs = 0;
+    for (std::size_t index = 0; index < m_symbols.size(); index++) {
+        const auto* symbol = m_symbols[index];
+        SymbolRecord record {};
+        record.name = symbol->getName().str();
+        record.alias = symbol->getAlias();
+        record.value = symbol->getValue();
+        record.range = symbol->getRange();
+        record.type = m_typeRefs.lookup(symbol->getType());
+        record.related = refs;
+        record.relatedCount = static_cast<std::uint32_t>(symbol->getRelatedSymbols().size());
+        record.externKind = std::to_underlying(symbol->getExternKind());
+        record.visibility = std::to_underlying(symbol->getVisibility());
+        record.flags = std::to_underlying(symbol->getFlags());
+        encode(record.name);
+        encode(record.alias);
+        encode(record.value);
+        for (const auto* related : symbol->getRelatedSymbols()) {
+            store(image, header.symbolRefs.offset + (refs++ * sizeof(std::uint32_t)), m_symbolRefs.lookup(related));
+        }
+        store(image, header.symbols.offset + (index * sizeof(SymbolRecord)), record);
+    }
+    return refs;
+}
+
+void AstImageWriter::emitTables(const std::span<char> image, const Header& header, std::uint32_t refs) {
+    for (std::size_t index = 0; index < m_tables.size(); index++) {
+        const auto* table = m_tables[index];
+        TableRecord record {};
+        record.parent = m_tableRefs.lookup(static_cast<const SymbolTable*>(table->getParent())); // NOLINT(*-static-cast-downcast)
+        record.symbols = refs;
+        record.symbolCount = static_cast<std::uint32_t>(table->size());
+        table->forEach([&](const Symbol* symbol) {
+            store(image, header.symbolRefs.offset + (refs++ * sizeof(std::uint32_t)), m_symbolRefs.lookup(symbol));
+        });
+        store(image, header.tables.offset + (index * sizeof(TableRecord)), record);
+    }
+}
+
+void AstImageWriter::emitNodes(const std::span<char> image, const Header& header) {
+    for (std::size_t index = 0; index < m_nodes.size(); index++) {
+        const auto offset = m_nodeOffsets.lookup(m_nodes[index]);
+        store(image, header.nodes.offset + (index * sizeof(std::uint32_t)), offset);
+
+        // Nodes hold no virtual functions, so the bytes are the node
+        visit(*m_nodes[index], [&]<typename Node>(const Node& ast) {
+            auto* copy = reinterpret_cast<Node*>(image.subspan(offset, sizeof(Node)).data()); // NOLINT(*-reinterpret-cast)
+            std::memcpy(static_cast<void*>(copy), &ast, sizeof(Node));
+            copy->forEachField([&](auto& field) { encode(field); });
+        });
+    }
+}
+
+template<typename T>
+void AstImageWriter::encode(T& field) {
+    if constexpr (std::is_same_v<T, ir::lib::Value*>) {
+        // Lowering state, rebuilt by the next lowering
+        field = nullptr;
+    } else if constexpr (isNodePointer<T>) {
+        // A link to a node left out of the image, like the body of a function
+        // declared by an interface or an imported module, is dropped
+        field = encoded<T>(field == nullptr ? 0 : m_nodeOffsets.lookup(field));
+    } else if constexpr (isNodeList<T>) {
+        if (field.empty()) {
+            field = {};
+            return;
+        }
+        std::vector<std::uintptr_t> offsets;
+        offsets.reserve(field.size());
+        for (auto* node : field) {
+            offsets.push_back(m_nodeOffsets.lookup(node));
+        }
+        const std::span bytes { reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uintptr_t) }; // NOLINT(*-reinterpret-cast)
+        field = T { encoded<typename T::pointer>(append(bytes, kAlignment)), field.size() };
+    } else if constexpr (std::is_same_v<T, const Type*>) {
+        field = encoded<T>(field == nullptr ? 0 : m_typeRefs.lookup(field));
+    } else if constexpr (std::is_same_v<T, Symbol*>) {
+        field = encoded<T>(field == nullptr ? 0 : m_symbolRefs.lookup(field));
+    } else if constexpr (std::is_same_v<T, SymbolTable*>) {
+        field = encoded<T>(field == nullptr ? 0 : m_tableRefs.lookup(field));
+    } else if constexpr (std::is_same_v<T, llvm::StringRef>) {
+        field = string(field);
+    } else if constexpr (std::is_same_v<T, Identifier>) {
+        field = encoded<T>(identifier(field));
+    } else if constexpr (std::is_same_v<T, LiteralValue>) {
+        if (const auto value = field.template as<LiteralValue::String>()) {
+            field.set(string(*value));
+        }
+    } else if constexpr (std::is_same_v<T, std::optional<LiteralValue>>) {
+        if (field.has_value()) {
+            encode(*field);
+        }
+    } else {
+        static_assert(not std::is_pointer_v<T>, "pointer member without an image encoding");
+    }
+}
+
+auto AstImageWriter::append(const std::span<const char> bytes, const std::size_t alignment) -> std::uint32_t {
+    m_data.resize(llvm::alignTo(m_data.size(), alignment));
+    const auto offset = m_dataOffset + m_data.size();
+    if (offset + bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+        llvm::report_fatal_error("module image exceeds 4 GiB");
+    }
+    m_data.insert(m_data.end(), bytes.begin(), bytes.end());
+    return static_cast<std::uint32_t>(offset);
+}
+
+auto AstImageWriter::string(const llvm::StringRef string) -> llvm::StringRef {
+    if (string.empty()) {
+        return {};
+    }
+    auto [iter, inserted] = m_strings.try_emplace(string, 0);
+    if (inserted) {
+        iter->second = append(std::span { string.data(), string.size() }, 1);
+    }
+    return { encoded<const char*>(iter->second), string.size() };
+}
+
+auto AstImageWriter::identifier(const Identifier id) -> std::uint32_t {
+    if (not id.isValid()) {
+        return 0;
+    }
+    auto [iter, inserted] = m_identifiers.try_emplace(id, 0);
+    if (inserted) {
+        // Stored with its terminator, the node field has no room for the length
+        const auto name = id.str();
+        iter->second = append(std::span { name.data(), name.size() + 1 }, 1);
+    }
+    return iter->second;
+}
+
+// -----------------------------------------------------------------------------
+// Reader
+// -----------------------------------------------------------------------------
+
+auto AstImageReader::load(const llvm::StringRef path, const std::optional<unsigned> sourceId) -> DiagResult<AstModule*> {
+    m_types.clear();
+    m_symbols.clear();
+    m_tables.clear();
+    m_rebase.reset();
+    m_valid = true;
+
+    const auto mapped = m_context.mapFile(path);
+    if (not mapped) {
+        return diag(diagnostics::cannotOpenInput(path.str(), mapped.error().message()));
+    }
+    m_image = *mapped;
+
+    Header header {};
+    if (m_image.size() < sizeof(Header)) {
+        return diag(diagnostics::invalidModuleImage(path.str()));
+    }
+    std::memcpy(&header, m_image.data(), sizeof(Header));
+    if (not validate(header)) {
+        return diag(diagnostics::invalidModuleImage(path.str()));
+    }
+
+    if (sourceId.has_value() && header.sourceBase != 0) {
+        m_rebase = static_cast<std::int64_t>(m_context.getLocationBase(*sourceId)) - header.sourceBase;
+    }
+
+    if (not buildTypes(header) || not buildSymbols(header) || not buildTables(header) || not fixNodes(header)) {
+        return diag(diagnostics::invalidModuleImage(path.str()));
+    }
+
+    auto* module = reinterpret_cast<AstRoot*>(at(header.module, sizeof(AstModule), kAlignment)); // NOLINT(*-reinterpret-cast)
+    if (module == nullptr || not llvm::isa<AstModule>(module)) {
+        return diag(diagnostics::invalidModuleImage(path.str()));
+    }
+    return llvm::cast<AstModule>(module);
+}
+
+auto AstImageReader::validate(const Header& header) const -> bool {
+    return header.magic == kMagic
+        && header.version == kVersion
+        && header.byteOrder == kByteOrder
+        && header.pointerBytes == sizeof(void*)
+        && header.integerBytes == m_context.getTypeFactory().getInteger()->getBytes()
+        && header.nodeKinds == AstRoot::NODE_COUNT
+        && header.size == m_image.size();
+}
+
+auto AstImageReader::buildTypes(const Header& header) -> bool {
+    const auto types = records<const TypeRecord>(header.types);
+    const auto refs = records<const std::uint32_t>(header.typeRefs);
+    auto& factory = m_context.getTypeFactory();
+
+    m_types.reserve(types.size());
+    for (const auto& record : types) {
+        if (record.kind > std::to_underlying(TypeKind::Function)) {
+            return false;
+        }
+        const auto kind = static_cast<TypeKind>(record.kind);
+        const Type* base = lookup(m_types, record.base);
+        const Type* type = nullptr;
+        switch (kind) {
+        case TypeKind::Pointer:
+            type = base == nullptr ? nullptr : factory.getPointer(base);
+            break;
+        case TypeKind::Reference:
+            type = base == nullptr ? nullptr : factory.getReference(base);
+            break;
+        case TypeKind::Const:
+            type = base == nullptr ? nullptr : factory.getConst(base);
+            break;
+        case TypeKind::Function: {
+            if (base == nullptr || std::uint64_t { record.params } + record.paramCount > refs.size()) {
+                return false;
+            }
+            // The factory keeps the span, so it lives in the context
+            auto params = m_context.span<const Type*>(record.paramCount);
+            for (std::size_t index = 0; index < params.size(); index++) {
+                params[index] = lookup(m_types, refs[record.params + index]);
+                if (params[index] == nullptr) {
+                    return false;
+                }
+            }
+            type = factory.getFunction(params, base, record.variadic);
+            break;
+        }
+        default:
+            type = factory.getSingleton(kind);
+            break;
+        }
+        if (type == nullptr) {
+            return false;
+        }
+        m_types.push_back(type);
+    }
+    return m_valid;
+}
+
+auto AstImageReader::buildSymbols(const Header& header) -> bool {
+    const auto symbols = records<const SymbolRecord>(header.symbols);
+    const auto refs = records<const std::uint32_t>(header.symbolRefs);
+
+    m_symbols.reserve(symbols.size());
+    for (auto record : symbols) {
+        decode(record.name);
+        decode(record.alias);
+        decode(record.value);
+        decode(record.range);
+        auto* symbol = m_context.create<Symbol>(m_context.getIdentifiers().get(record.name), lookup(m_types, record.type), record.range);
+        symbol->setAlias(record.alias);
+        symbol->setValue(record.value);
+        symbol->setExternKind(static_cast<ExternKind>(record.externKind));
+        symbol->setVisibility(static_cast<SymbolVisibility>(record.visibility));
+        symbol->setFlags(static_cast<SymbolFlags>(record.flags));
+        m_symbols.push_back(symbol);
+    }
+
+    // Related symbols may come later in the records
+    for (std::size_t index = 0; index < symbols.size(); index++) {
+        const auto& record = symbols[index];
+        if (record.relatedCount == 0) {
+            continue;
+        }
+        if (std::uint64_t { record.related } + record.relatedCount > refs.size()) {
+            return false;
+        }
+        auto related = m_context.span<Symbol*>(record.relatedCount);
+        for (std::size_t item = 0; item < related.size(); item++) {
+            related[item] = lookup(m_symbols, refs[record.related + item]);
+            if (related[item] == nullptr) {
+                return false;
+            }
+        }
+        m_symbols[index]->setRelatedSymbols(related);
+    }
+    return m_valid;
+}
+
+auto AstImageReader::buildTables(const Header& header) -> bool {
+    const auto tables = records<const TableRecord>(header.tables);
+    const auto refs = records<const std::uint32_t>(header.symbolRefs);
+
+    m_tables.reserve(tables.size());
+    for (const auto& record : tables) {
+        auto* parent = lookup(m_tables, record.parent);
+        if (record.parent != 0 && parent == nullptr) {
+            return false;
+        }
+        if (std::uint64_t { record.symbols } + record.symbolCount > refs.size()) {
+            return false;
+        }
+        auto* table = m_context.create<SymbolTable>(parent);
+        for (std::size_t item = 0; item < record.symbolCount; item++) {
+            auto* symbol = lookup(m_symbols, refs[record.symbols + item]);
+            if (symbol == nullptr) {
+                return false;
+            }
+            table->insert(symbol);
+        }
+        m_tables.push_back(table);
+    }
+    return m_valid;
+}
+
+auto AstImageReader::fixNodes(const Header& header) -> bool {
+    for (const auto offset : records<const std::uint32_t>(header.nodes)) {
+        auto* node = reinterpret_cast<AstRoot*>(at(offset, sizeof(AstRoot), kAlignment)); // NOLINT(*-reinterpret-cast)
+        if (node == nullptr || std::to_underlying(node->getKind()) >= AstRoot::NODE_COUNT) {
+            return false;
+        }
+        visit(*node, [&]<typename Node>(Node& ast) {
+            if (at(offset, sizeof(Node), kAlignment) == nullptr) {
+                return;
+            }
+            ast.forEachField([&](auto& field) { decode(field); });
+        });
+    }
+    return m_valid;
+}
+
+template<typename T>
+void AstImageReader::decode(T& field) {
+    if constexpr (std::is_same_v<T, ir::lib::Value*>) {
+        // Written as null
+    } else if constexpr (isNodePointer<T>) {
+        const auto offset = encoding(field);
+        field = offset == 0 ? nullptr : reinterpret_cast<T>(at(offset, sizeof(std::remove_pointer_t<T>), kAlignment)); // NOLINT(*-reinterpret-cast)
+    } else if constexpr (isNodeList<T>) {
+        if (field.empty()) {
+            field = {};
+            return;
+        }
+        // Offsets are replaced by the pointers in place
+        auto* items = reinterpret_cast<typename T::pointer>(at(encoding(field.data()), field.size_bytes(), kAlignment)); // NOLINT(*-reinterpret-cast)
+        if (items == nullptr) {
+            field = {};
+            return;
+        }
+        field = T { items, field.size() };
+        for (auto& item : field) {
+            decode(item);
+        }
+    } else if constexpr (std::is_same_v<T, const Type*>) {
+        field = lookup(m_types, encoding(field));
+    } else if constexpr (std::is_same_v<T, Symbol*>) {
+        field = lookup(m_symbols, encoding(field));
+    } else if constexpr (std::is_same_v<T, SymbolTable*>) {
+        field = lookup(m_tables, encoding(field));
+    } else if constexpr (std::is_same_v<T, llvm::StringRef>) {
+        const auto offset = encoding(field.data());
+        field = offset == 0 ? llvm::StringRef {} : llvm::StringRef { at(offset, field.size(), 1), field.size() };
+    } else if constexpr (std::is_same_v<T, Identifier>) {
+        field = identifier(encoding(field));
+    } else if constexpr (std::is_same_v<T, LiteralValue>) {
+        if (auto value = field.template as<LiteralValue::String>()) {
+            decode(*value);
+            field.set(*value);
+        }
+    } else if constexpr (std::is_same_v<T, std::optional<LiteralValue>>) {
+        if (field.has_value()) {
+            decode(*field);
+        }
+    } else if constexpr (std::is_same_v<T, SourceRange>) {
+        if (field.isValid()) {
+            field = m_rebase.has_value() ? SourceRange { static_cast<std::uint32_t>(field.getOffset() + *m_rebase), field.getLength() } : SourceRange {};
+        }
+    } else {
+        static_assert(not std::is_pointer_v<T>, "pointer member without an image encoding");
+    }
+}
+
+template<typename T>
+auto AstImageReader::records(const Section section) -> std::span<T> {
+    if (section.count == 0) {
+        return {};
+    }
+    auto* first = at(section.offset, std::uint64_t { section.count } * sizeof(T), alignof(T));
+    if (first == nullptr) {
+        return {};
+    }
+    return { reinterpret_cast<T*>(first), section.count }; // NOLINT(*-reinterpret-cast)
+}
+
+auto AstImageReader::at(const std::uint64_t offset, const std::uint64_t bytes, const std::size_t alignment) -> char* {
+    if (offset == 0 || offset % alignment != 0 || offset > m_image.size() || bytes > m_image.size() - offset) {
+        m_valid = false;
+        return nullptr;
+    }
+    return m_image.subspan(offset).data();
+}
+
+auto AstImageReader::identifier(const std::uint64_t offset) -> Identifier {
+    if (offset == 0) {
+        return {};
+    }
+    const auto* data = at(offset, 1, 1);
+    if (data == nullptr) {
+        return {};
+    }
+    const auto* end = static_cast<const char*>(std::memchr(data, '\0', m_image.size() - offset));
+    if (end == nullptr) {
+        m_valid = false;
+        return {};
+    }
+    return m_context.getIdentifiers().get({ data, static_cast<std::size_t>(end - data) });
+}
+
+template<typename T>
+auto AstImageReader::lookup(const std::vector<T*>& items, const std::uint64_t ref) -> T* {
+    if (ref == 0) {
+        return nullptr;
+    }
+    if (ref > items.size()) {
+        m_valid = false;
+        return nullptr;
+    }
+    return items[ref - 1];
+}
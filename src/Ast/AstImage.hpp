@@ -0,0 +1,238 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringMap.h>
+#include "Ast.hpp"
+#include "Diag/LogProvider.hpp"
+namespace lbc {
+class Symbol;
+class SymbolTable;
+class Type;
+
+/**
+ * Binary image of an analysed module.
+ *
+ * Nodes are stored byte for byte in their in-memory layout, with every
+ * pointer replaced by a file offset (nodes, node lists, strings) or by a
+ * 1-based index into the type, symbol or symbol table records. Loading maps
+ * the file copy-on-write and patches the pointers in place, so the nodes are
+ * used straight from the mapping without lexing, parsing or analysis.
+ *
+ * Types are hash-consed by the TypeFactory and symbol tables are hash maps,
+ * so types, symbols and tables are stored as records and rebuilt on load.
+ * Identifiers are stored as their names and interned again on load.
+ * The image is tied to the host pointer size and byte order, the node
+ * layout (see kVersion) and the width of INTEGER on the analysed target.
+ *
+ * Layout, all offsets from the start of the image:
+ *
+ *     Header | types | type refs | symbols | symbol refs | tables
+ *            | node offsets | nodes | node lists and strings
+ */
+namespace image {
+    /// Leading bytes of every image
+    inline constexpr std::array<char, 4> kMagic { 'L', 'B', 'C', 'A' };
+    /// Format version, bump whenever Ast.td, Types.td or the records change
+    inline constexpr std::uint32_t kVersion = 5;
+    /// Written as is, reads differently under a foreign byte order
+    inline constexpr std::uint16_t kByteOrder = 0x0102;
+
+    /// A run of records
+    struct Section final {
+        std::uint32_t offset; ///< offset of the first record
+        std::uint32_t count;  ///< number of records
+    };
+
+    /// Image header at offset 0
+    struct Header final {
+        std::array<char, 4> magic; ///< kMagic
+        std::uint32_t version;     ///< kVersion
+        std::uint16_t byteOrder;   ///< kByteOrder
+        std::uint8_t pointerBytes; ///< host pointer size
+        std::uint8_t integerBytes; ///< width of INTEGER on the target
+        std::uint32_t nodeKinds;   ///< AstRoot::NODE_COUNT
+        std::uint32_t sourceBase;  ///< location base of the module's source buffer
+        std::uint32_t module;      ///< offset of the AstModule node
+        std::uint32_t size;        ///< size of the whole image
+        Section types;             ///< TypeRecord
+        Section typeRefs;          ///< std::uint32_t, function parameter types
+        Section symbols;           ///< SymbolRecord
+        Section symbolRefs;        ///< std::uint32_t, related and table symbols
+        Section tables;            ///< TableRecord
+        Section nodes;             ///< std::uint32_t, offset of every node
+    };
+
+    /// A type, built from types before it
+    struct TypeRecord final {
+        std::uint8_t kind;        ///< TypeKind
+        bool variadic;            ///< function takes C variadic arguments
+        std::uint32_t base;       ///< base or return type
+        std::uint32_t params;     ///< first parameter in typeRefs
+        std::uint32_t paramCount; ///< number of parameters
+    };
+
+    /// A symbol, strings and value encoded like node fields
+    struct SymbolRecord final {
+        llvm::StringRef name;              ///< declared name
+        llvm::StringRef alias;             ///< optional alias
+        std::optional<LiteralValue> value; ///< constant value
+        SourceRange range;                 ///< declaration location
+        std::uint32_t type;                ///< symbol type
+        std::uint32_t related;             ///< first related symbol in symbolRefs
+        std::uint32_t relatedCount;        ///< number of related symbols
+        std::uint8_t externKind;           ///< ExternKind
+        std::uint8_t visibility;           ///< SymbolVisibility
+        std::uint8_t flags;                ///< SymbolFlags
+    };
+
+    /// A symbol table, built after its parent
+    struct TableRecord final {
+        std::uint32_t parent;      ///< enclosing table
+        std::uint32_t symbols;     ///< first symbol in symbolRefs
+        std::uint32_t symbolCount; ///< number of symbols
+    };
+} // namespace image
+
+/**
+ * Write an analysed module to a binary image.
+ *
+ * @code
+ * AstImageWriter writer { context };
+ * TRY(writer.write(module, "module.lbca"));
+ * @endcode
+ */
+class AstImageWriter final : LogProvider {
+public:
+    NO_COPY_AND_MOVE(AstImageWriter)
+
+    explicit AstImageWriter(Context& context)
+    : m_context(context) {}
+
+    /**
+     * Write @p module, which must be fully analysed, to @p path.
+     * Bodies left deferred by lazy parsing are not supported.
+     */
+    [[nodiscard]] auto write(AstModule& module, llvm::StringRef path) -> DiagResult<void>;
+
+    /**
+     * Write the interface of @p module to @p path: the image of a module
+     * declaring each SUB and FUNCTION that @p module defines, with their
+     * symbols and types. IMPORT loads it in place of the source.
+     */
+    [[nodiscard]] auto writeInterface(const AstModule& module, llvm::StringRef path) -> DiagResult<void>;
+
+    /**
+     * Build the image of @p module in memory.
+     */
+    [[nodiscard]] auto serialise(AstModule& module) -> DiagResult<std::vector<char>>;
+
+    /**
+     * Get associated context object.
+     */
+    [[nodiscard]] auto getContext() const -> Context& { return m_context; }
+
+private:
+    /** Record everything reachable from the module. */
+    [[nodiscard]] auto collect(AstModule& module) -> DiagResult<void>;
+    void addType(const Type* type);
+    void addSymbol(Symbol* symbol);
+    void addTable(SymbolTable* table);
+
+    /** Copy and encode the records and nodes into @p image. */
+    void emitTypes(std::span<char> image, const image::Header& header);
+    [[nodiscard]] auto emitSymbols(std::span<char> image, const image::Header& header) -> std::uint32_t;
+    void emitTables(std::span<char> image, const image::Header& header, std::uint32_t refs);
+    void emitNodes(std::span<char> image, const image::Header& header);
+
+    /** Encode the pointer fields of a node, symbol or value in place. */
+    template<typename T>
+    void encode(T& field);
+
+    /** Append @p bytes to the data area and get their image offset. */
+    [[nodiscard]] auto append(std::span<const char> bytes, std::size_t alignment) -> std::uint32_t;
+    [[nodiscard]] auto string(llvm::StringRef string) -> llvm::StringRef;
+    [[nodiscard]] auto identifier(Identifier id) -> std::uint32_t;
+
+    Context& m_context;
+    std::vector<AstRoot*> m_nodes;                                 ///< nodes in post-order
+    llvm::DenseMap<const AstRoot*, std::uint32_t> m_nodeOffsets;   ///< image offset of each node
+    std::vector<const Type*> m_types;                              ///< types, dependencies first
+    llvm::DenseMap<const Type*, std::uint32_t> m_typeRefs;         ///< 1-based type index
+    std::vector<Symbol*> m_symbols;                                ///< symbols in record order
+    llvm::DenseMap<const Symbol*, std::uint32_t> m_symbolRefs;     ///< 1-based symbol index
+    std::vector<SymbolTable*> m_tables;                            ///< tables, parents first
+    llvm::DenseMap<const SymbolTable*, std::uint32_t> m_tableRefs; ///< 1-based table index
+    std::vector<char> m_data;                                      ///< node lists and strings
+    std::uint32_t m_dataOffset = 0;                                ///< image offset of m_data
+    llvm::StringMap<std::uint32_t> m_strings;                      ///< image offset of each string
+    llvm::DenseMap<Identifier, std::uint32_t> m_identifiers;       ///< image offset of each identifier
+};
+
+/**
+ * Load a module image written by AstImageWriter.
+ *
+ * The image is mapped through Context::mapFile() and stays mapped for the
+ * lifetime of the context, as do the nodes loaded from it.
+ *
+ * @code
+ * AstImageReader reader { context };
+ * TRY_DECL(module, reader.load("module.lbca"));
+ * @endcode
+ */
+class AstImageReader final : LogProvider {
+public:
+    NO_COPY_AND_MOVE(AstImageReader)
+
+    explicit AstImageReader(Context& context)
+    : m_context(context) {}
+
+    /**
+     * Load the module image at @p path. When the module's source is loaded
+     * as buffer @p sourceId, node and symbol ranges are moved into it,
+     * otherwise they are left invalid.
+     */
+    [[nodiscard]] auto load(llvm::StringRef path, std::optional<unsigned> sourceId = std::nullopt) -> DiagResult<AstModule*>;
+
+    /**
+     * Get associated context object.
+     */
+    [[nodiscard]] auto getContext() const -> Context& { return m_context; }
+
+private:
+    [[nodiscard]] auto validate(const image::Header& header) const -> bool;
+    [[nodiscard]] auto buildTypes(const image::Header& header) -> bool;
+    [[nodiscard]] auto buildSymbols(const image::Header& header) -> bool;
+    [[nodiscard]] auto buildTables(const image::Header& header) -> bool;
+    [[nodiscard]] auto fixNodes(const image::Header& header) -> bool;
+
+    /** Turn an encoded field back into a pointer. */
+    template<typename T>
+    void decode(T& field);
+
+    /** Get the records of a section, empty if it lies outside the image. */
+    template<typename T>
+    [[nodiscard]] auto records(image::Section section) -> std::span<T>;
+
+    /** Resolve an image offset of @p bytes, nullptr if out of bounds or misaligned. */
+    [[nodiscard]] auto at(std::uint64_t offset, std::uint64_t bytes, std::size_t alignment) -> char*;
+
+    /** Intern the name stored at an image offset, invalid for 0 or if out of bounds. */
+    [[nodiscard]] auto identifier(std::uint64_t offset) -> Identifier;
+
+    /** Resolve a 1-based record index, nullptr for 0 or if out of bounds. */
+    template<typename T>
+    [[nodiscard]] auto lookup(const std::vector<T*>& items, std::uint64_t ref) -> T*;
+
+    Context& m_context;
+    std::span<char> m_image;              ///< the mapped image
+    std::vector<const Type*> m_types;     ///< rebuilt types by index
+    std::vector<Symbol*> m_symbols;       ///< rebuilt symbols by index
+    std::vector<SymbolTable*> m_tables;   ///< rebuilt tables by index
+    std::optional<std::int64_t> m_rebase; ///< added to valid ranges, nullopt drops them
+    bool m_valid = true;                  ///< no encoded field was out of bounds
+};
+
+} // namespace lbc
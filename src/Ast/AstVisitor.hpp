@@ -64,10 +64,13 @@ protected:
  *     // void accept(const AstFuncStmt& ast) const;
  *     // void accept(const AstReturnStmt& ast) const;
  *     // void accept(const AstDimStmt& ast) const;
+ *     // void accept(const AstConstStmt& ast) const;
  *     // void accept(const AstAssignStmt& ast) const;
  *     // void accept(const AstIfStmt& ast) const;
  *     // void accept(const AstExtern& ast) const;
+ *     // void accept(const AstImport& ast) const;
  *     // void accept(const AstVarDecl& ast) const;
+ *     // void accept(const AstConstDecl& ast) const;
  *     // void accept(const AstFuncDecl& ast) const;
  *     // void accept(const AstFuncParamDecl& ast) const;
  *     // void accept(const AstCastExpr& ast) const;
@@ -113,14 +116,20 @@ public:
                 return self.accept(llvm::cast<AstReturnStmt>(ast));
             case AstKind::DimStmt:
                 return self.accept(llvm::cast<AstDimStmt>(ast));
+            case AstKind::ConstStmt:
+                return self.accept(llvm::cast<AstConstStmt>(ast));
             case AstKind::AssignStmt:
                 return self.accept(llvm::cast<AstAssignStmt>(ast));
             case AstKind::IfStmt:
                 return self.accept(llvm::cast<AstIfStmt>(ast));
             case AstKind::Extern:
                 return self.accept(llvm::cast<AstExtern>(ast));
+            case AstKind::Import:
+                return self.accept(llvm::cast<AstImport>(ast));
             case AstKind::VarDecl:
                 return self.accept(llvm::cast<AstVarDecl>(ast));
+            case AstKind::ConstDecl:
+                return self.accept(llvm::cast<AstConstDecl>(ast));
             case AstKind::FuncDecl:
                 return self.accept(llvm::cast<AstFuncDecl>(ast));
             case AstKind::FuncParamDecl:
@@ -223,9 +232,11 @@ public:
  *     // void accept(const AstFuncStmt& ast) const;
  *     // void accept(const AstReturnStmt& ast) const;
  *     // void accept(const AstDimStmt& ast) const;
+ *     // void accept(const AstConstStmt& ast) const;
  *     // void accept(const AstAssignStmt& ast) const;
  *     // void accept(const AstIfStmt& ast) const;
  *     // void accept(const AstExtern& ast) const;
+ *     // void accept(const AstImport& ast) const;
  * };
  * @endcode
  */
@@ -252,12 +263,16 @@ public:
                 return self.accept(llvm::cast<AstReturnStmt>(ast));
             case AstKind::DimStmt:
                 return self.accept(llvm::cast<AstDimStmt>(ast));
+            case AstKind::ConstStmt:
+                return self.accept(llvm::cast<AstConstStmt>(ast));
             case AstKind::AssignStmt:
                 return self.accept(llvm::cast<AstAssignStmt>(ast));
             case AstKind::IfStmt:
                 return self.accept(llvm::cast<AstIfStmt>(ast));
             case AstKind::Extern:
                 return self.accept(llvm::cast<AstExtern>(ast));
+            case AstKind::Import:
+                return self.accept(llvm::cast<AstImport>(ast));
             default:
                 std::unreachable();
         }
@@ -285,6 +300,7 @@ public:
  *     }
  *     
  *     // void accept(const AstVarDecl& ast) const;
+ *     // void accept(const AstConstDecl& ast) const;
  *     // void accept(const AstFuncDecl& ast) const;
  *     // void accept(const AstFuncParamDecl& ast) const;
  * };
@@ -303,6 +319,8 @@ public:
         switch (ast.getKind()) {
             case AstKind::VarDecl:
                 return self.accept(llvm::cast<AstVarDecl>(ast));
+            case AstKind::ConstDecl:
+                return self.accept(llvm::cast<AstConstDecl>(ast));
             case AstKind::FuncDecl:
                 return self.accept(llvm::cast<AstFuncDecl>(ast));
             case AstKind::FuncParamDecl:
@@ -393,11 +411,14 @@ public:
  *     [&](const AstFuncStmt& ast) {},
  *     [&](const AstReturnStmt& ast) {},
  *     [&](const AstDimStmt& ast) {},
+ *     [&](const AstConstStmt& ast) {},
  *     [&](const AstAssignStmt& ast) {},
  *     [&](const AstIfStmt& ast) {},
  *     [&](const AstExtern& ast) {},
+ *     [&](const AstImport& ast) {},
  *     /// Decl
  *     [&](const AstVarDecl& ast) {},
+ *     [&](const AstConstDecl& ast) {},
  *     [&](const AstFuncDecl& ast) {},
  *     [&](const AstFuncParamDecl& ast) {},
  *     /// Expr
@@ -437,14 +458,20 @@ template <typename Callable>
             return std::forward<Callable>(callable)(llvm::cast<AstReturnStmt>(ast));
         case AstKind::DimStmt:
             return std::forward<Callable>(callable)(llvm::cast<AstDimStmt>(ast));
+        case AstKind::ConstStmt:
+            return std::forward<Callable>(callable)(llvm::cast<AstConstStmt>(ast));
         case AstKind::AssignStmt:
             return std::forward<Callable>(callable)(llvm::cast<AstAssignStmt>(ast));
         case AstKind::IfStmt:
             return std::forward<Callable>(callable)(llvm::cast<AstIfStmt>(ast));
         case AstKind::Extern:
             return std::forward<Callable>(callable)(llvm::cast<AstExtern>(ast));
+        case AstKind::Import:
+            return std::forward<Callable>(callable)(llvm::cast<AstImport>(ast));
         case AstKind::VarDecl:
             return std::forward<Callable>(callable)(llvm::cast<AstVarDecl>(ast));
+        case AstKind::ConstDecl:
+            return std::forward<Callable>(callable)(llvm::cast<AstConstDecl>(ast));
         case AstKind::FuncDecl:
             return std::forward<Callable>(callable)(llvm::cast<AstFuncDecl>(ast));
         case AstKind::FuncParamDecl:
@@ -467,4 +494,215 @@ template <typename Callable>
             std::unreachable();
     }
 }
+
+/**
+ * Call a callable with every node owned by the given node, in source order.
+ * Null children are skipped. Non-owning links (Ref in Ast.td) are not
+ * enumerated, so a walk built on this reaches every node exactly once.
+ *
+ * @code
+ * forEachChild(ast, [&](AstRoot& child) { stack.push_back(&child); });
+ * @endcode
+ */
+template <typename Callable>
+constexpr void forEachChild(const AstRoot& ast, Callable&& callable) {
+    switch (ast.getKind()) {
+        case AstKind::Module: {
+            const auto& node = llvm::cast<AstModule>(ast);
+            if (auto* child = node.getStmtList()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::PointerType: {
+            const auto& node = llvm::cast<AstPointerType>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ReferenceType: {
+            const auto& node = llvm::cast<AstReferenceType>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ConstType: {
+            const auto& node = llvm::cast<AstConstType>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::StmtList: {
+            const auto& node = llvm::cast<AstStmtList>(ast);
+            for (auto* child : node.getStmts()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ExprStmt: {
+            const auto& node = llvm::cast<AstExprStmt>(ast);
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::DeclareStmt: {
+            const auto& node = llvm::cast<AstDeclareStmt>(ast);
+            if (auto* child = node.getDecl()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::FuncStmt: {
+            const auto& node = llvm::cast<AstFuncStmt>(ast);
+            if (auto* child = node.getDecl()) {
+                callable(*child);
+            }
+            if (auto* child = node.getStmtList()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ReturnStmt: {
+            const auto& node = llvm::cast<AstReturnStmt>(ast);
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::DimStmt: {
+            const auto& node = llvm::cast<AstDimStmt>(ast);
+            for (auto* child : node.getDecls()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ConstStmt: {
+            const auto& node = llvm::cast<AstConstStmt>(ast);
+            for (auto* child : node.getDecls()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::AssignStmt: {
+            const auto& node = llvm::cast<AstAssignStmt>(ast);
+            if (auto* child = node.getAssignee()) {
+                callable(*child);
+            }
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::IfStmt: {
+            const auto& node = llvm::cast<AstIfStmt>(ast);
+            if (auto* child = node.getCondition()) {
+                callable(*child);
+            }
+            if (auto* child = node.getThenStmt()) {
+                callable(*child);
+            }
+            if (auto* child = node.getElseStmt()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::Extern: {
+            const auto& node = llvm::cast<AstExtern>(ast);
+            for (auto* child : node.getStmts()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::VarDecl: {
+            const auto& node = llvm::cast<AstVarDecl>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::ConstDecl: {
+            const auto& node = llvm::cast<AstConstDecl>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::FuncDecl: {
+            const auto& node = llvm::cast<AstFuncDecl>(ast);
+            for (auto* child : node.getParams()) {
+                callable(*child);
+            }
+            if (auto* child = node.getRetTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::FuncParamDecl: {
+            const auto& node = llvm::cast<AstFuncParamDecl>(ast);
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::CastExpr: {
+            const auto& node = llvm::cast<AstCastExpr>(ast);
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            if (auto* child = node.getTypeExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::CallExpr: {
+            const auto& node = llvm::cast<AstCallExpr>(ast);
+            if (auto* child = node.getCallee()) {
+                callable(*child);
+            }
+            for (auto* child : node.getArgs()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::UnaryExpr: {
+            const auto& node = llvm::cast<AstUnaryExpr>(ast);
+            if (auto* child = node.getExpr()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::BinaryExpr: {
+            const auto& node = llvm::cast<AstBinaryExpr>(ast);
+            if (auto* child = node.getLeft()) {
+                callable(*child);
+            }
+            if (auto* child = node.getRight()) {
+                callable(*child);
+            }
+            break;
+        }
+        case AstKind::MemberExpr: {
+            const auto& node = llvm::cast<AstMemberExpr>(ast);
+            if (auto* child = node.getLeft()) {
+                callable(*child);
+            }
+            if (auto* child = node.getRight()) {
+                callable(*child);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
 } // namespace lbc
@@ -0,0 +1,99 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include "AstVisitor.hpp"
+namespace lbc {
+
+/**
+ * Walks an AST in post-order on an explicit stack instead of the native
+ * call stack, so the depth of the tree is bounded by memory rather than
+ * by the thread's stack size. Children come from the generated
+ * forEachChild(), in source order.
+ *
+ * Every node is pushed once to be expanded and stays on the stack until
+ * all its children are done, so a node is handed to the callable after
+ * everything below it: operands before the expression using them.
+ *
+ * The stack is kept between walks, so a long lived walker stops touching
+ * the heap once it has seen the deepest tree. A callable may start a
+ * nested walk on the same walker, it continues above the outer one.
+ *
+ * @code
+ * AstWalker walker;
+ * TRY(walker.postOrder(
+ *     expr,
+ *     [](const AstRoot& node) { return llvm::isa<AstExpr>(node); },
+ *     [&](AstRoot& node) -> DiagResult<void> { return visit(llvm::cast<AstExpr>(node)); }
+ * ));
+ * @endcode
+ */
+class AstWalker final {
+public:
+    NO_COPY_AND_MOVE(AstWalker)
+    AstWalker() = default;
+
+    /**
+     * Walk @p root and the nodes below it that pass @p filter, calling
+     * @p callable on each in post-order. A filtered out node is skipped
+     * along with its subtree. The root is always visited.
+     *
+     * @param root node to start from
+     * @param filter predicate `bool(const AstRoot&)` selecting children to descend into
+     * @param callable `R(AstRoot&)` where R is std::expected-like
+     * @return the first failed result, or a default constructed R
+     */
+    template<typename Filter, typename Callable>
+    auto postOrder(AstRoot& root, Filter&& filter, Callable&& callable) -> std::invoke_result_t<Callable&, AstRoot&> {
+        const auto base = m_stack.size();
+        m_stack.push_back({ &root, false });
+        while (m_stack.size() > base) {
+            auto& top = m_stack.back();
+            if (top.expanded) {
+                auto* node = top.node;
+                m_stack.pop_back();
+                if (auto result = callable(*node); not result) {
+                    m_stack.resize(base);
+                    return result;
+                }
+                continue;
+            }
+
+            // Push children in source order, then flip them so the first is on top
+            top.expanded = true;
+            const auto first = m_stack.size();
+            forEachChild(*top.node, [&](AstRoot& child) {
+                if (filter(std::as_const(child))) {
+                    m_stack.push_back({ &child, false });
+                }
+            });
+            std::reverse(m_stack.begin() + static_cast<std::ptrdiff_t>(first), m_stack.end());
+            m_maxDepth = std::max(m_maxDepth, m_stack.size());
+        }
+        return {};
+    }
+
+    /**
+     * Walk every node under @p root in post-order.
+     */
+    template<typename Callable>
+    auto postOrder(AstRoot& root, Callable&& callable) -> std::invoke_result_t<Callable&, AstRoot&> {
+        return postOrder(root, [](const AstRoot&) { return true; }, std::forward<Callable>(callable));
+    }
+
+    /// Most entries the stack has held, a measure of the deepest walk so far
+    [[nodiscard]] auto getMaxDepth() const -> std::size_t { return m_maxDepth; }
+
+private:
+    /// A node waiting for its children, or to be expanded
+    struct Frame final {
+        AstRoot* node; ///< node on the stack
+        bool expanded; ///< children already pushed
+    };
+
+    std::vector<Frame> m_stack;
+    std::size_t m_maxDepth = 0;
+};
+
+} // namespace lbc
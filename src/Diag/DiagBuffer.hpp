@@ -0,0 +1,62 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <llvm/ADT/SmallVector.h>
+#include "DiagEngine.hpp"
+namespace lbc {
+
+/**
+ * Diagnostics of work running on another thread, held until they can be
+ * logged on the main thread. DiagEngine::log() renders messages through
+ * the SourceMgr, which is not thread safe, so a worker records its
+ * diagnostics here and the owner logs them with flush() in the order it
+ * chooses. A class exposing `DiagBuffer* getDiagBuffer() const` gets its
+ * LogProvider diagnostics recorded here while it returns non-null.
+ */
+class DiagBuffer final {
+public:
+    /**
+     * Record a diagnostic, with the arguments of DiagEngine::log().
+     */
+    void add(
+        const DiagMessage& message,
+        const llvm::ArrayRef<llvm::SMRange>& ranges,
+        const llvm::SMLoc loc,
+        const std::source_location& location
+    ) {
+        m_entries.push_back({ .message = message, .ranges = { ranges.begin(), ranges.end() }, .loc = loc, .location = location });
+    }
+
+    /** Check whether no diagnostic is recorded. */
+    [[nodiscard]] auto empty() const -> bool { return m_entries.empty(); }
+
+    /**
+     * Log the recorded diagnostics to @p engine in the order they were
+     * recorded and clear the buffer.
+     *
+     * @return index of the last diagnostic logged, invalid if there was none
+     */
+    auto flush(DiagEngine& engine) -> DiagIndex {
+        DiagIndex last;
+        for (const auto& entry : m_entries) {
+            last = engine.log(entry.message, entry.ranges, entry.loc, entry.location);
+        }
+        m_entries.clear();
+        return last;
+    }
+
+private:
+    /// A recorded DiagEngine::log() call
+    struct Entry final {
+        DiagMessage message;                        ///< kind and formatted text
+        llvm::SmallVector<llvm::SMRange, 1> ranges; ///< highlighted source ranges
+        llvm::SMLoc loc;                            ///< explicit location, may be invalid
+        std::source_location location;              ///< C++ call site
+    };
+
+    std::vector<Entry> m_entries;
+};
+
+} // namespace lbc
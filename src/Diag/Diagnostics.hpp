@@ -28,6 +28,8 @@ struct DiagKind final {
         codegenFailed,
         linkerFailed,
         toolNotFound,
+        cannotOpenInput,
+        invalidModuleImage,
         invalid,
         invalidNumber,
         invalidEscapeSequence,
@@ -61,6 +63,11 @@ struct DiagKind final {
         returnValueInSub,
         returnMissingValue,
         variadicRequiresC,
+        moduleNotFound,
+        importOutsideModule,
+        notConstant,
+        constantReference,
+        unreachableDefinition,
     };
 
     /**
@@ -76,7 +83,7 @@ struct DiagKind final {
     /**
      * Total number of diagnostic kinds
      */
-    static constexpr std::size_t COUNT = 43;
+    static constexpr std::size_t COUNT = 50;
 
     /**
      * Default-construct to an uninitialized diagnostic kind
@@ -123,6 +130,8 @@ struct DiagKind final {
             case codegenFailed:
             case linkerFailed:
             case toolNotFound:
+            case cannotOpenInput:
+            case invalidModuleImage:
                 return Category::System;
             case invalid:
             case invalidNumber:
@@ -159,6 +168,11 @@ struct DiagKind final {
             case returnValueInSub:
             case returnMissingValue:
             case variadicRequiresC:
+            case moduleNotFound:
+            case importOutsideModule:
+            case notConstant:
+            case constantReference:
+            case unreachableDefinition:
                 return Category::Sema;
         }
         std::unreachable();
@@ -179,6 +193,8 @@ struct DiagKind final {
             case codegenFailed:
             case linkerFailed:
             case toolNotFound:
+            case cannotOpenInput:
+            case invalidModuleImage:
             case invalid:
             case invalidNumber:
             case unexpected:
@@ -210,10 +226,16 @@ struct DiagKind final {
             case returnValueInSub:
             case returnMissingValue:
             case variadicRequiresC:
+            case moduleNotFound:
+            case importOutsideModule:
+            case notConstant:
+            case constantReference:
                 return llvm::SourceMgr::DK_Error;
             case invalidEscapeSequence:
             case unterminatedString:
                 return llvm::SourceMgr::DK_Warning;
+            case unreachableDefinition:
+                return llvm::SourceMgr::DK_Note;
         }
         std::unreachable();
     }
@@ -233,6 +255,8 @@ struct DiagKind final {
             case codegenFailed: return "E0008";
             case linkerFailed: return "E0009";
             case toolNotFound: return "E0010";
+            case cannotOpenInput: return "E0011";
+            case invalidModuleImage: return "E0012";
             case invalid: return "E0100";
             case invalidNumber: return "E0102";
             case invalidEscapeSequence: return "W0100";
@@ -266,6 +290,11 @@ struct DiagKind final {
             case returnValueInSub: return "E0322";
             case returnMissingValue: return "E0323";
             case variadicRequiresC: return "E0324";
+            case moduleNotFound: return "E0325";
+            case importOutsideModule: return "E0326";
+            case notConstant: return "E0327";
+            case constantReference: return "E0328";
+            case unreachableDefinition: return "N0300";
         }
         std::unreachable();
     }
@@ -273,8 +302,8 @@ struct DiagKind final {
     /**
      * Return all Error diagnostics
      */
-    [[nodiscard]] static consteval auto allErrors() -> std::array<DiagKind, 41> { // NOLINT(*-magic-numbers)
-        return { notImplemented, noInputFiles, inputFileNotFound, ambiguousOutput, cannotOpenOutput, backendVerificationFailed, optimizerFailed, codegenFailed, linkerFailed, toolNotFound, invalid, invalidNumber, unexpected, expected, referenceNotLast, unsupportedLinkage, undeclaredIdentifier, useBeforeDefinition, redefinition, circularDependency, typeMismatch, invalidOperands, tooManyArguments, tooFewArguments, uninitializedReference, referenceToReference, pointerToReference, nullVariable, nonAddressableExpr, notCallable, invalidUnaryOperand, dereferencingAnyPtr, invalidReferenceInit, constToReference, notAssignable, assignToConst, invalidMoveOperand, returnOutsideFunction, returnValueInSub, returnMissingValue, variadicRequiresC };
+    [[nodiscard]] static consteval auto allErrors() -> std::array<DiagKind, 47> { // NOLINT(*-magic-numbers)
+        return { notImplemented, noInputFiles, inputFileNotFound, ambiguousOutput, cannotOpenOutput, backendVerificationFailed, optimizerFailed, codegenFailed, linkerFailed, toolNotFound, cannotOpenInput, invalidModuleImage, invalid, invalidNumber, unexpected, expected, referenceNotLast, unsupportedLinkage, undeclaredIdentifier, useBeforeDefinition, redefinition, circularDependency, typeMismatch, invalidOperands, tooManyArguments, tooFewArguments, uninitializedReference, referenceToReference, pointerToReference, nullVariable, nonAddressableExpr, notCallable, invalidUnaryOperand, dereferencingAnyPtr, invalidReferenceInit, constToReference, notAssignable, assignToConst, invalidMoveOperand, returnOutsideFunction, returnValueInSub, returnMissingValue, variadicRequiresC, moduleNotFound, importOutsideModule, notConstant, constantReference };
     }
 
     /**
@@ -284,6 +313,13 @@ struct DiagKind final {
         return { invalidEscapeSequence, unterminatedString };
     }
 
+    /**
+     * Return all Note diagnostics
+     */
+    [[nodiscard]] static consteval auto allNotes() -> std::array<DiagKind, 1> { // NOLINT(*-magic-numbers)
+        return { unreachableDefinition };
+    }
+
 private:
     /// Underlying enumerator
     Value m_value;
@@ -366,6 +402,16 @@ namespace diagnostics {
         return { DiagKind::toolNotFound, std::format("cannot find tool {}; pass --toolchain or add it to PATH", tool) };
     }
 
+    /// Create cannotOpenInput message
+    [[nodiscard]] inline auto cannotOpenInput(const auto& path, const auto& reason) -> DiagMessage {
+        return { DiagKind::cannotOpenInput, std::format("cannot open input file {}: {}", path, reason) };
+    }
+
+    /// Create invalidModuleImage message
+    [[nodiscard]] inline auto invalidModuleImage(const auto& path) -> DiagMessage {
+        return { DiagKind::invalidModuleImage, std::format("{} is not a compatible module image", path) };
+    }
+
     // -------------------------------------------------------------------------
     // Lex
     // -------------------------------------------------------------------------
@@ -543,5 +589,30 @@ namespace diagnostics {
         return { DiagKind::variadicRequiresC, "variadic '...' parameters are only allowed on extern C declarations" };
     }
 
+    /// Create moduleNotFound message
+    [[nodiscard]] inline auto moduleNotFound(const auto& name) -> DiagMessage {
+        return { DiagKind::moduleNotFound, std::format("cannot find the interface of module {}", name) };
+    }
+
+    /// Create importOutsideModule message
+    [[nodiscard]] inline auto importOutsideModule() -> DiagMessage {
+        return { DiagKind::importOutsideModule, "IMPORT is only allowed at module level" };
+    }
+
+    /// Create notConstant message
+    [[nodiscard]] inline auto notConstant(const auto& name) -> DiagMessage {
+        return { DiagKind::notConstant, std::format("the value of constant {} is not known at compile time", name) };
+    }
+
+    /// Create constantReference message
+    [[nodiscard]] inline auto constantReference(const auto& name) -> DiagMessage {
+        return { DiagKind::constantReference, std::format("constant {} cannot be a reference", name) };
+    }
+
+    /// Create unreachableDefinition message
+    [[nodiscard]] inline auto unreachableDefinition(const auto& name) -> DiagMessage {
+        return { DiagKind::unreachableDefinition, std::format("{} is never used and was removed", name) };
+    }
+
 }
 } // namespace lbc
@@ -3,6 +3,7 @@
 //
 #pragma once
 #include "pch.hpp"
+#include "DiagBuffer.hpp"
 #include "DiagEngine.hpp"
 #include "Driver/Context.hpp"
 namespace lbc {
@@ -14,6 +15,12 @@ namespace lbc {
  * `getContext()` returning `Context&` automatically gains
  * access to the diagnostic engine.
  *
+ * A class that also exposes `DiagBuffer* getDiagBuffer() const`
+ * records its diagnostics in the returned buffer, when not null,
+ * for its owner to log later. Work running on other threads uses
+ * this to fail without touching the engine. The returned DiagError
+ * then holds an invalid DiagIndex.
+ *
  * @code
  * return diag(diagnostics::unexpected(token), loc);
  * @endcode
@@ -38,7 +45,21 @@ protected:
         const llvm::SMLoc loc = {},
         const std::source_location& location = std::source_location::current()
     ) -> DiagError {
-        return DiagError(self.getContext().getDiag().log(message, ranges, loc, location));
+        return report(self, message, ranges, loc, location);
+    }
+
+    /**
+     * Log a diagnostic highlighting a compact source range, resolved
+     * through the context's SourceMgr.
+     */
+    template<ContextAware T>
+    [[nodiscard]] auto diag(
+        this const T& self,
+        const DiagMessage& message,
+        const SourceRange range,
+        const std::source_location& location = std::source_location::current()
+    ) -> DiagError {
+        return report(self, message, self.getContext().resolve(range), {}, location);
     }
 
     /**
@@ -46,7 +67,26 @@ protected:
      */
     template<ContextAware T>
     [[nodiscard]] auto notImplemented(this const T& self, const std::source_location& location = std::source_location::current()) -> DiagError {
-        return DiagError(self.getContext().getDiag().log(diagnostics::notImplemented(), {}, {}, location));
+        return report(self, diagnostics::notImplemented(), {}, {}, location);
+    }
+
+private:
+    /** Log or record a diagnostic of @param self. */
+    template<typename T>
+    [[nodiscard]] static auto report(
+        const T& self,
+        const DiagMessage& message,
+        const llvm::ArrayRef<llvm::SMRange>& ranges,
+        const llvm::SMLoc loc,
+        const std::source_location& location
+    ) -> DiagError {
+        if constexpr (requires { { self.getDiagBuffer() } -> std::same_as<DiagBuffer*>; }) {
+            if (auto* buffer = self.getDiagBuffer()) {
+                buffer->add(message, ranges, loc, location);
+                return DiagError(DiagIndex {});
+            }
+        }
+        return DiagError(self.getContext().getDiag().log(message, ranges, loc, location));
     }
 };
 } // namespace lbc
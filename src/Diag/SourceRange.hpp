@@ -0,0 +1,54 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+namespace lbc {
+
+/**
+ * Compact source range: a 32-bit offset plus a 32-bit length.
+ *
+ * Offsets live in one location space shared by every buffer of the
+ * Context's SourceMgr. Each buffer is assigned a base (see
+ * Context::getLocationBase), so an offset identifies both the buffer and
+ * the position within it. Context::resolve turns a range back into
+ * SMLoc pointers on demand, which only diagnostics need.
+ *
+ * Offset 0 is never assigned to a buffer, so a default constructed range
+ * is invalid and resolves to an empty llvm::SMRange.
+ */
+class SourceRange final {
+public:
+    /** Construct an invalid range. */
+    constexpr SourceRange() = default;
+
+    /** Construct a range of @p length bytes starting at @p offset. */
+    constexpr SourceRange(const std::uint32_t offset, const std::uint32_t length)
+    : m_offset(offset)
+    , m_length(length) {}
+
+    /// Check whether this range refers to source
+    [[nodiscard]] constexpr auto isValid() const -> bool { return m_offset != 0; }
+
+    /// Get the offset of the first byte
+    [[nodiscard]] constexpr auto getOffset() const -> std::uint32_t { return m_offset; }
+
+    /// Get the number of bytes covered
+    [[nodiscard]] constexpr auto getLength() const -> std::uint32_t { return m_length; }
+
+    /// Get the offset one past the last byte
+    [[nodiscard]] constexpr auto getEnd() const -> std::uint32_t { return m_offset + m_length; }
+
+    /** Range from the start of this range to the end of @p last. */
+    [[nodiscard]] constexpr auto to(const SourceRange last) const -> SourceRange {
+        return { m_offset, last.getEnd() - m_offset };
+    }
+
+    [[nodiscard]] constexpr auto operator==(const SourceRange& other) const -> bool = default;
+
+private:
+    std::uint32_t m_offset = 0;
+    std::uint32_t m_length = 0;
+};
+
+} // namespace lbc
@@ -222,6 +222,12 @@ auto CompileOptions::toCommandLine() const -> std::string {
     if (m_verbose) {
         append("--verbose");
     }
+    if (m_lazyBodies) {
+        append("--lazy-bodies");
+    }
+    if (m_emitInterface) {
+        append("--emit-interface");
+    }
     if (!m_outputPath.empty()) {
         appendPath("-o", m_outputPath);
     }
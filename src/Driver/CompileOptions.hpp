@@ -148,6 +148,12 @@ public:
     /** Toggle verbose output. */
     void setVerbose(const bool enable) { m_verbose = enable; }
 
+    /** Toggle parsing, analysing and lowering SUB / FUNCTION bodies only when reachable. */
+    void setLazyBodies(const bool enable) { m_lazyBodies = enable; }
+
+    /** Toggle writing each module's interface for IMPORT to the build path. */
+    void setEmitInterface(const bool enable) { m_emitInterface = enable; }
+
     // -------------------------------------------------------------------------
     // Observers
     // -------------------------------------------------------------------------
@@ -176,6 +182,8 @@ public:
     [[nodiscard]] auto isDumpIr() const -> bool { return m_dumpIr; }
     [[nodiscard]] auto isDumpConfig() const -> bool { return m_dumpConfig; }
     [[nodiscard]] auto isVerbose() const -> bool { return m_verbose; }
+    [[nodiscard]] auto isLazyBodies() const -> bool { return m_lazyBodies; }
+    [[nodiscard]] auto isEmitInterface() const -> bool { return m_emitInterface; }
 
     /** Render the options as an equivalent command-line string (for debugging). */
     [[nodiscard]] auto toCommandLine() const -> std::string;
@@ -202,6 +210,8 @@ private:
     bool m_dumpIr = false;                                         ///< dump the lbc IR for debugging
     bool m_dumpConfig = false;                                     ///< dump the options as a command line
     bool m_verbose = false;                                        ///< verbose diagnostics
+    bool m_lazyBodies = false;                                     ///< only compile reachable SUB / FUNCTION bodies
+    bool m_emitInterface = false;                                  ///< write <source stem>.lbci for IMPORT
 };
 
 } // namespace lbc
@@ -2,8 +2,11 @@
 // Created by Albert Varaksin on 13/02/2026.
 //
 #include "Context.hpp"
+#include "Ast/AstArena.hpp"
 #include <llvm/ADT/SmallString.h>
+#include <llvm/Support/ErrorHandling.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
 #include <llvm/TargetParser/Host.h>
 using namespace lbc;
 
@@ -82,13 +85,59 @@ Context::Context(CompileOptions options)
 , m_triple(buildTriple(m_options))
 , m_llvmContext(std::make_unique<llvm::LLVMContext>())
 , m_sourceMgr(std::make_unique<llvm::SourceMgr>())
+, m_astArena(std::make_unique<AstArena>(m_allocator))
+, m_identifiers(m_allocator)
 , m_diagEngine(*this)
 , m_typeFactory(*this) {}
 
+Context::~Context() = default;
+
 auto Context::retain(const llvm::StringRef string) -> llvm::StringRef {
+    const std::scoped_lock lock { m_stringsMutex };
     return m_strings.insert(string).first->first();
 }
 
+auto Context::createArena() -> llvm::BumpPtrAllocator& {
+    const std::scoped_lock lock { m_arenasMutex };
+    return *m_arenas.emplace_back(std::make_unique<llvm::BumpPtrAllocator>());
+}
+
+auto Context::createAstArena() -> AstArena& {
+    auto& allocator = createArena();
+    const std::scoped_lock lock { m_arenasMutex };
+    auto& arena = *m_astArenas.emplace_back(std::make_unique<AstArena>(allocator));
+    arena.setPooling(m_astArena->getPooling());
+    return arena;
+}
+
+auto Context::getLocationBase(const unsigned id) -> std::uint32_t {
+    assert(id > 0 && id <= m_sourceMgr->getNumBuffers() && "invalid source buffer id");
+    while (m_locationBases.size() < id) {
+        std::uint64_t base = 1;
+        if (!m_locationBases.empty()) {
+            const auto prev = static_cast<unsigned>(m_locationBases.size());
+            base = m_locationBases.back() + m_sourceMgr->getMemoryBuffer(prev)->getBufferSize() + 1;
+        }
+        const auto size = m_sourceMgr->getMemoryBuffer(static_cast<unsigned>(m_locationBases.size() + 1))->getBufferSize();
+        if (base + size > std::numeric_limits<std::uint32_t>::max()) {
+            llvm::report_fatal_error("combined source size exceeds 4 GiB");
+        }
+        m_locationBases.push_back(static_cast<std::uint32_t>(base));
+    }
+    return m_locationBases[id - 1];
+}
+
+auto Context::resolve(const SourceRange range) const -> llvm::SMRange {
+    if (!range.isValid()) {
+        return {};
+    }
+    const auto iter = std::ranges::upper_bound(m_locationBases, range.getOffset());
+    assert(iter != m_locationBases.begin() && "range outside of known source buffers");
+    const auto id = static_cast<unsigned>(iter - m_locationBases.begin());
+    const char* start = m_sourceMgr->getMemoryBuffer(id)->getBufferStart() + (range.getOffset() - *std::prev(iter)); // NOLINT(*-pro-bounds-pointer-arithmetic)
+    return { llvm::SMLoc::getFromPointer(start), llvm::SMLoc::getFromPointer(start + range.getLength()) }; // NOLINT(*-pro-bounds-pointer-arithmetic)
+}
+
 auto Context::createTempFile(const llvm::StringRef suffix) -> std::string {
     llvm::SmallString<128> path;
     if (llvm::sys::fs::createTemporaryFile("lbc", suffix, path)) {
@@ -97,10 +146,70 @@ auto Context::createTempFile(const llvm::StringRef suffix) -> std::string {
     return std::string { path.data(), path.size() };
 }
 
+auto Context::mapFile(const llvm::StringRef path) -> std::expected<std::span<char>, std::error_code> {
+    auto file = llvm::sys::fs::openNativeFileForRead(path);
+    if (!file) {
+        return std::unexpected(llvm::errorToErrorCode(file.takeError()));
+    }
+
+    llvm::sys::fs::file_status status;
+    if (const auto error = llvm::sys::fs::status(*file, status)) {
+        std::ignore = llvm::sys::fs::closeFile(*file);
+        return std::unexpected(error);
+    }
+    if (status.getSize() == 0) {
+        std::ignore = llvm::sys::fs::closeFile(*file);
+        return std::span<char> {};
+    }
+
+    // The mapping outlives the file handle
+    std::error_code error;
+    auto region = std::make_unique<llvm::sys::fs::mapped_file_region>(
+        *file, llvm::sys::fs::mapped_file_region::priv, status.getSize(), 0, error
+    );
+    std::ignore = llvm::sys::fs::closeFile(*file);
+    if (error) {
+        return std::unexpected(error);
+    }
+
+    const std::scoped_lock lock { m_mappingsMutex };
+    const auto& mapped = *m_mappings.emplace_back(std::move(region));
+    return std::span { mapped.data(), mapped.size() };
+}
+
+auto Context::findInterface(const llvm::StringRef name) const -> std::string {
+    const auto file = (name + "." + kInterfaceExtension).str();
+    const auto search = [&](const llvm::StringRef dir) -> std::string {
+        if (dir.empty()) {
+            return {};
+        }
+        llvm::SmallString<256> path { dir };
+        llvm::sys::path::append(path, file);
+        if (!m_options.getWorkingDirectory().empty()) {
+            llvm::sys::path::make_absolute(m_options.getWorkingDirectory(), path);
+        }
+        if (!llvm::sys::fs::exists(path)) {
+            return {};
+        }
+        return std::string { path.data(), path.size() };
+    };
+
+    if (auto path = search(m_options.getBuildPath()); !path.empty()) {
+        return path;
+    }
+    for (const auto& dir : m_options.getIncludePaths()) {
+        if (auto path = search(dir); !path.empty()) {
+            return path;
+        }
+    }
+    return {};
+}
+
 auto Context::replaceContext(std::unique_ptr<llvm::LLVMContext> replacement) -> std::unique_ptr<llvm::LLVMContext> {
     return std::exchange(m_llvmContext, std::move(replacement));
 }
 
 auto Context::replaceSourceManager(std::unique_ptr<llvm::SourceMgr> replacement) -> std::unique_ptr<llvm::SourceMgr> {
+    m_locationBases.clear();
     return std::exchange(m_sourceMgr, std::move(replacement));
 }
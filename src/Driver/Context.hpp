@@ -3,12 +3,19 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <mutex>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/TargetParser/Triple.h>
 #include "CompileOptions.hpp"
 #include "Diag/DiagEngine.hpp"
+#include "Diag/SourceRange.hpp"
+#include "Symbol/IdentifierTable.hpp"
 #include "Type/TypeFactory.hpp"
+namespace llvm::sys::fs {
+class mapped_file_region;
+}
 namespace lbc {
+class AstArena;
 class Context;
 
 /**
@@ -27,15 +34,25 @@ public:
 
     /** Construct a context that owns the (frozen) options for this compilation. */
     explicit Context(CompileOptions options = {});
+    ~Context();
+
+    /// File extension of module interfaces
+    static constexpr llvm::StringLiteral kInterfaceExtension = "lbci";
 
     /**
      * Intern given string in a set and return unique, shared copy.
+     * Safe to call from multiple threads.
      *
      * @param string string to intern
      * @return interned copy of the string
      */
     [[nodiscard]] auto retain(llvm::StringRef string) -> llvm::StringRef;
 
+    /**
+     * Get the table interning identifier names in their upper case form
+     */
+    [[nodiscard]] auto getIdentifiers() -> IdentifierTable& { return m_identifiers; }
+
     /**
      * Allocate memory, this memory is not expected to be deallocated
      */
@@ -43,6 +60,30 @@ public:
         return m_allocator.Allocate(bytes, alignment);
     }
 
+    /**
+     * Get the main memory arena, not thread safe
+     */
+    [[nodiscard]] auto getAllocator() -> llvm::BumpPtrAllocator& { return m_allocator; }
+
+    /**
+     * Create an additional memory arena for work running on another thread.
+     * The arena is owned by the context, so memory allocated from it lives
+     * as long as the main arena. Safe to call from multiple threads.
+     */
+    [[nodiscard]] auto createArena() -> llvm::BumpPtrAllocator&;
+
+    /**
+     * Get the arena AST nodes are allocated from, not thread safe
+     */
+    [[nodiscard]] auto getAstArena() -> AstArena& { return *m_astArena; }
+
+    /**
+     * Create an additional AST arena for work running on another thread,
+     * backed by a new arena from createArena(). Nodes are pooled the same
+     * way as in the main AST arena. Safe to call from multiple threads.
+     */
+    [[nodiscard]] auto createAstArena() -> AstArena&;
+
     /**
      * Allocate an uninitialized array of T.
      *
@@ -72,6 +113,19 @@ public:
      */
     [[nodiscard]] auto getSourceMgr() -> llvm::SourceMgr& { return *m_sourceMgr; }
 
+    /**
+     * Get the compact location of the first byte of source buffer @p id.
+     * Bases are assigned in buffer order, leaving a one byte gap between
+     * buffers so a range ending a buffer never reads as the next one.
+     */
+    [[nodiscard]] auto getLocationBase(unsigned id) -> std::uint32_t;
+
+    /**
+     * Resolve a compact source range back to locations in the SourceMgr.
+     * Invalid ranges resolve to an empty llvm::SMRange.
+     */
+    [[nodiscard]] auto resolve(SourceRange range) const -> llvm::SMRange;
+
     /**
      * Get diagnostics engine
      */
@@ -107,6 +161,24 @@ public:
      */
     [[nodiscard]] auto createTempFile(llvm::StringRef suffix) -> std::string;
 
+    /**
+     * Map the file at @p path into memory, copy-on-write: the pages can be
+     * written without changing the file. The mapping lives as long as the
+     * context. Safe to call from multiple threads.
+     *
+     * @return the mapped bytes, or the error that prevented mapping
+     */
+    [[nodiscard]] auto mapFile(llvm::StringRef path) -> std::expected<std::span<char>, std::error_code>;
+
+    /**
+     * Find the interface file of module @p name, `<name>.lbci`, searching the
+     * build path and then the include search hierarchy. Relative directories
+     * are taken from the working directory.
+     *
+     * @return path to the interface, or empty if there is none
+     */
+    [[nodiscard]] auto findInterface(llvm::StringRef name) const -> std::string;
+
     /**
      * Swap context
      *
@@ -130,8 +202,17 @@ private:
     llvm::Triple m_triple;
     std::unique_ptr<llvm::LLVMContext> m_llvmContext;
     std::unique_ptr<llvm::SourceMgr> m_sourceMgr;
+    std::vector<std::uint32_t> m_locationBases; ///< compact location base of each buffer, by id - 1
     llvm::BumpPtrAllocator m_allocator;
+    std::vector<std::unique_ptr<llvm::BumpPtrAllocator>> m_arenas; ///< arenas handed out by createArena
+    std::unique_ptr<AstArena> m_astArena;                          ///< main AST node pools
+    std::vector<std::unique_ptr<AstArena>> m_astArenas;            ///< AST arenas handed out by createAstArena
+    std::mutex m_arenasMutex;
+    std::vector<std::unique_ptr<llvm::sys::fs::mapped_file_region>> m_mappings; ///< files mapped by mapFile
+    std::mutex m_mappingsMutex;
     llvm::StringSet<llvm::BumpPtrAllocator> m_strings;
+    std::mutex m_stringsMutex;
+    IdentifierTable m_identifiers;
     DiagEngine m_diagEngine;
     TypeFactory m_typeFactory;
 };
@@ -2,7 +2,9 @@
 // Created by Albert Varaksin on 15/06/2026.
 //
 #include "CompileTask.hpp"
+#include <llvm/Support/Path.h>
 #include "Ast/AstCodePrinter.hpp"
+#include "Ast/AstImage.hpp"
 #include "Driver/Context.hpp"
 #include "Gen/Generator.hpp"
 #include "IR/gen/IrGenerator.hpp"
@@ -20,11 +22,25 @@ auto CompileTask::run(Context& context, std::string source) -> DiagResult<std::u
         return DiagError { context.getDiag().log(diagnostics::inputFileNotFound(source)) };
     }
 
-    Parser parser { context, id };
+    // Large sources are lexed up front, which lets both the lexer and the
+    // parser split the work across threads.
+    const auto size = context.getSourceMgr().getMemoryBuffer(id)->getBufferSize();
+    const auto tokenise = size >= TokenBuffer::kParallelThreshold ? Parser::Tokenise::Upfront : Parser::Tokenise::OnDemand;
+    const auto bodies = options.isLazyBodies() ? Parser::Bodies::Lazy : Parser::Bodies::Eager;
+    Parser parser { context, id, tokenise, bodies };
     TRY_DECL(module, parser.parse())
 
+    // Deferred bodies are parsed as sema finds them reachable, so the parser
+    // outlives the analysis.
     SemanticAnalyser sema { context };
-    TRY(sema.analyse(*module))
+    TRY(sema.analyse(*module, [&](AstFuncStmt& ast) { return parser.parseBody(ast); }))
+
+    // Other modules IMPORT this one through its interface, named after the source.
+    if (options.isEmitInterface()) {
+        const auto path = options.artifactPath(llvm::sys::path::stem(source), Context::kInterfaceExtension);
+        AstImageWriter writer { context };
+        TRY(writer.writeInterface(*module, path))
+    }
 
     // Debug dumps go to stderr so they never pollute the artifact on stdout.
     if (options.isDumpAst()) {
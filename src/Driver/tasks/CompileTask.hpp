@@ -13,7 +13,7 @@ namespace lbc {
 /**
  * Frontend stage: lex, parse, analyse, and lower one source file (given by its
  * path) to an in-memory LLVM module. Runs entirely in process. Honours the AST
- * and lbc-IR debug dumps.
+ * and lbc-IR debug dumps, and writes the module interface when asked to.
  */
 class CompileTask final : public Task<std::string, std::unique_ptr<llvm::Module>> {
 public:
@@ -25,8 +25,8 @@ auto Generator::generate(const ir::lib::Module& module) -> std::unique_ptr<llvm:
     m_module->setTargetTriple(m_context.getTriple());
 
     // Materialise module-scope globals before anything references them: their
-    // initialiser stores live in the global-init block (lowered into `main`) and
-    // function bodies may read them.
+    // initialiser stores, if any, live in the global-init block (lowered into
+    // `main`) and function bodies may read them.
     for (const auto* decl : module.getDeclarations()) {
         lowerGlobal(llvm::cast<ir::lib::VarInstr>(*decl));
     }
@@ -88,17 +88,24 @@ void Generator::bindParameters(const ir::lib::Function& fn) {
 }
 
 void Generator::lowerGlobal(const ir::lib::VarInstr& var) {
-    // A module-scope `dim` becomes an LLVM global. It is zero-initialised so the
-    // global is a definition; any user initialiser runs as a store in the
-    // global-init block (lowered into `main`), uniformly for constant and runtime
-    // values. The module takes ownership of the GlobalVariable on construction.
+    // A module-scope `dim` becomes an LLVM global. A constant initialiser is its
+    // initial value, otherwise it is zero-initialised so the global is a
+    // definition and the initialiser runs as a store in the global-init block
+    // (lowered into `main`). The module takes ownership of the GlobalVariable
+    // on construction.
     auto* type = lowerType(var.getType());
+    llvm::Constant* initial = llvm::Constant::getNullValue(type);
+    if (const auto* variable = llvm::dyn_cast<ir::lib::Variable>(var.getResult())) {
+        if (const auto* init = variable->getInitializer()) {
+            initial = literal(*init);
+        }
+    }
     auto* global = new llvm::GlobalVariable(
         *m_module,
         type,
         /*isConstant*/ false,
         llvm::GlobalValue::InternalLinkage,
-        llvm::Constant::getNullValue(type),
+        initial,
         var.getResult()->getName()
     );
     var.getResult()->setLlvm(global);
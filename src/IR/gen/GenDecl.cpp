@@ -2,6 +2,7 @@
 // Created by Albert Varaksin on 08/03/2026.
 //
 #include "IR/lib/Function.hpp"
+#include "IR/lib/Literal.hpp"
 #include "IR/lib/Variable.hpp"
 #include "IrGenerator.hpp"
 #include "Symbol/Symbol.hpp"
@@ -9,21 +10,41 @@ using namespace lbc::ir::gen;
 
 auto IrGenerator::accept(const AstVarDecl& ast) -> Result {
     auto* symbol = ast.getSymbol();
+
+    // Nothing reachable uses the variable, only its initialiser's side effects remain
+    if (symbol->hasFlag(SymbolFlags::Unreachable)) {
+        if (auto* expr = ast.getExpr()) {
+            TRY(expression(*expr));
+        }
+        return {};
+    }
+
     auto* var = getContext().create<lib::Variable>(symbol);
     symbol->setOperand(var);
 
     // Emit variable declaration
     emit(makeVar(var, ast.getType()));
 
-    // Emit initialiser if present
+    // Emit initialiser if present. A global initialised with a constant starts
+    // out with the value, string literals are materialised at run time.
     if (auto* expr = ast.getExpr()) {
-        TRY(visit(*expr));
-        emit(makeStore(var, expr->getOperand()));
+        TRY(expression(*expr));
+        const auto* literal = llvm::dyn_cast<lib::Literal>(expr->getOperand());
+        if (m_function == nullptr && literal != nullptr && not literal->getValue().isString() && expr->getType() == ast.getType()) {
+            var->setInitializer(literal);
+        } else {
+            emit(makeStore(var, expr->getOperand()));
+        }
     }
 
     return {};
 }
 
+auto IrGenerator::accept(const AstConstDecl& /*ast*/) -> Result {
+    // No-op: uses of a constant are folded to its value
+    return {};
+}
+
 auto IrGenerator::accept(const AstFuncDecl& ast) const -> Result {
     auto* symbol = ast.getSymbol();
     auto* func = getContext().create<lib::Function>(getContext(), symbol);
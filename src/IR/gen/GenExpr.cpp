@@ -8,8 +8,16 @@
 #include "Symbol/Symbol.hpp"
 using namespace lbc::ir::gen;
 
+auto IrGenerator::expression(AstExpr& ast) -> Result {
+    // Type expressions under casts carry nothing to lower
+    return m_walker.postOrder(
+        ast,
+        [](const AstRoot& node) { return llvm::isa<AstExpr>(node); },
+        [&](AstRoot& node) { return visit(llvm::cast<AstExpr>(node)); }
+    );
+}
+
 auto IrGenerator::accept(AstCastExpr& ast) -> Result {
-    TRY(visit(*ast.getExpr()));
     auto* tmp = createTemporary(ast.getType());
     emit(makeCast(tmp, ast.getType(), ast.getExpr()->getOperand()));
     ast.setOperand(tmp);
@@ -22,14 +30,10 @@ auto IrGenerator::accept(AstVarExpr& ast) -> Result {
 }
 
 auto IrGenerator::accept(AstCallExpr& ast) -> Result {
-    // Visit callee
-    TRY(visit(*ast.getCallee()));
-
-    // Visit arguments
+    // Collect arguments
     const auto args = ast.getArgs();
     auto argValues = getContext().span<lib::Value*>(args.size());
     for (std::size_t i = 0; i < args.size(); i++) {
-        TRY(visit(*args[i]));
         argValues[i] = args[i]->getOperand();
     }
 
@@ -50,7 +54,6 @@ auto IrGenerator::accept(AstLiteralExpr& ast) const -> Result {
 }
 
 auto IrGenerator::accept(AstUnaryExpr& ast) -> Result {
-    TRY(visit(*ast.getExpr()));
     auto* operand = ast.getExpr()->getOperand();
 
     // No move constructors yet: MOVE forwards its operand unchanged at the IR
@@ -85,9 +88,6 @@ auto IrGenerator::accept(AstUnaryExpr& ast) -> Result {
 }
 
 auto IrGenerator::accept(AstBinaryExpr& ast) -> Result {
-    TRY(visit(*ast.getLeft()));
-    TRY(visit(*ast.getRight()));
-
     auto* lhs = ast.getLeft()->getOperand();
     auto* rhs = ast.getRight()->getOperand();
     auto* tmp = createTemporary(ast.getType());
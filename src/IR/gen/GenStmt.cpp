@@ -10,6 +10,16 @@
 using namespace lbc::ir::gen;
 
 auto IrGenerator::accept(const AstStmtList& ast) -> Result {
+    // Functions exported by imported modules are declared like local ones,
+    // their definitions live in the object of the imported module.
+    for (auto* stmt : ast.getStmts()) {
+        if (const auto* import = llvm::dyn_cast<AstImport>(stmt)) {
+            for (auto* decl : import->getModule()->getStmtList()->getDecls()) {
+                TRY(visit(*decl));
+            }
+        }
+    }
+
     // Forward-declare functions so calls resolve regardless of definition order
     // (mirrors sema's two-phase declare/define). Variables are lowered in place
     // by their own statements, not here.
@@ -25,7 +35,7 @@ auto IrGenerator::accept(const AstStmtList& ast) -> Result {
 }
 
 auto IrGenerator::accept(const AstExprStmt& ast) -> Result {
-    TRY(visit(*ast.getExpr()));
+    TRY(expression(*ast.getExpr()));
     return {};
 }
 
@@ -35,12 +45,15 @@ auto IrGenerator::accept(const AstDeclareStmt& /*ast*/) -> Result {
 }
 
 auto IrGenerator::accept(const AstFuncStmt& ast) -> Result {
-    const ValueRestorer restor { m_function, m_block, m_tempCounter, m_ifCounter };
-
-    // Create function and add to module
+    // A body still deferred after sema, or one nothing reachable calls, is not lowered.
     const auto* symbol = ast.getDecl()->getSymbol();
+    if (ast.getDeferred() || symbol->hasFlag(SymbolFlags::Unreachable)) {
+        return {};
+    }
 
-    // Set up function state
+    const ValueRestorer restor { m_function, m_block, m_tempCounter, m_ifCounter };
+
+    // Set up function state and add it to the module
     m_function = llvm::cast<lib::Function>(symbol->getOperand());
     m_module->getFunctions().push_back(m_function);
     m_tempCounter = 0;
@@ -67,7 +80,7 @@ auto IrGenerator::accept(const AstFuncStmt& ast) -> Result {
 auto IrGenerator::accept(const AstReturnStmt& ast) -> Result {
     lib::Value* value = nullptr;
     if (auto* expr = ast.getExpr()) {
-        TRY(visit(*expr));
+        TRY(expression(*expr));
         value = expr->getOperand();
     }
     emit(makeRet(value));
@@ -81,12 +94,17 @@ auto IrGenerator::accept(const AstDimStmt& ast) -> Result {
     return {};
 }
 
+auto IrGenerator::accept(const AstConstStmt& /*ast*/) -> Result {
+    // No-op: uses of a constant are folded to its value
+    return {};
+}
+
 auto IrGenerator::accept(const AstAssignStmt& ast) -> Result {
     auto& dst = *ast.getAssignee();
     const auto& expr = *ast.getExpr();
 
-    TRY(visit(dst));
-    TRY(visit(*ast.getExpr()));
+    TRY(expression(dst));
+    TRY(expression(*ast.getExpr()));
 
     emit(makeStore(llvm::cast<lib::NamedValue>(dst.getOperand()), expr.getOperand()));
     return {};
@@ -116,7 +134,7 @@ auto IrGenerator::accept(const AstIfStmt& ast) -> Result {
 
         // Emit conditional jump with both targets
         auto* cond = ifStmt->getCondition();
-        TRY(visit(*cond));
+        TRY(expression(*cond));
         emit(makeJmp(cond->getOperand(), thenBlock, falseBlock));
 
         // Emit THEN block
@@ -152,3 +170,8 @@ auto IrGenerator::accept(const AstExtern& ast) -> Result {
     }
     return {};
 }
+
+auto IrGenerator::accept(const AstImport& /*ast*/) -> Result {
+    // No-op: imported declarations handled during StmtList processing
+    return {};
+}
@@ -5,6 +5,7 @@
 #include "pch.hpp"
 #include "Ast/Ast.hpp"
 #include "Ast/AstVisitor.hpp"
+#include "Ast/AstWalker.hpp"
 #include "Diag/DiagEngine.hpp"
 #include "Diag/LogProvider.hpp"
 #include "IR/lib/Builder.hpp"
@@ -55,6 +56,9 @@ private:
     /** Generate IR for a variable declaration. */
     [[nodiscard]] auto accept(const AstVarDecl& ast) -> Result;
 
+    /** Constants fold to literals during analysis, no IR is generated. */
+    [[nodiscard]] static auto accept(const AstConstDecl& ast) -> Result;
+
     /** Generate IR for a function declaration. */
     [[nodiscard]] auto accept(const AstFuncDecl& ast) const -> Result;
 
@@ -83,6 +87,9 @@ private:
     /** Generate IR for a DIM statement. */
     [[nodiscard]] auto accept(const AstDimStmt& ast) -> Result;
 
+    /** Generate IR for a CONST statement, which has none. */
+    [[nodiscard]] static auto accept(const AstConstStmt& ast) -> Result;
+
     /** Generate IR for an assignment statement. */
     [[nodiscard]] auto accept(const AstAssignStmt& ast) -> Result;
 
@@ -92,10 +99,19 @@ private:
     /** Generate IR for an EXTERN linkage block (lowers the declared functions). */
     [[nodiscard]] auto accept(const AstExtern& ast) -> Result;
 
+    /** Generate IR for an IMPORT statement. */
+    [[nodiscard]] static auto accept(const AstImport& ast) -> Result;
+
     // -------------------------------------------------------------------------
     // Expressions (GenExpr.cpp)
+    //
+    // Operands are lowered before the expression using them by expression(),
+    // handlers only combine the operands already set on their children.
     // -------------------------------------------------------------------------
 
+    /** Generate IR for an expression tree, iteratively in post-order. */
+    [[nodiscard]] auto expression(AstExpr& ast) -> Result;
+
     /** Generate IR for a cast expression. */
     [[nodiscard]] auto accept(AstCastExpr& ast) -> Result;
 
@@ -171,6 +187,7 @@ private:
     lib::BasicBlock* m_block = nullptr;  ///< current insertion point
     unsigned m_tempCounter = 0;          ///< temporary numbering (resets per function)
     unsigned m_ifCounter = 0;            ///< if statement counter (resets per function)
+    AstWalker m_walker;                  ///< explicit stack for lowering expressions
 };
 
 } // namespace lbc::ir::gen
@@ -8,13 +8,15 @@ namespace lbc {
 class Symbol;
 } // namespace lbc
 namespace lbc::ir::lib {
+class Literal;
 
 /**
  * A user-declared variable (DIM x AS INTEGER).
  *
  * Represents the storage location created by a VarInstr. Each variable
  * has a name (the identifier), a type, and a reference to the frontend
- * symbol for debug and diagnostic purposes.
+ * symbol for debug and diagnostic purposes. A global may start out with
+ * a constant value instead of having it stored by the global init block.
  */
 class Variable final : public NamedValue {
 public:
@@ -28,8 +30,14 @@ public:
     /** Get the frontend symbol associated with this variable. */
     [[nodiscard]] auto getSymbol() const -> Symbol* { return m_symbol; }
 
+    /** Get the value a global starts out with, null if zero initialised. */
+    [[nodiscard]] auto getInitializer() const -> const Literal* { return m_initializer; }
+    /** Set the value a global starts out with. */
+    void setInitializer(const Literal* initializer) { m_initializer = initializer; }
+
 private:
-    Symbol* m_symbol; ///< frontend symbol with type and debug info
+    Symbol* m_symbol;                      ///< frontend symbol with type and debug info
+    const Literal* m_initializer = nullptr; ///< static initial value of a global
 };
 
 } // namespace lbc::ir::lib
@@ -30,6 +30,24 @@ void Printer::print(const Module& module) const {
         printInstruction(*decl);
     }
 
+    // Static initial values of globals
+    bool staticData = false;
+    for (auto* decl : module.getDeclarations()) {
+        const auto* var = llvm::dyn_cast<Variable>(llvm::cast<VarInstr>(decl)->getResult());
+        if (var == nullptr || var->getInitializer() == nullptr) {
+            continue;
+        }
+        if (not staticData) {
+            emitComment("; static data");
+            m_output << '\n';
+            staticData = true;
+        }
+        emitLocal(*var);
+        m_output << " = ";
+        emitLiteral(*var->getInitializer());
+        m_output << '\n';
+    }
+
     // Global init block
     if (auto* block = module.getGlobalInitBlock()) {
         if (!block->getBody().empty()) {
@@ -77,6 +77,21 @@ public:
         m_ptr += amount; // NOLINT(*-pro-bounds-pointer-arithmetic)
     }
 
+    /**
+     * Move the cursor forward to the given position, typically one found by
+     * a bulk scan. In debug builds, asserts that the target is not behind the
+     * cursor and that no null terminator is skipped.
+     */
+    constexpr void advanceTo(const char* ptr) {
+        assert(m_ptr <= ptr && "Cannot advance backwards");
+#if LBC_DEBUG_BUILD
+        for (const auto* iter = m_ptr; iter != ptr; ++iter) { // NOLINT(*-pro-bounds-pointer-arithmetic)
+            assert(*iter != '\0' && "Advancing past \0 terminator");
+        }
+#endif
+        m_ptr = ptr;
+    }
+
     /**
      * Advance the cursor while the predicate holds for the current character.
      */
@@ -3,34 +3,32 @@
 //
 #include "Lexer.hpp"
 #include "Driver/Context.hpp"
+#include "Number.hpp"
+#include "Scan.hpp"
 using namespace lbc;
 
-namespace {
-const llvm::StringMap<TokenKind> kKeywords = [] static {
-    llvm::StringMap<TokenKind> keywords {};
-    for (const auto& kind : TokenKind::allKeywords()) {
-        keywords.try_emplace(kind.string(), kind);
-    }
-    for (const auto& kind : TokenKind::allOperatorKeywords()) {
-        keywords.try_emplace(kind.string(), kind);
-    }
-    for (const auto& kind : TokenKind::allTypes()) {
-        keywords.try_emplace(kind.string(), kind);
-    }
-    return keywords;
-}();
-} // namespace
-
 Lexer::Lexer(Context& context, unsigned id)
 : m_context(context)
 , m_id(id)
 , m_start(context.getSourceMgr().getMemoryBuffer(id)->getBufferStart())
 , m_input(m_start)
+, m_limit(context.getSourceMgr().getMemoryBuffer(id)->getBufferEnd() + 1) // NOLINT(*-pro-bounds-pointer-arithmetic)
+, m_end(context.getSourceMgr().getMemoryBuffer(id)->getBufferEnd())
 , m_hasStatement(false) {
 }
 
+void Lexer::restrict(const char* start, const char* limit, const bool hasStatement) {
+    m_start = m_input = Cursor { start };
+    m_limit = limit;
+    m_hasStatement = hasStatement;
+}
+
 auto Lexer::next() -> DiagResult<Token> {
     while (true) {
+        // a restricted lexer stops at the limit, leaving the state for the caller
+        if (m_input.data() >= m_limit) {
+            return Token { TokenKind::EndOfFile, range() };
+        }
         switch (m_input.current().getChar()) {
         case '\0':
             return endOfFile();
@@ -53,7 +51,11 @@ auto Lexer::next() -> DiagResult<Token> {
             continue;
         case ' ':
         case '\t':
+            // single separating blanks are the common case, only scan longer runs
             m_input.advance();
+            if (m_input.current().isWhiteSpace()) {
+                m_input.advanceTo(scan::whiteSpaceEnd(m_input.data()));
+            }
             continue;
         case '\'':
             skipUntilLineEnd();
@@ -121,6 +123,19 @@ auto Lexer::next() -> DiagResult<Token> {
             return make(TokenKind::GreaterThan);
         case '@':
             return make(TokenKind::AddressOf);
+        case '&':
+            switch (m_input.peek().getChar()) {
+            case 'H':
+            case 'h':
+            case 'O':
+            case 'o':
+            case 'B':
+            case 'b':
+                return radixLiteral();
+            default:
+                m_input.advance();
+                return invalid();
+            }
             // clang-format off
         case '0': case '1': case '2': case '3': case '4':
         case '5': case '6': case '7': case '8': case '9':
@@ -155,8 +170,23 @@ auto Lexer::peek() -> DiagResult<Token> {
 // Token factories
 // ------------------------------------
 
+auto Lexer::report(const DiagMessage& message) -> DiagError {
+    if (m_speculative) {
+        m_speculationFailed = true;
+        return DiagError(DiagIndex {});
+    }
+    return diag(message, range());
+}
+
+auto Lexer::retain(const llvm::StringRef string) -> llvm::StringRef {
+    if (m_speculative) {
+        return m_scratch.save(string);
+    }
+    return m_context.retain(string);
+}
+
 auto Lexer::invalid() -> DiagError {
-    return diag(diagnostics::invalid(), range());
+    return report(diagnostics::invalid());
 }
 
 auto Lexer::endOfFile() -> Token {
@@ -178,9 +208,9 @@ auto Lexer::make(const TokenKind kind, const std::size_t len) -> Token {
     return Token { kind, range() };
 }
 
-auto Lexer::token(const TokenKind kind, const LiteralValue& value) -> Token {
+auto Lexer::token(const TokenKind kind, const LiteralValue& value, const TokenKind typeSuffix) -> Token {
     m_hasStatement = true;
-    return Token { kind, range(), value };
+    return Token { kind, range(), value, typeSuffix };
 }
 
 // ------------------------------------
@@ -188,7 +218,7 @@ auto Lexer::token(const TokenKind kind, const LiteralValue& value) -> Token {
 // ------------------------------------
 
 void Lexer::skipUntilLineEnd() {
-    m_input.advanceWhileNot(&Character::isFileOrLineEnd);
+    m_input.advanceTo(scan::lineEnd(m_input.data()));
 }
 
 void Lexer::skipMultilineComment() {
@@ -197,51 +227,40 @@ void Lexer::skipMultilineComment() {
     assert(m_input.peek(1) == '\'');
     m_input.advance(2);
 
+    // jump between comment markers, only they can change the nesting level
     int level = 1;
-    m_input.advanceWhile([&](const auto ch) {
-        switch (ch) {
-        case '\0':
-            return false;
-        case '\'':
-            if (m_input.peek() == '/') {
-                m_input.advance();
-                --level;
-                if (level == 0) {
-                    m_input.advance();
-                    return false;
-                }
-            }
-            return true;
-        case '/':
-            if (m_input.peek() == '\'') {
-                m_input.advance();
-                ++level;
+    while (true) {
+        m_input.advanceTo(scan::commentMarker(m_input.data()));
+        const auto ch = m_input.current();
+        if (ch == '\0') {
+            return;
+        }
+        if (ch == '\'' && m_input.peek() == '/') {
+            m_input.advance(2);
+            if (--level == 0) {
+                return;
             }
-            return true;
-        default:
-            return true;
+            continue;
         }
-    });
+        if (ch == '/' && m_input.peek() == '\'') {
+            m_input.advance(2);
+            ++level;
+            continue;
+        }
+        m_input.advance();
+    }
 }
 
 void Lexer::skipToNextLine() {
-    m_input.advanceWhile([&](const auto ch) {
-        switch (ch) {
-        case '\0':
-            return false;
-        case '\r':
-            m_input.advance();
-            if (m_input.current() == '\n') {
-                m_input.advance();
-            }
-            return false;
-        case '\n':
+    m_input.advanceTo(scan::lineEnd(m_input.data()));
+    if (m_input.current() == '\r') {
+        m_input.advance();
+        if (m_input.current() == '\n') {
             m_input.advance();
-            return false;
-        default:
-            return true;
         }
-    });
+    } else if (m_input.current() == '\n') {
+        m_input.advance();
+    }
 }
 
 // ------------------------------------
@@ -252,35 +271,37 @@ auto Lexer::identifier() -> DiagResult<Token> {
     // assume m_input[0] == '_' || m_input[0].isAlpha()
     assert(m_input.current().isIdentifierStartChar() && "Unexpected identifier start");
 
+    // hash the name as it is scanned, so interning it takes a single probe
+    m_hash = IdentifierTable::hash(IdentifierTable::kHashSeed, m_input.current());
     m_start = m_input;
     m_input.advance();
-    m_input.advanceWhile(&Character::isIdentifierChar);
-
-    // fetch string literal and uppercase it in-place
-    m_buffer.clear();
-    std::transform(m_start.data(), m_input.data(), std::back_inserter(m_buffer), [](const char ch) {
-        if (ch >= 'a' && ch <= 'z') {
-            return static_cast<char>(ch - ('a' - 'A'));
+    m_input.advanceWhile([&](const Character ch) {
+        if (ch.isIdentifierChar()) {
+            m_hash = IdentifierTable::hash(m_hash, ch);
+            return true;
         }
-        return ch;
+        return false;
     });
 
-    // Is a keyword?
-    if (const auto iter = kKeywords.find(m_buffer); iter != kKeywords.end()) {
-        switch (iter->second.value()) {
-        case TokenKind::True:
-            return token(TokenKind::BooleanLiteral, LiteralValue::from(true));
-        case TokenKind::False:
-            return token(TokenKind::BooleanLiteral, LiteralValue::from(false));
-        case TokenKind::Null:
-            return token(TokenKind::NullLiteral);
-        default:
-            return token(iter->second);
-        }
+    // Is a keyword? Matched against the source bytes in place.
+    switch (const auto kind = TokenKind::fromIdentifier(lexeme()); kind.value()) {
+    case TokenKind::Identifier:
+        break;
+    case TokenKind::True:
+        return token(TokenKind::BooleanLiteral, LiteralValue::from(true));
+    case TokenKind::False:
+        return token(TokenKind::BooleanLiteral, LiteralValue::from(false));
+    case TokenKind::Null:
+        return token(TokenKind::NullLiteral);
+    default:
+        return token(kind);
     }
 
-    // Is an identifier
-    return token(TokenKind::Identifier, LiteralValue::from(m_context.retain(m_buffer)));
+    // Is an identifier, the table is not shared with speculative lexers
+    if (m_speculative) {
+        return token(TokenKind::Identifier);
+    }
+    return token(TokenKind::Identifier, LiteralValue::from(m_context.getIdentifiers().intern(lexeme(), m_hash)));
 }
 
 auto Lexer::stringLiteral() -> DiagResult<Token> {
@@ -295,6 +316,8 @@ auto Lexer::stringLiteral() -> DiagResult<Token> {
     Cursor segment = m_input;
 
     while (true) {
+        // skip the plain run, stopping at a quote, backslash or invisible char
+        m_input.advanceTo(scan::stringMarker(m_input.data()));
         const auto ch = m_input.current();
         if (ch == '"') {
             break;
@@ -302,7 +325,7 @@ auto Lexer::stringLiteral() -> DiagResult<Token> {
         if (ch == '\\') {
             const auto esc = m_input.peek();
             if (esc.isFileOrLineEnd()) {
-                std::ignore = diag(diagnostics::unterminatedString(), range());
+                std::ignore = report(diagnostics::unterminatedString());
                 m_input.advance(); // consume the dangling backslash
                 break;
             }
@@ -313,11 +336,9 @@ auto Lexer::stringLiteral() -> DiagResult<Token> {
             segment = m_input;
             continue;
         }
-        if (!ch.isVisible()) {
-            std::ignore = diag(diagnostics::unterminatedString(), range());
-            break;
-        }
-        m_input.advance();
+        // any other stop is an invisible character
+        std::ignore = report(diagnostics::unterminatedString());
+        break;
     }
 
     llvm::StringRef str;
@@ -326,7 +347,7 @@ auto Lexer::stringLiteral() -> DiagResult<Token> {
     } else {
         const auto run = segment.stringTo(m_input);
         m_buffer.append(run.data(), run.size());
-        str = m_context.retain(m_buffer);
+        str = retain(m_buffer);
     }
 
     // an unterminated literal stops with no closing quote to consume
@@ -359,48 +380,134 @@ auto Lexer::escaped(const Character ch) -> char {
     case '"':
         return ch.getChar(); // these denote themselves
     default:
-        std::ignore = diag(diagnostics::invalidEscapeSequence(), range());
+        std::ignore = report(diagnostics::invalidEscapeSequence());
         return ch.getChar();
     }
 }
 
 auto Lexer::numberLiteral() -> DiagResult<Token> {
-    // TODO: Proper integral and FP number lexing
-
     // assume m_input[0] == '.' || m_input[0].isDigit()
     assert(m_input.current() == '.' || m_input.current().isDigit());
-    bool isFloat = m_input.current() == '.';
-
     m_start = m_input;
-    m_input.advance();
 
-    bool hasError = false;
-    m_input.advanceWhile([&](const auto& ch) {
-        if (ch.isDigit()) {
-            return true;
+    // whole and fractional digits fold into one mantissa in a single pass
+    number::Digits digits;
+    const char* ptr = number::accumulate(m_input.data(), m_end, digits);
+    std::int64_t exponent = 0;
+    bool isFloat = false;
+    if (*ptr == '.') {
+        isFloat = true;
+        const auto whole = digits.count;
+        ptr = number::accumulate(ptr + 1, m_end, digits); // NOLINT(*-pro-bounds-pointer-arithmetic)
+        exponent -= static_cast<std::int64_t>(digits.count - whole);
+    }
+
+    // NOLINTBEGIN(*-pro-bounds-pointer-arithmetic)
+    if (*ptr == 'E' || *ptr == 'e') {
+        isFloat = true;
+        ptr++;
+        const bool negative = *ptr == '-';
+        if (*ptr == '-' || *ptr == '+') {
+            ptr++;
         }
-        if (ch == '.') {
-            if (!isFloat) {
-                isFloat = true;
-                return true;
-            }
-            hasError = true;
-            return false;
+        if (*ptr < '0' || *ptr > '9') {
+            m_input.advanceTo(ptr);
+            return report(diagnostics::invalidNumber());
         }
-        if (ch.isIdentifierStartChar()) {
-            hasError = true;
+        // saturate far beyond the range of double, so the sum cannot overflow
+        constexpr std::int64_t maxPower = 100'000;
+        std::int64_t power = 0;
+        for (; *ptr >= '0' && *ptr <= '9'; ptr++) {
+            power = std::min(power * 10 + (*ptr - '0'), maxPower);
         }
-        return false;
-    });
+        exponent += negative ? -power : power;
+    }
+    // NOLINTEND(*-pro-bounds-pointer-arithmetic)
 
-    if (!hasError) {
-        if (isFloat) {
-            if (const auto value = number<double>()) {
-                return token(TokenKind::FloatLiteral, LiteralValue::from(*value));
-            }
-        } else if (const auto value = number<std::uint64_t>()) {
-            return token(TokenKind::IntegerLiteral, LiteralValue::from(*value));
+    const char* const numberEnd = ptr;
+    TRY_DECL(suffix, numberSuffix(ptr, isFloat, false))
+    isFloat = isFloat || suffix.isOneOf(TokenKind::Single, TokenKind::Double);
+
+    if (!isFloat) {
+        if (digits.dropped != 0) {
+            return report(diagnostics::invalidNumber());
+        }
+        return token(TokenKind::IntegerLiteral, LiteralValue::from(digits.value), suffix);
+    }
+
+    // exact mantissa and power of ten need a single rounding
+    if (digits.dropped == 0) {
+        if (const auto value = number::toDouble(digits.value, exponent)) {
+            return token(TokenKind::FloatLiteral, LiteralValue::from(*value), suffix);
         }
     }
-    return diag(diagnostics::invalidNumber(), range());
+
+    // otherwise fall back to correctly rounded conversion of the spelling
+    double value = 0;
+    const auto [end, ec] = std::from_chars(m_start.data(), numberEnd, value);
+    if (ec != std::errc {} || end != numberEnd) { // NOLINT(*-invalid-enum-default-initialization)
+        return report(diagnostics::invalidNumber());
+    }
+    return token(TokenKind::FloatLiteral, LiteralValue::from(value), suffix);
+}
+
+auto Lexer::radixLiteral() -> DiagResult<Token> {
+    // assume m_input[0] == '&'
+    assert(m_input.current() == '&');
+    m_start = m_input;
+
+    unsigned shift = 0;
+    switch (m_input.peek().getChar()) {
+    case 'H':
+    case 'h':
+        shift = 4;
+        break;
+    case 'O':
+    case 'o':
+        shift = 3;
+        break;
+    case 'B':
+    case 'b':
+        shift = 1;
+        break;
+    default:
+        std::unreachable();
+    }
+    m_input.advance(2);
+
+    // every digit is a whole number of bits, so overflow shows in the top bits
+    const unsigned radix = 1U << shift;
+    const char* ptr = m_input.data();
+    const char* const first = ptr;
+    std::uint64_t value = 0;
+    bool overflow = false;
+    for (auto digit = number::digitValue(*ptr); digit < radix; digit = number::digitValue(*ptr)) {
+        overflow = overflow || (value >> (64U - shift)) != 0;
+        value = (value << shift) | digit;
+        ptr++; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+    if (ptr == first || overflow) {
+        m_input.advanceTo(ptr);
+        return report(diagnostics::invalidNumber());
+    }
+
+    TRY_DECL(suffix, numberSuffix(ptr, false, true))
+    return token(TokenKind::IntegerLiteral, LiteralValue::from(value), suffix);
+}
+
+auto Lexer::numberSuffix(const char* ptr, const bool isFloat, const bool isRadix) -> DiagResult<TokenKind> {
+    const auto suffix = number::typeSuffix(ptr);
+    m_input.advanceTo(ptr + suffix.length); // NOLINT(*-pro-bounds-pointer-arithmetic)
+
+    const bool floatSuffix = suffix.type.isOneOf(TokenKind::Single, TokenKind::Double);
+    if (isFloat && suffix.type != TokenKind::Invalid && !floatSuffix) {
+        return report(diagnostics::invalidNumber());
+    }
+    if (isRadix && floatSuffix) {
+        return report(diagnostics::invalidNumber());
+    }
+    if (m_input.current().isIdentifierChar() || m_input.current() == '.') {
+        return report(diagnostics::invalidNumber());
+    }
+    return suffix.type;
 }
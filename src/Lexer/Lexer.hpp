@@ -3,6 +3,7 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <llvm/Support/StringSaver.h>
 #include "Cursor.hpp"
 #include "Diag/LogProvider.hpp"
 #include "Token.hpp"
@@ -45,7 +46,58 @@ public:
         return m_start.rangeTo(m_input);
     }
 
+    // -------------------------------------------------------------------------
+    // Chunked lexing
+    // -------------------------------------------------------------------------
+
+    /**
+     * Continue lexing from @p start, a line start or a position reached by an
+     * earlier restricted lexer, with the given statement state. Once trivia or
+     * a token carries the cursor to or past @p limit, next() returns EndOfFile
+     * and leaves the state for the next chunk to pick up.
+     */
+    void restrict(const char* start, const char* limit, bool hasStatement);
+
+    /**
+     * In speculative mode the lexer does not touch shared state: diagnostics
+     * are not logged but flag the speculation as failed, identifiers are not
+     * interned (their hash is available from getIdentifierHash()), and decoded
+     * strings are kept in lexer-owned storage. Used to lex chunks on worker
+     * threads.
+     */
+    void setSpeculative(const bool speculative) { m_speculative = speculative; }
+
+    /**
+     * Check whether a speculative lexer hit something that needs a diagnostic.
+     */
+    [[nodiscard]] auto isSpeculationFailed() const -> bool { return m_speculationFailed; }
+
+    /**
+     * Return the current position in the source buffer.
+     */
+    [[nodiscard]] auto getPosition() const -> const char* { return m_input.data(); }
+
+    /**
+     * Check whether a statement has been started that still awaits its EndOfStmt.
+     */
+    [[nodiscard]] auto hasStatement() const -> bool { return m_hasStatement; }
+
+    /**
+     * Case-folded hash of the last scanned identifier.
+     */
+    [[nodiscard]] auto getIdentifierHash() const -> std::uint64_t { return m_hash; }
+
 private:
+    /**
+     * Log a diagnostic at the current range, or flag a failed speculation.
+     */
+    [[nodiscard]] auto report(const DiagMessage& message) -> DiagError;
+
+    /**
+     * Intern a decoded string, in lexer storage when speculative.
+     */
+    [[nodiscard]] auto retain(llvm::StringRef string) -> llvm::StringRef;
+
     /**
      * Log an "invalid input" diagnostic at the current position.
      */
@@ -67,9 +119,9 @@ private:
     [[nodiscard]] auto make(TokenKind kind, std::size_t len = 1) -> Token;
 
     /**
-     * Create a token with an associated literal value.
+     * Create a token with an associated literal value and type suffix.
      */
-    [[nodiscard]] auto token(TokenKind kind, const LiteralValue& value = {}) -> Token;
+    [[nodiscard]] auto token(TokenKind kind, const LiteralValue& value = {}, TokenKind typeSuffix = TokenKind::Invalid) -> Token;
 
     /**
      * Skip characters until a line ending or end of file.
@@ -104,35 +156,43 @@ private:
     [[nodiscard]] auto escaped(Character ch) -> char;
 
     /**
-     * Lex an integer or floating-point number literal.
+     * Lex a decimal integer or floating-point number literal with an optional
+     * fraction, exponent and type suffix.
      */
     [[nodiscard]] auto numberLiteral() -> DiagResult<Token>;
 
     /**
-     * Return the source text from m_start to m_input.
+     * Lex an integer literal in base 16, 8 or 2 (&H, &O or &B) with an
+     * optional integral type suffix.
      */
-    [[nodiscard]] auto lexeme() const -> llvm::StringRef {
-        return m_start.stringTo(m_input);
-    }
+    [[nodiscard]] auto radixLiteral() -> DiagResult<Token>;
+
+    /**
+     * Consume the type suffix of a number literal ending at ptr and finish
+     * the token. Reports an invalid number if the suffix does not suit the
+     * literal or the literal runs into an identifier or another dot.
+     */
+    [[nodiscard]] auto numberSuffix(const char* ptr, bool isFloat, bool isRadix) -> DiagResult<TokenKind>;
 
     /**
-     * Parse the lexeme between m_start and m_input as a number.
+     * Return the source text from m_start to m_input.
      */
-    template<typename T>
-        requires std::is_arithmetic_v<T>
-    [[nodiscard]] auto number() const -> std::optional<T> {
-        T value;
-        if (std::from_chars(m_start.data(), m_input.data(), value).ec == std::errc {}) { // NOLINT(*-invalid-enum-default-initialization)
-            return { value };
-        }
-        return std::nullopt;
+    [[nodiscard]] auto lexeme() const -> llvm::StringRef {
+        return m_start.stringTo(m_input);
     }
 
     Context& m_context;
     unsigned m_id;
     Cursor m_start, m_input;
+    const char* m_limit;
+    const char* m_end;
     bool m_hasStatement;
+    bool m_speculative = false;
+    bool m_speculationFailed = false;
+    std::uint64_t m_hash = 0;
     std::string m_buffer;
+    llvm::BumpPtrAllocator m_scratchAllocator;
+    llvm::StringSaver m_scratch { m_scratchAllocator };
 };
 
 } // namespace lbc
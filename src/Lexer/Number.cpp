@@ -0,0 +1,124 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "Number.hpp"
+#include <llvm/Support/Endian.h>
+using namespace lbc;
+
+namespace {
+
+/// Powers of ten that are exactly representable as a double
+constexpr std::array<double, 23> kPowersOfTen {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Largest integer below which every integer is exactly representable as a double
+constexpr std::uint64_t kMaxExactMantissa = 1ULL << 53U;
+
+constexpr auto isLong(const char ch) -> bool {
+    return ch == 'L' || ch == 'l';
+}
+
+} // namespace
+
+auto number::accumulate(const char* ptr, const char* end, Digits& digits) -> const char* {
+    constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    constexpr std::uint64_t blockScale = 100'000'000;
+    constexpr std::size_t blockSize = 8;
+
+    while (digits.dropped == 0 && end - ptr >= static_cast<std::ptrdiff_t>(blockSize)) {
+        const auto block = llvm::support::endian::read64le(ptr);
+        if (!isEightDigits(block)) {
+            break;
+        }
+        const auto chunk = parseEightDigits(block);
+        if (digits.value > (max - chunk) / blockScale) {
+            break;
+        }
+        digits.value = digits.value * blockScale + chunk;
+        digits.count += blockSize;
+        ptr += blockSize; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+
+    while (*ptr >= '0' && *ptr <= '9') {
+        const auto digit = static_cast<std::uint64_t>(*ptr - '0');
+        if (digits.dropped == 0 && digits.value <= (max - digit) / 10) {
+            digits.value = digits.value * 10 + digit;
+            digits.count++;
+        } else {
+            digits.dropped++;
+        }
+        ptr++; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+    return ptr;
+}
+
+auto number::toDouble(const std::uint64_t mantissa, const std::int64_t exponent) -> std::optional<double> {
+    constexpr auto maxExponent = static_cast<std::int64_t>(kPowersOfTen.size() - 1);
+    if (mantissa > kMaxExactMantissa || exponent < -maxExponent || exponent > maxExponent) {
+        return std::nullopt;
+    }
+    const auto value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        return value / kPowersOfTen.at(static_cast<std::size_t>(-exponent));
+    }
+    return value * kPowersOfTen.at(static_cast<std::size_t>(exponent));
+}
+
+auto number::typeSuffix(const char* ptr) -> Suffix {
+    // NOLINTBEGIN(*-pro-bounds-pointer-arithmetic)
+    switch (ptr[0]) {
+    case '%':
+        return { .type = TokenKind::Integer, .length = 1 };
+    case 'U':
+    case 'u':
+        if (isLong(ptr[1])) {
+            if (isLong(ptr[2])) {
+                return { .type = TokenKind::ULongInt, .length = 3 };
+            }
+            return { .type = TokenKind::ULong, .length = 2 };
+        }
+        return { .type = TokenKind::UInteger, .length = 1 };
+    case 'L':
+    case 'l':
+        if (isLong(ptr[1])) {
+            return { .type = TokenKind::LongInt, .length = 2 };
+        }
+        return { .type = TokenKind::Long, .length = 1 };
+    case '!':
+    case 'F':
+    case 'f':
+        return { .type = TokenKind::Single, .length = 1 };
+    case '#':
+    case 'D':
+    case 'd':
+        return { .type = TokenKind::Double, .length = 1 };
+    default:
+        return { .type = TokenKind::Invalid, .length = 0 };
+    }
+    // NOLINTEND(*-pro-bounds-pointer-arithmetic)
+}
+
+auto number::suffixSpelling(const TokenKind type) -> llvm::StringRef {
+    switch (type.value()) {
+    case TokenKind::Integer:
+        return "%";
+    case TokenKind::UInteger:
+        return "U";
+    case TokenKind::Long:
+        return "L";
+    case TokenKind::ULong:
+        return "UL";
+    case TokenKind::LongInt:
+        return "LL";
+    case TokenKind::ULongInt:
+        return "ULL";
+    case TokenKind::Single:
+        return "F";
+    case TokenKind::Double:
+        return "D";
+    default:
+        return "";
+    }
+}
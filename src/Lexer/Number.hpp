@@ -0,0 +1,110 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include "TokenKind.hpp"
+namespace lbc::number {
+
+/**
+ * Building blocks of the numeric literal scanner. Digits are read straight
+ * from the null-terminated source buffer and folded into a 64-bit value in a
+ * single pass, eight decimal digits at a time where the buffer allows, so a
+ * literal is never rescanned to compute its value.
+ */
+
+/**
+ * Decimal digits folded into a value. Once a digit no longer fits, it and
+ * every digit after it are dropped and only counted.
+ */
+struct Digits final {
+    std::uint64_t value = 0; ///< accumulated digits
+    std::size_t count = 0;   ///< digits folded into value
+    std::size_t dropped = 0; ///< digits that did not fit
+};
+
+/**
+ * A type suffix recognised after a literal.
+ */
+struct Suffix final {
+    TokenKind type;     ///< type keyword the suffix stands for, Invalid if none
+    std::size_t length; ///< number of characters taken by the suffix
+};
+
+/**
+ * Check whether all eight bytes of a little-endian block are ASCII digits.
+ */
+[[nodiscard]] constexpr auto isEightDigits(const std::uint64_t block) -> bool {
+    return ((block & 0xF0F0'F0F0'F0F0'F0F0ULL)
+               | (((block + 0x0606'0606'0606'0606ULL) & 0xF0F0'F0F0'F0F0'F0F0ULL) >> 4U))
+        == 0x3333'3333'3333'3333ULL;
+}
+
+/**
+ * Convert eight ASCII digits held in a little-endian block, the first digit
+ * in the lowest byte, in three multiplications.
+ */
+[[nodiscard]] constexpr auto parseEightDigits(std::uint64_t block) -> std::uint32_t {
+    constexpr std::uint64_t mask = 0x0000'00FF'0000'00FFULL;
+    constexpr std::uint64_t mul1 = 0x000F'4240'0000'0064ULL; // 100 + (1000000 << 32)
+    constexpr std::uint64_t mul2 = 0x0000'2710'0000'0001ULL; // 1 + (10000 << 32)
+    block -= 0x3030'3030'3030'3030ULL;
+    block = (block * 10) + (block >> 8U);
+    block = (((block & mask) * mul1) + (((block >> 16U) & mask) * mul2)) >> 32U;
+    return static_cast<std::uint32_t>(block);
+}
+
+/**
+ * Value of ch as a digit in bases up to 16, or 16 if it is not one.
+ */
+[[nodiscard]] constexpr auto digitValue(const char ch) -> unsigned {
+    if (ch >= '0' && ch <= '9') {
+        return static_cast<unsigned>(ch - '0');
+    }
+    const auto upper = static_cast<unsigned>(static_cast<unsigned char>(ch)) & 0xDFU;
+    if (upper >= 'A' && upper <= 'F') {
+        return upper - 'A' + 10;
+    }
+    return 16; // NOLINT(*-magic-numbers)
+}
+
+/**
+ * Fold a run of decimal digits starting at ptr into digits. Blocks of eight
+ * are converted at once while at least eight bytes remain before end.
+ *
+ * @param ptr first byte to scan
+ * @param end end of the source buffer, loads never reach past it
+ * @param digits accumulator to fold the run into
+ * @return one past the last digit
+ */
+[[nodiscard]] auto accumulate(const char* ptr, const char* end, Digits& digits) -> const char*;
+
+/**
+ * Compute mantissa * 10^exponent exactly, if both operands are exactly
+ * representable as doubles so that a single rounding gives the correctly
+ * rounded result. Returns nullopt otherwise.
+ */
+[[nodiscard]] auto toDouble(std::uint64_t mantissa, std::int64_t exponent) -> std::optional<double>;
+
+/**
+ * Recognise a type suffix at ptr. Letters match in any case.
+ *
+ * | Suffix     | Type     |
+ * |------------|----------|
+ * | %          | INTEGER  |
+ * | U          | UINTEGER |
+ * | L          | LONG     |
+ * | UL         | ULONG    |
+ * | LL         | LONGINT  |
+ * | ULL        | ULONGINT |
+ * | F or !     | SINGLE   |
+ * | D or #     | DOUBLE   |
+ */
+[[nodiscard]] auto typeSuffix(const char* ptr) -> Suffix;
+
+/**
+ * Spelling of the suffix for the given type, empty if it has none.
+ */
+[[nodiscard]] auto suffixSpelling(TokenKind type) -> llvm::StringRef;
+
+} // namespace lbc::number
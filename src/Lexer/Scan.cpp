@@ -0,0 +1,348 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "Scan.hpp"
+#include <bit>
+#include <llvm/Support/Compiler.h>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(__AVX2__) || defined(__GNUC__)
+#define LBC_SCAN_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LBC_SCAN_SSE2 1
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LBC_SCAN_NEON 1
+#endif
+
+// GCC and Clang build the AVX2 scanner for AVX2 whatever the target flags,
+// it only runs once the CPU is known to have it. Other compilers need it on.
+#if defined(__GNUC__) && !defined(__AVX2__)
+#define LBC_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LBC_SCAN_TARGET_AVX2
+#endif
+
+// Functions reading whole blocks, see scanVector() for why that is safe,
+// are not instrumented by AddressSanitizer, which checks every load against
+// the bounds of the allocation.
+#if defined(__GNUC__)
+#define LBC_SCAN_NO_SANITIZE __attribute__((no_sanitize("address")))
+#elif defined(_MSC_VER)
+#define LBC_SCAN_NO_SANITIZE __declspec(no_sanitize_address)
+#else
+#define LBC_SCAN_NO_SANITIZE
+#endif
+using namespace lbc;
+
+namespace {
+
+/**
+ * The sets of bytes that terminate each kind of trivia run.
+ */
+enum class Stop : std::uint8_t {
+    WhiteSpace, ///< anything but ' ' and '\t'
+    LineEnd,    ///< '\0', '\r', '\n'
+    Comment,    ///< '\0', '\'', '/'
+    String      ///< '"', '\\', or any byte below ' '
+};
+
+/**
+ * Scalar predicate mirroring the Character classification the lexer uses,
+ * including the platform signedness of char for invisible bytes.
+ */
+template<Stop S>
+constexpr auto stops(const char ch) -> bool {
+    if constexpr (S == Stop::WhiteSpace) {
+        return ch != ' ' && ch != '\t';
+    } else if constexpr (S == Stop::LineEnd) {
+        return ch == '\0' || ch == '\r' || ch == '\n';
+    } else if constexpr (S == Stop::Comment) {
+        return ch == '\0' || ch == '\'' || ch == '/';
+    } else {
+        return ch == '"' || ch == '\\' || ch < ' ';
+    }
+}
+
+template<Stop S>
+auto scanScalar(const char* ptr) -> const char* {
+    while (!stops<S>(*ptr)) {
+        ++ptr; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+    return ptr;
+}
+
+#if LBC_SCAN_AVX2
+
+/**
+ * 32 byte blocks, one mask bit per byte. Built for AVX2 on its own, see
+ * LBC_SCAN_TARGET_AVX2, so it is only used if the CPU supports it.
+ */
+struct Avx2 final {
+    static constexpr std::size_t kWidth = 32;
+    static constexpr unsigned kBitsPerByte = 1;
+    static constexpr llvm::StringRef kName = "avx2";
+    using Mask = std::uint32_t;
+
+    template<Stop S>
+    LBC_SCAN_NO_SANITIZE LBC_SCAN_TARGET_AVX2 static auto match(const char* block) -> Mask {
+        const auto data = _mm256_load_si256(reinterpret_cast<const __m256i*>(block)); // NOLINT(*-reinterpret-cast)
+        const auto eq = [&](const char ch) LBC_SCAN_TARGET_AVX2 { return _mm256_cmpeq_epi8(data, _mm256_set1_epi8(ch)); };
+        const auto bits = [](const __m256i vec) LBC_SCAN_TARGET_AVX2 { return static_cast<Mask>(_mm256_movemask_epi8(vec)); };
+        if constexpr (S == Stop::WhiteSpace) {
+            return ~bits(_mm256_or_si256(eq(' '), eq('\t')));
+        } else if constexpr (S == Stop::LineEnd) {
+            return bits(_mm256_or_si256(_mm256_or_si256(eq('\0'), eq('\r')), eq('\n')));
+        } else if constexpr (S == Stop::Comment) {
+            return bits(_mm256_or_si256(_mm256_or_si256(eq('\0'), eq('\'')), eq('/')));
+        } else {
+            __m256i invisible;
+            if constexpr (std::is_signed_v<char>) {
+                invisible = _mm256_cmpgt_epi8(_mm256_set1_epi8(' '), data);
+            } else {
+                const auto high = _mm256_and_si256(data, _mm256_set1_epi8(static_cast<char>(0xE0)));
+                invisible = _mm256_cmpeq_epi8(high, _mm256_setzero_si256());
+            }
+            return bits(_mm256_or_si256(_mm256_or_si256(eq('"'), eq('\\')), invisible));
+        }
+    }
+};
+
+#endif
+
+#if LBC_SCAN_SSE2
+
+/**
+ * 16 byte blocks, one mask bit per byte.
+ */
+struct Sse2 final {
+    static constexpr std::size_t kWidth = 16;
+    static constexpr unsigned kBitsPerByte = 1;
+    static constexpr llvm::StringRef kName = "sse2";
+    using Mask = std::uint32_t;
+
+    template<Stop S>
+    LBC_SCAN_NO_SANITIZE static auto match(const char* block) -> Mask {
+        const auto data = _mm_load_si128(reinterpret_cast<const __m128i*>(block)); // NOLINT(*-reinterpret-cast)
+        const auto eq = [&](const char ch) { return _mm_cmpeq_epi8(data, _mm_set1_epi8(ch)); };
+        const auto bits = [](const __m128i vec) { return static_cast<Mask>(_mm_movemask_epi8(vec)); };
+        if constexpr (S == Stop::WhiteSpace) {
+            return ~bits(_mm_or_si128(eq(' '), eq('\t'))) & 0xFFFFU;
+        } else if constexpr (S == Stop::LineEnd) {
+            return bits(_mm_or_si128(_mm_or_si128(eq('\0'), eq('\r')), eq('\n')));
+        } else if constexpr (S == Stop::Comment) {
+            return bits(_mm_or_si128(_mm_or_si128(eq('\0'), eq('\'')), eq('/')));
+        } else {
+            __m128i invisible;
+            if constexpr (std::is_signed_v<char>) {
+                invisible = _mm_cmplt_epi8(data, _mm_set1_epi8(' '));
+            } else {
+                const auto high = _mm_and_si128(data, _mm_set1_epi8(static_cast<char>(0xE0)));
+                invisible = _mm_cmpeq_epi8(high, _mm_setzero_si128());
+            }
+            return bits(_mm_or_si128(_mm_or_si128(eq('"'), eq('\\')), invisible));
+        }
+    }
+};
+
+#elif LBC_SCAN_NEON
+
+/**
+ * 16 byte blocks. NEON has no movemask, so the comparison result is narrowed
+ * into a 64-bit mask holding four bits per byte.
+ */
+struct Neon final {
+    static constexpr std::size_t kWidth = 16;
+    static constexpr unsigned kBitsPerByte = 4;
+    static constexpr llvm::StringRef kName = "neon";
+    using Mask = std::uint64_t;
+
+    template<Stop S>
+    LBC_SCAN_NO_SANITIZE static auto match(const char* block) -> Mask {
+        const auto data = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block)); // NOLINT(*-reinterpret-cast)
+        const auto eq = [&](const char ch) { return vceqq_u8(data, vdupq_n_u8(static_cast<std::uint8_t>(ch))); };
+        const auto bits = [](const uint8x16_t vec) {
+            const auto narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vec), 4);
+            return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        };
+        if constexpr (S == Stop::WhiteSpace) {
+            return ~bits(vorrq_u8(eq(' '), eq('\t')));
+        } else if constexpr (S == Stop::LineEnd) {
+            return bits(vorrq_u8(vorrq_u8(eq('\0'), eq('\r')), eq('\n')));
+        } else if constexpr (S == Stop::Comment) {
+            return bits(vorrq_u8(vorrq_u8(eq('\0'), eq('\'')), eq('/')));
+        } else {
+            uint8x16_t invisible;
+            if constexpr (std::is_signed_v<char>) {
+                invisible = vcltq_s8(vreinterpretq_s8_u8(data), vdupq_n_s8(' '));
+            } else {
+                invisible = vcltq_u8(data, vdupq_n_u8(' '));
+            }
+            return bits(vorrq_u8(vorrq_u8(eq('"'), eq('\\')), invisible));
+        }
+    }
+};
+
+#endif
+
+/**
+ * Scan block by block. The first load is rounded down to the block boundary
+ * and the bytes before ptr are shifted out of the mask. Every stop set contains
+ * the null terminator, so the loop ends in the block that holds it. Inlined
+ * into the entry point of its instruction set, see scanAvx2().
+ *
+ * Blocks are aligned to their width, which divides the page size, so a block
+ * never spans two pages. The first block holds ptr and the last one holds the
+ * terminator, so each is in a mapped page even where it reaches before the
+ * buffer or past its end, and the load cannot fault. The bytes outside the
+ * buffer never decide the result: those before ptr are shifted out, and those
+ * after the terminator follow a stop. Sanitizers checking loads against the
+ * allocation still see them, so these functions are not instrumented, see
+ * LBC_SCAN_NO_SANITIZE. Valgrind accepts such aligned loads as long as its
+ * --partial-loads-ok is left on, its default.
+ */
+template<typename Isa, Stop S>
+LBC_SCAN_NO_SANITIZE LLVM_ATTRIBUTE_ALWAYS_INLINE auto scanVector(const char* ptr) -> const char* {
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr); // NOLINT(*-reinterpret-cast)
+    const auto offset = address & (Isa::kWidth - 1);
+    const char* block = ptr - offset; // NOLINT(*-pro-bounds-pointer-arithmetic)
+
+    auto mask = Isa::template match<S>(block) >> (offset * Isa::kBitsPerByte);
+    if (mask != 0) {
+        return ptr + static_cast<unsigned>(std::countr_zero(mask)) / Isa::kBitsPerByte; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+
+    while (true) {
+        block += Isa::kWidth; // NOLINT(*-pro-bounds-pointer-arithmetic)
+        mask = Isa::template match<S>(block);
+        if (mask != 0) {
+            return block + static_cast<unsigned>(std::countr_zero(mask)) / Isa::kBitsPerByte; // NOLINT(*-pro-bounds-pointer-arithmetic)
+        }
+    }
+}
+
+#if LBC_SCAN_AVX2
+
+template<Stop S>
+LBC_SCAN_NO_SANITIZE LBC_SCAN_TARGET_AVX2 auto scanAvx2(const char* ptr) -> const char* {
+    return scanVector<Avx2, S>(ptr);
+}
+
+/**
+ * Whether the CPU running the compiler has AVX2, and the OS saves its registers.
+ */
+auto hasAvx2() -> bool {
+#if defined(__AVX2__)
+    return true;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+/**
+ * Scanner every CPU of the target has: SSE2 on x86-64, NEON on ARM, and a
+ * scalar loop elsewhere.
+ */
+template<Stop S>
+LBC_SCAN_NO_SANITIZE auto scanBaseline(const char* ptr) -> const char* {
+#if LBC_SCAN_SSE2
+    return scanVector<Sse2, S>(ptr);
+#elif LBC_SCAN_NEON
+    return scanVector<Neon, S>(ptr);
+#else
+    return scanScalar<S>(ptr);
+#endif
+}
+
+/**
+ * The scanners of one instruction set.
+ */
+struct Scanners final {
+    llvm::StringRef isa;                           ///< instruction set name
+    const char* (*whiteSpaceEnd)(const char* ptr); ///< Stop::WhiteSpace
+    const char* (*lineEnd)(const char* ptr);       ///< Stop::LineEnd
+    const char* (*commentMarker)(const char* ptr); ///< Stop::Comment
+    const char* (*stringMarker)(const char* ptr);  ///< Stop::String
+};
+
+/**
+ * The best scanners the CPU supports.
+ */
+auto select() -> Scanners {
+#if LBC_SCAN_AVX2
+    if (hasAvx2()) {
+        return {
+            Avx2::kName,
+            &scanAvx2<Stop::WhiteSpace>,
+            &scanAvx2<Stop::LineEnd>,
+            &scanAvx2<Stop::Comment>,
+            &scanAvx2<Stop::String>,
+        };
+    }
+#endif
+#if LBC_SCAN_SSE2
+    constexpr auto name = Sse2::kName;
+#elif LBC_SCAN_NEON
+    constexpr auto name = Neon::kName;
+#else
+    constexpr llvm::StringRef name = "scalar";
+#endif
+    return {
+        name,
+        &scanBaseline<Stop::WhiteSpace>,
+        &scanBaseline<Stop::LineEnd>,
+        &scanBaseline<Stop::Comment>,
+        &scanBaseline<Stop::String>,
+    };
+}
+
+/**
+ * Get the scanners, selected once on first use.
+ */
+auto scanners() -> const Scanners& {
+    static const Scanners selected = select();
+    return selected;
+}
+
+} // namespace
+
+auto scan::whiteSpaceEnd(const char* ptr) -> const char* {
+    return scanners().whiteSpaceEnd(ptr);
+}
+
+auto scan::lineEnd(const char* ptr) -> const char* {
+    return scanners().lineEnd(ptr);
+}
+
+auto scan::commentMarker(const char* ptr) -> const char* {
+    return scanners().commentMarker(ptr);
+}
+
+auto scan::stringMarker(const char* ptr) -> const char* {
+    return scanners().stringMarker(ptr);
+}
+
+auto scan::isa() -> llvm::StringRef {
+    return scanners().isa;
+}
+
+auto scan::scalar::whiteSpaceEnd(const char* ptr) -> const char* {
+    return scanScalar<Stop::WhiteSpace>(ptr);
+}
+
+auto scan::scalar::lineEnd(const char* ptr) -> const char* {
+    return scanScalar<Stop::LineEnd>(ptr);
+}
+
+auto scan::scalar::commentMarker(const char* ptr) -> const char* {
+    return scanScalar<Stop::Comment>(ptr);
+}
+
+auto scan::scalar::stringMarker(const char* ptr) -> const char* {
+    return scanScalar<Stop::String>(ptr);
+}
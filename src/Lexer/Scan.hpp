@@ -0,0 +1,61 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+namespace lbc::scan {
+
+/**
+ * Vectorised scanners for the runs of trivia the lexer skips over: whitespace,
+ * comment bodies and string literal bodies. Each function takes a pointer into
+ * a null-terminated source buffer and returns a pointer to the first byte that
+ * ends the run. The null terminator always ends a run, so a scan never walks
+ * past the end of the buffer.
+ *
+ * The implementation is picked once, on first use: AVX2 when the CPU has it,
+ * otherwise SSE2 on x86-64, NEON on ARM, and a scalar loop elsewhere. The AVX2
+ * scanner is built for x86 whatever the target flags, so a default build uses
+ * it too. Vector loads are aligned to the register width, so reading the block
+ * that holds the terminator never crosses into an unmapped page.
+ */
+
+/**
+ * Return the first byte that is not a space or a tab.
+ */
+[[nodiscard]] auto whiteSpaceEnd(const char* ptr) -> const char*;
+
+/**
+ * Return the first line ending ('\r' or '\n') or the null terminator.
+ */
+[[nodiscard]] auto lineEnd(const char* ptr) -> const char*;
+
+/**
+ * Return the first byte that may open or close a nested comment ('\'' or '/'),
+ * or the null terminator.
+ */
+[[nodiscard]] auto commentMarker(const char* ptr) -> const char*;
+
+/**
+ * Return the first byte that needs attention inside a string literal: the
+ * closing quote, a backslash, or an invisible character (which includes line
+ * endings and the null terminator).
+ */
+[[nodiscard]] auto stringMarker(const char* ptr) -> const char*;
+
+/**
+ * Name of the instruction set the scanners run on.
+ */
+[[nodiscard]] auto isa() -> llvm::StringRef;
+
+/**
+ * Reference implementations, one byte at a time. Always available, so the
+ * vectorised paths can be checked against them.
+ */
+namespace scalar {
+[[nodiscard]] auto whiteSpaceEnd(const char* ptr) -> const char*;
+[[nodiscard]] auto lineEnd(const char* ptr) -> const char*;
+[[nodiscard]] auto commentMarker(const char* ptr) -> const char*;
+[[nodiscard]] auto stringMarker(const char* ptr) -> const char*;
+} // namespace scalar
+
+} // namespace lbc::scan
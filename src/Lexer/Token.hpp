@@ -12,15 +12,21 @@ class Token final {
 public:
     /** Default-construct an Invalid sentinel token. */
     constexpr Token()
-    : m_kind(TokenKind::Value::Invalid) {}
+    : m_kind(TokenKind::Value::Invalid)
+    , m_typeSuffix(TokenKind::Value::Invalid) {}
 
-    /** Construct a token with a kind, source range, and optional literal value. */
+    /**
+     * Construct a token with a kind, source range, optional literal value,
+     * and the type keyword named by a numeric literal's type suffix.
+     */
     constexpr Token(
         const TokenKind kind,
         const llvm::SMRange range,
-        const LiteralValue& value = {}
+        const LiteralValue& value = {},
+        const TokenKind typeSuffix = TokenKind::Invalid
     )
     : m_kind(kind)
+    , m_typeSuffix(typeSuffix)
     , m_range(range)
     , m_value(value) {
         assert(range.Start.isValid() && range.End.isValid() && "Token should be created from a valid range");
@@ -46,6 +52,12 @@ public:
      */
     [[nodiscard]] constexpr auto getValue() const -> LiteralValue { return m_value; }
 
+    /**
+     * Return the type given by a numeric literal's suffix, such as ULongInt
+     * for 10ULL, or Invalid when the literal has no suffix.
+     */
+    [[nodiscard]] constexpr auto getTypeSuffix() const -> TokenKind { return m_typeSuffix; }
+
     /**
      * Return a display string for this token. For identifiers and string
      * literals returns the stored value; for numbers returns the raw
@@ -60,6 +72,7 @@ public:
 
 private:
     TokenKind m_kind;
+    TokenKind m_typeSuffix;
     llvm::SMRange m_range;
     LiteralValue m_value;
 };
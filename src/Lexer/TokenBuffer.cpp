@@ -0,0 +1,208 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "TokenBuffer.hpp"
+#include <cstring>
+#include <llvm/Support/Parallel.h>
+#include "Driver/Context.hpp"
+using namespace lbc;
+
+/**
+ * Tokens lexed speculatively from one line-aligned slice of the source.
+ */
+struct TokenBuffer::Chunk final {
+    const char* begin = nullptr;          ///< first byte, always at a line start
+    const char* end = nullptr;            ///< one past the last byte, at a line start or the terminator
+    std::unique_ptr<Lexer> lexer {};      ///< owns decoded strings until the chunk is stitched
+    std::vector<Token> tokens {};         ///< tokens, without the closing EndOfFile
+    std::vector<std::uint64_t> hashes {}; ///< identifier hashes, one per Identifier token
+    Token last {};                        ///< the EndOfFile that stopped the lexer
+    const char* stop = nullptr;           ///< where the lexer stopped, past end if it overran
+    bool hasStatement = false;            ///< statement state where the lexer stopped
+};
+
+TokenBuffer::TokenBuffer(Context& context, const unsigned id)
+: m_lexer(context, id)
+, m_base(context.getSourceMgr().getMemoryBuffer(id)->getBufferStart()) {
+    assert(context.getSourceMgr().getMemoryBuffer(id)->getBufferSize() <= std::numeric_limits<std::uint32_t>::max() && "Source buffer too large for 32-bit token offsets");
+}
+
+void TokenBuffer::fill() {
+    if (m_kinds.empty()) {
+        const auto size = static_cast<std::size_t>(m_lexer.getContext().getSourceMgr().getMemoryBuffer(m_lexer.getId())->getBufferSize());
+        if (size >= kParallelThreshold) {
+            fillParallel();
+            return;
+        }
+    }
+    while (!m_complete) {
+        scan();
+    }
+}
+
+void TokenBuffer::fillParallel() {
+    auto& context = getContext();
+    const auto* source = context.getSourceMgr().getMemoryBuffer(m_lexer.getId());
+    const char* const terminator = source->getBufferEnd();
+
+    // split at line starts
+    std::vector<Chunk> chunks;
+    for (const char* begin = m_base; begin < terminator;) {
+        const auto remaining = static_cast<std::size_t>(terminator - begin);
+        const char* end = terminator;
+        if (remaining > kChunkSize) {
+            const auto* newline = static_cast<const char*>(std::memchr(begin + kChunkSize, '\n', remaining - kChunkSize)); // NOLINT(*-pro-bounds-pointer-arithmetic)
+            if (newline != nullptr) {
+                end = newline + 1; // NOLINT(*-pro-bounds-pointer-arithmetic)
+            }
+        }
+        chunks.push_back(Chunk { .begin = begin, .end = end });
+        begin = end;
+    }
+
+    // lex every chunk speculatively. The last chunk runs to the real end of file
+    llvm::parallelFor(0, chunks.size(), [&](const std::size_t index) {
+        auto& chunk = chunks[index];
+        chunk.lexer = std::make_unique<Lexer>(context, m_lexer.getId());
+        chunk.lexer->setSpeculative(true);
+        chunk.lexer->restrict(chunk.begin, chunk.end == terminator ? terminator + 1 : chunk.end, false); // NOLINT(*-pro-bounds-pointer-arithmetic)
+        while (true) {
+            const auto result = chunk.lexer->next();
+            if (!result.has_value()) {
+                return;
+            }
+            if (result->kind() == TokenKind::EndOfFile) {
+                chunk.last = *result;
+                break;
+            }
+            if (result->kind() == TokenKind::Identifier) {
+                chunk.hashes.push_back(chunk.lexer->getIdentifierHash());
+            }
+            chunk.tokens.push_back(*result);
+        }
+        chunk.stop = chunk.lexer->getPosition();
+        chunk.hasStatement = chunk.lexer->hasStatement();
+    });
+
+    // stitch in order, relexing chunks whose speculation does not hold
+    const auto inSource = [&](const llvm::StringRef str) {
+        return str.data() >= m_base && str.data() <= terminator;
+    };
+    auto& identifiers = context.getIdentifiers();
+    const char* position = m_base;
+    bool hasStatement = false;
+    for (const auto& chunk : chunks) {
+        if (chunk.end <= position) {
+            continue; // already covered by an earlier chunk that overran
+        }
+        const bool valid = position == chunk.begin && !hasStatement
+                        && chunk.stop != nullptr && !chunk.lexer->isSpeculationFailed();
+        if (!valid) {
+            const char* limit = chunk.end == terminator ? terminator + 1 : chunk.end; // NOLINT(*-pro-bounds-pointer-arithmetic)
+            if (!relex(position, limit, hasStatement)) {
+                return;
+            }
+            position = m_lexer.getPosition();
+            hasStatement = m_lexer.hasStatement();
+            continue;
+        }
+
+        std::size_t identifier = 0;
+        for (const auto& tkn : chunk.tokens) {
+            switch (tkn.kind().value()) {
+            case TokenKind::Identifier: {
+                const auto name = identifiers.intern(tkn.lexeme(), chunk.hashes[identifier++]);
+                push(tkn.kind(), tkn.getRange(), LiteralValue::from(name));
+                break;
+            }
+            case TokenKind::StringLiteral: {
+                const auto str = tkn.getValue().get<llvm::StringRef>();
+                push(tkn.kind(), tkn.getRange(), LiteralValue::from(inSource(str) ? str : context.retain(str)));
+                break;
+            }
+            default:
+                push(tkn.kind(), tkn.getRange(), tkn.getValue(), tkn.getTypeSuffix());
+                break;
+            }
+        }
+        position = chunk.stop;
+        hasStatement = chunk.hasStatement;
+        if (chunk.end == terminator) {
+            push(chunk.last.kind(), chunk.last.getRange(), {});
+            m_complete = true;
+        }
+    }
+
+    // an unterminated comment can carry an earlier chunk to the end of file
+    if (!m_complete) {
+        std::ignore = relex(position, terminator + 1, hasStatement); // NOLINT(*-pro-bounds-pointer-arithmetic)
+    }
+}
+
+auto TokenBuffer::relex(const char* start, const char* limit, const bool hasStatement) -> bool {
+    m_lexer.restrict(start, limit, hasStatement);
+    while (true) {
+        auto result = m_lexer.next();
+        if (!result.has_value()) {
+            push(TokenKind::Invalid, m_lexer.range(), {});
+            m_error = result.error();
+            m_complete = true;
+            return false;
+        }
+        if (result->kind() == TokenKind::EndOfFile) {
+            // only the real end of file is kept, a limit just ends this run
+            if (m_lexer.getPosition() < limit) {
+                push(result->kind(), result->getRange(), {});
+                m_complete = true;
+            }
+            return true;
+        }
+        push(result->kind(), result->getRange(), result->getValue(), result->getTypeSuffix());
+    }
+}
+
+auto TokenBuffer::token(const std::size_t index) -> Token {
+    const auto idx = ensure(index);
+    const char* start = m_base + m_offsets[idx]; // NOLINT(*-pro-bounds-pointer-arithmetic)
+    const char* end = start + m_lengths[idx];    // NOLINT(*-pro-bounds-pointer-arithmetic)
+    const llvm::SMRange range { llvm::SMLoc::getFromPointer(start), llvm::SMLoc::getFromPointer(end) };
+    if (const auto literal = m_literals[idx]; literal != kNoLiteral) {
+        return { m_kinds[idx], range, m_values[literal], m_suffixes[literal] };
+    }
+    return { m_kinds[idx], range };
+}
+
+auto TokenBuffer::ensure(const std::size_t index) -> std::size_t {
+    while (index >= m_kinds.size() && !m_complete) {
+        scan();
+    }
+    return std::min(index, m_kinds.size() - 1);
+}
+
+void TokenBuffer::scan() {
+    assert(!m_complete && "Scanning past the end of the token buffer");
+    if (auto result = m_lexer.next()) {
+        const auto& tkn = result.value();
+        push(tkn.kind(), tkn.getRange(), tkn.getValue(), tkn.getTypeSuffix());
+        m_complete = tkn.kind() == TokenKind::EndOfFile;
+    } else {
+        push(TokenKind::Invalid, m_lexer.range(), {});
+        m_error = result.error();
+        m_complete = true;
+    }
+}
+
+void TokenBuffer::push(const TokenKind kind, const llvm::SMRange range, const LiteralValue& value, const TokenKind typeSuffix) {
+    const auto offset = range.Start.getPointer() - m_base;
+    const auto length = range.End.getPointer() - range.Start.getPointer();
+    m_kinds.push_back(kind);
+    m_offsets.push_back(static_cast<std::uint32_t>(offset));
+    m_lengths.push_back(static_cast<std::uint32_t>(length));
+    if (value.isNull()) {
+        m_literals.push_back(kNoLiteral);
+    } else {
+        m_literals.push_back(static_cast<std::uint32_t>(m_values.size()));
+        m_values.push_back(value);
+        m_suffixes.push_back(typeSuffix);
+    }
+}
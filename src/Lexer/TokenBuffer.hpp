@@ -0,0 +1,136 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <vector>
+#include "Lexer.hpp"
+#include "Token.hpp"
+namespace lbc {
+class Context;
+
+/**
+ * Compact, indexable store of the tokens scanned from one source buffer.
+ *
+ * Tokens are kept as parallel arrays: a one byte kind, the offset and length
+ * of the lexeme within the source buffer, and an index into a side table that
+ * holds literal values and type suffixes only for the tokens that carry one. Any token can be
+ * fetched by index, so lookahead costs a bounds check rather than a rescan.
+ *
+ * The buffer is filled on demand as tokens are requested, or all at once with
+ * fill(). On demand filling lexes no further than the parser has read, which
+ * keeps diagnostics in the order they are encountered. Lexing stops at the
+ * first lexer error: the buffer then ends with an Invalid token and getError()
+ * returns the diagnostic. Otherwise the last token is EndOfFile, and requests
+ * past the end keep returning it.
+ */
+class TokenBuffer final {
+public:
+    NO_COPY_AND_MOVE(TokenBuffer)
+
+    /// Literal side table index of tokens without a value
+    static constexpr std::uint32_t kNoLiteral = std::numeric_limits<std::uint32_t>::max();
+
+    /** Create an empty buffer over the given source buffer. */
+    TokenBuffer(Context& context, unsigned id);
+    ~TokenBuffer() = default;
+
+    /// Sources at least this large are lexed in parallel by fill()
+    static constexpr std::size_t kParallelThreshold = 1024 * 1024;
+
+    /// Target size of a chunk lexed by one worker
+    static constexpr std::size_t kChunkSize = 256 * 1024;
+
+    /**
+     * Lex the rest of the source buffer up front. Large sources that have not
+     * been read from yet are split into chunks and lexed in parallel.
+     */
+    void fill();
+
+    /**
+     * Check whether the final token (EndOfFile or Invalid) has been scanned.
+     */
+    [[nodiscard]] auto isComplete() const -> bool { return m_complete; }
+
+    /**
+     * Number of tokens scanned so far.
+     */
+    [[nodiscard]] auto size() const -> std::size_t { return m_kinds.size(); }
+
+    /**
+     * Return the kind of the token at index, lexing up to it if needed.
+     */
+    [[nodiscard]] auto kind(std::size_t index) -> TokenKind {
+        return m_kinds[ensure(index)];
+    }
+
+    /**
+     * Materialise the token at index, lexing up to it if needed.
+     */
+    [[nodiscard]] auto token(std::size_t index) -> Token;
+
+    /**
+     * Diagnostic of the lexer error that ended the buffer, if any.
+     */
+    [[nodiscard]] auto getError() const -> DiagIndex { return m_error; }
+
+    /**
+     * Return the underlying lexer.
+     */
+    [[nodiscard]] auto getLexer() -> Lexer& { return m_lexer; }
+
+    /**
+     * Get associated context object
+     */
+    [[nodiscard]] auto getContext() const -> Context& { return m_lexer.getContext(); }
+
+private:
+    struct Chunk;
+
+    /**
+     * Split the source buffer at line starts, lex the chunks on worker threads
+     * and stitch the results together in order.
+     *
+     * Every chunk is lexed speculatively, assuming it begins outside any comment
+     * or statement. While stitching, a chunk whose speculative tokens cannot be
+     * used is lexed again by the main lexer, from wherever the previous chunk
+     * ended and with its state. This happens when a nested comment or a line
+     * continuation crossed into the chunk, or when the chunk needs a diagnostic.
+     */
+    void fillParallel();
+
+    /**
+     * Lex with the main lexer from @p start up to @p limit. Returns false if
+     * a lexer error ended the buffer.
+     */
+    [[nodiscard]] auto relex(const char* start, const char* limit, bool hasStatement) -> bool;
+
+    /**
+     * Lex until index is available or the buffer is complete, and return
+     * index clamped to the last scanned token.
+     */
+    [[nodiscard]] auto ensure(std::size_t index) -> std::size_t;
+
+    /**
+     * Scan one more token and append it.
+     */
+    void scan();
+
+    /**
+     * Append a token to the arrays.
+     */
+    void push(TokenKind kind, llvm::SMRange range, const LiteralValue& value, TokenKind typeSuffix = TokenKind::Invalid);
+
+    Lexer m_lexer;
+    const char* m_base;
+    std::vector<TokenKind> m_kinds;
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint32_t> m_lengths;
+    std::vector<std::uint32_t> m_literals;
+    std::vector<LiteralValue> m_values;
+    std::vector<TokenKind> m_suffixes;
+    DiagIndex m_error;
+    bool m_complete = false;
+};
+
+} // namespace lbc
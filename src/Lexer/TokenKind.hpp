@@ -567,7 +567,214 @@ struct TokenKind final {
         return { Move, LogicalNot, Is, As, Modulus, LogicalAnd, LogicalOr };
     }
 
+    /**
+     * Recognise a keyword, type name or keyword-like operator from identifier
+     * text, ignoring ASCII case. Dispatches on length and first letter, then
+     * compares the remaining bytes in place. Returns Identifier if there is no match.
+     */
+    [[nodiscard]] static constexpr auto fromIdentifier(const llvm::StringRef str) -> TokenKind {
+        // NOLINTBEGIN(*-magic-numbers)
+        switch (str.size()) {
+            case 2:
+                switch (str[0]) {
+                    case 'A': case 'a':
+                        if (equalsKeyword(str, "AS")) { return As; }
+                        break;
+                    case 'D': case 'd':
+                        if (equalsKeyword(str, "DO")) { return Do; }
+                        break;
+                    case 'I': case 'i':
+                        if (equalsKeyword(str, "IS")) { return Is; }
+                        if (equalsKeyword(str, "IF")) { return If; }
+                        break;
+                    case 'O': case 'o':
+                        if (equalsKeyword(str, "OR")) { return LogicalOr; }
+                        break;
+                    case 'T': case 't':
+                        if (equalsKeyword(str, "TO")) { return To; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 3:
+                switch (str[0]) {
+                    case 'A': case 'a':
+                        if (equalsKeyword(str, "AND")) { return LogicalAnd; }
+                        if (equalsKeyword(str, "ANY")) { return Any; }
+                        break;
+                    case 'D': case 'd':
+                        if (equalsKeyword(str, "DIM")) { return Dim; }
+                        break;
+                    case 'E': case 'e':
+                        if (equalsKeyword(str, "END")) { return End; }
+                        break;
+                    case 'F': case 'f':
+                        if (equalsKeyword(str, "FOR")) { return For; }
+                        break;
+                    case 'M': case 'm':
+                        if (equalsKeyword(str, "MOD")) { return Modulus; }
+                        break;
+                    case 'N': case 'n':
+                        if (equalsKeyword(str, "NOT")) { return LogicalNot; }
+                        break;
+                    case 'P': case 'p':
+                        if (equalsKeyword(str, "PTR")) { return Ptr; }
+                        break;
+                    case 'R': case 'r':
+                        if (equalsKeyword(str, "REF")) { return Ref; }
+                        if (equalsKeyword(str, "REM")) { return Rem; }
+                        break;
+                    case 'S': case 's':
+                        if (equalsKeyword(str, "SUB")) { return Sub; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 4:
+                switch (str[0]) {
+                    case 'B': case 'b':
+                        if (equalsKeyword(str, "BOOL")) { return Bool; }
+                        if (equalsKeyword(str, "BYTE")) { return Byte; }
+                        break;
+                    case 'E': case 'e':
+                        if (equalsKeyword(str, "ELSE")) { return Else; }
+                        if (equalsKeyword(str, "EXIT")) { return Exit; }
+                        break;
+                    case 'L': case 'l':
+                        if (equalsKeyword(str, "LOOP")) { return Loop; }
+                        if (equalsKeyword(str, "LONG")) { return Long; }
+                        break;
+                    case 'M': case 'm':
+                        if (equalsKeyword(str, "MOVE")) { return Move; }
+                        break;
+                    case 'N': case 'n':
+                        if (equalsKeyword(str, "NEXT")) { return Next; }
+                        if (equalsKeyword(str, "NULL")) { return Null; }
+                        break;
+                    case 'S': case 's':
+                        if (equalsKeyword(str, "STEP")) { return Step; }
+                        break;
+                    case 'T': case 't':
+                        if (equalsKeyword(str, "THEN")) { return Then; }
+                        if (equalsKeyword(str, "TRUE")) { return True; }
+                        if (equalsKeyword(str, "TYPE")) { return TypeKw; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 5:
+                switch (str[0]) {
+                    case 'C': case 'c':
+                        if (equalsKeyword(str, "CONST")) { return Const; }
+                        break;
+                    case 'F': case 'f':
+                        if (equalsKeyword(str, "FALSE")) { return False; }
+                        break;
+                    case 'S': case 's':
+                        if (equalsKeyword(str, "SHORT")) { return Short; }
+                        break;
+                    case 'U': case 'u':
+                        if (equalsKeyword(str, "UNTIL")) { return Until; }
+                        if (equalsKeyword(str, "UBYTE")) { return UByte; }
+                        if (equalsKeyword(str, "ULONG")) { return ULong; }
+                        break;
+                    case 'W': case 'w':
+                        if (equalsKeyword(str, "WHILE")) { return While; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 6:
+                switch (str[0]) {
+                    case 'D': case 'd':
+                        if (equalsKeyword(str, "DOUBLE")) { return Double; }
+                        break;
+                    case 'E': case 'e':
+                        if (equalsKeyword(str, "EXTERN")) { return Extern; }
+                        break;
+                    case 'I': case 'i':
+                        if (equalsKeyword(str, "IMPORT")) { return Import; }
+                        break;
+                    case 'R': case 'r':
+                        if (equalsKeyword(str, "RETURN")) { return Return; }
+                        break;
+                    case 'S': case 's':
+                        if (equalsKeyword(str, "SIZEOF")) { return SizeOf; }
+                        if (equalsKeyword(str, "SINGLE")) { return Single; }
+                        break;
+                    case 'T': case 't':
+                        if (equalsKeyword(str, "TYPEOF")) { return TypeOf; }
+                        break;
+                    case 'U': case 'u':
+                        if (equalsKeyword(str, "USHORT")) { return UShort; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 7:
+                switch (str[0]) {
+                    case 'A': case 'a':
+                        if (equalsKeyword(str, "ALIGNOF")) { return AlignOf; }
+                        break;
+                    case 'D': case 'd':
+                        if (equalsKeyword(str, "DECLARE")) { return Declare; }
+                        break;
+                    case 'I': case 'i':
+                        if (equalsKeyword(str, "INTEGER")) { return Integer; }
+                        break;
+                    case 'L': case 'l':
+                        if (equalsKeyword(str, "LONGINT")) { return LongInt; }
+                        break;
+                    case 'Z': case 'z':
+                        if (equalsKeyword(str, "ZSTRING")) { return ZString; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case 8:
+                switch (str[0]) {
+                    case 'C': case 'c':
+                        if (equalsKeyword(str, "CONTINUE")) { return Continue; }
+                        break;
+                    case 'F': case 'f':
+                        if (equalsKeyword(str, "FUNCTION")) { return Function; }
+                        break;
+                    case 'U': case 'u':
+                        if (equalsKeyword(str, "UINTEGER")) { return UInteger; }
+                        if (equalsKeyword(str, "ULONGINT")) { return ULongInt; }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            default:
+                break;
+        }
+        // NOLINTEND(*-magic-numbers)
+        return Identifier;
+    }
+
     private:
+    /**
+     * Compare identifier text against an upper case keyword of the same length
+     * and first letter. Identifier characters are letters, digits and '_', so
+     * clearing bit 5 folds letters to upper case and never aliases the others.
+     */
+    [[nodiscard]] static constexpr auto equalsKeyword(const llvm::StringRef str, const llvm::StringRef keyword) -> bool {
+        for (std::size_t idx = 1; idx < keyword.size(); ++idx) {
+            if ((static_cast<unsigned>(str[idx]) & 0xDFU) != static_cast<unsigned>(keyword[idx])) { // NOLINT(*-magic-numbers)
+                return false;
+            }
+        }
+        return true;
+    }
+
     Value m_value;
 };
 } // namespace lbc
@@ -0,0 +1,115 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include <llvm/Support/Parallel.h>
+#include "Driver/Context.hpp"
+#include "Parser.hpp"
+using namespace lbc;
+
+/**
+ * Track statement starts and the nesting of SUB / FUNCTION definitions.
+ * DECLARE SUB and END SUB never open a definition, as their SUB does not
+ * start a statement. The body of a top-level definition begins after the
+ * EOS ending its header and ends at the END of the matching END SUB or
+ * END FUNCTION. Unbalanced definitions are simply not reported, the
+ * serial parse diagnoses them.
+ */
+auto Parser::skimBodies() -> std::vector<BodySpan> {
+    std::vector<BodySpan> bodies;
+    std::size_t depth = 0;
+    std::size_t begin = 0;
+    bool inHeader = false;
+    bool statementStart = true;
+
+    const auto size = m_tokens.size();
+    for (std::size_t index = 0; index < size; index++) {
+        const auto kind = m_tokens.kind(index);
+        if (statementStart) {
+            if (kind.isOneOf(TokenKind::Sub, TokenKind::Function)) {
+                inHeader = depth++ == 0;
+            } else if (kind == TokenKind::End && depth > 0 && m_tokens.kind(index + 1).isOneOf(TokenKind::Sub, TokenKind::Function)) {
+                if (--depth == 0) {
+                    bodies.push_back({ .begin = begin, .end = index });
+                }
+            }
+        }
+        if (kind == TokenKind::EndOfStmt) {
+            if (inHeader) {
+                begin = index + 1;
+                inHeader = false;
+            }
+            statementStart = true;
+        } else {
+            statementStart = false;
+        }
+    }
+    return bodies;
+}
+
+/**
+ * Only runs over a complete token buffer without lexer errors, so workers
+ * never lex, and read the shared buffer concurrently. Each task owns a
+ * worker parser with its own arena and diagnostic buffer, and parses a run
+ * of consecutive bodies. A body is kept only if it parsed and stopped
+ * exactly at its END. A body that fails keeps the errors recorded for it,
+ * which funcStmt() logs when the module parse reaches it, and ends the
+ * task: the module parse stops at the first error, so it never reaches
+ * the bodies after it.
+ */
+void Parser::parseBodies() {
+    if (!m_tokens.isComplete() || m_tokens.getError().isValid()) {
+        return;
+    }
+    const auto spans = skimBodies();
+    if (spans.size() < kParallelBodies) {
+        return;
+    }
+
+    /// Result of one worker task
+    struct Outcome final {
+        std::vector<std::pair<std::size_t, ParsedBody>> bodies;
+        DiagBuffer diagnostics;
+    };
+
+    auto& context = getContext();
+    const auto tasks = (spans.size() + kBodiesPerTask - 1) / kBodiesPerTask;
+    std::vector<Outcome> outcomes(tasks);
+    llvm::parallelFor(0, tasks, [&](const std::size_t task) {
+        auto& outcome = outcomes[task];
+        Parser worker { *this, context.createAstArena(), outcome.diagnostics };
+        const auto last = std::min((task + 1) * kBodiesPerTask, spans.size());
+        for (auto index = task * kBodiesPerTask; index < last; index++) {
+            const auto& span = spans[index];
+            worker.seek(span.begin);
+            const auto body = worker.stmtList();
+            if (not body.has_value()) {
+                if (not outcome.diagnostics.empty()) {
+                    outcome.bodies.emplace_back(
+                        span.begin,
+                        ParsedBody { .body = nullptr, .end = span.end, .diagnostics = std::move(outcome.diagnostics) }
+                    );
+                }
+                break;
+            }
+            if (worker.m_index - 1 == span.end) {
+                outcome.bodies.emplace_back(span.begin, ParsedBody { .body = *body, .end = span.end });
+            }
+        }
+    });
+
+    m_bodies.reserve(static_cast<unsigned>(spans.size()));
+    for (auto& outcome : outcomes) {
+        for (auto& [begin, body] : outcome.bodies) {
+            m_bodies.try_emplace(begin, std::move(body));
+        }
+    }
+}
+
+void Parser::deferBodies() {
+    if (!m_tokens.isComplete() || m_tokens.getError().isValid()) {
+        return;
+    }
+    for (const auto& span : skimBodies()) {
+        m_bodies.try_emplace(span.begin, ParsedBody { .body = nullptr, .end = span.end });
+    }
+}
@@ -33,6 +33,24 @@ auto Parser::varDecl() -> Result<AstVarDecl*> {
     return decl;
 }
 
+/**
+ * constDecl = id [ "AS" typeExpr ] "=" expression .
+ */
+auto Parser::constDecl() -> Result<AstConstDecl*> {
+    const auto start = startLoc();
+    TRY_DECL(id, identifier())
+    AstType* ty {}; // NOLINT(*-const-correctness)
+
+    // [ "AS" typeExpr ] "=" expression
+    TRY_IF (accept(TokenKind::As)) {
+        TRY_ASSIGN(ty, type())
+    }
+    TRY(consume(TokenKind::Assign))
+    TRY_DECL(expr, expression())
+
+    return make<AstConstDecl>(range(start), id, ty, expr);
+}
+
 // subDecl = "SUB" [ "(" params ")" ] .
 auto Parser::subDecl() -> Result<AstFuncDecl*> {
     const auto start = startLoc();
@@ -90,7 +108,7 @@ auto Parser::paramList(const bool requireParens, bool& variadic) -> Result<std::
     }
 
     // ( param | "..." ) { "," ( param | "..." ) } — a "..." ends the list.
-    Sequencer<AstFuncParamDecl> params {};
+    auto params = scratch<AstFuncParamDecl>();
     while (true) {
         TRY_IF(accept(TokenKind::Ellipsis)) {
             variadic = true;
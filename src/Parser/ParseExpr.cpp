@@ -87,12 +87,12 @@ auto Parser::varExpr() -> Result<AstExpr*> {
 /**
  * literal = "null"
  *         | "true" | "false"
- *         | <integer> | <float>
+ *         | <integer> [ <suffix> ] | <float> [ <suffix> ]
  *         | <string>
  *         .
  */
 auto Parser::literalExpr() -> Result<AstExpr*> {
-    auto* expr = make<AstLiteralExpr>(m_token.getRange(), m_token.getValue());
+    auto* expr = make<AstLiteralExpr>(range(m_token), m_token.getValue(), m_token.getTypeSuffix());
     TRY(advance())
     return expr;
 }
@@ -119,7 +119,7 @@ auto Parser::funcCallExpr(AstExpr* callee) -> Result<AstExpr*> {
 
 /// argExprList = expression { "," expression } .
 auto Parser::argExprList() -> Result<std::span<AstExpr*>> {
-    Sequencer<AstExpr> args {};
+    auto args = scratch<AstExpr>();
     TRY_ADD(args, expression())
     TRY_WHILE (accept(TokenKind::Comma)) {
         TRY_ADD(args, expression())
@@ -0,0 +1,176 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "Ast/Ast.hpp"
+#include "Ast/AstVisitor.hpp"
+#include "Driver/Context.hpp"
+#include "Parser.hpp"
+using namespace lbc;
+
+namespace {
+
+/// Move a valid @p range by @p offset bytes
+auto moved(const SourceRange range, const std::int64_t offset) -> SourceRange {
+    if (not range.isValid()) {
+        return range;
+    }
+    return { static_cast<std::uint32_t>(range.getOffset() + offset), range.getLength() };
+}
+
+/**
+ * Follow the expressions @p expr replaced during semantic analysis back to
+ * the one the parser built, unlinking them on the way, see
+ * AstExpr::getOriginal().
+ */
+auto parsed(AstExpr* expr) -> AstExpr* {
+    while (expr != nullptr && expr->getOriginal() != nullptr) {
+        auto* original = expr->getOriginal();
+        expr->setOriginal(nullptr);
+        expr = original;
+    }
+    return expr;
+}
+
+/**
+ * Reset a @p field of a reused node to what the parser left in it. Node
+ * links are restored to the parsed expressions and everything semantic
+ * analysis or lowering derived is dropped, so none of it outlives an edit
+ * elsewhere in the module it was derived from.
+ */
+template<typename T>
+void reset(T& field) {
+    if constexpr (std::is_same_v<T, AstExpr*>) {
+        field = parsed(field);
+    } else if constexpr (std::is_same_v<T, std::span<AstExpr*>>) {
+        for (auto*& expr : field) {
+            expr = parsed(expr);
+        }
+    } else if constexpr (std::is_same_v<T, ValueCategory>) {
+        field = ValueCategory::Value;
+    } else if constexpr (std::is_same_v<T, const Type*>
+                         || std::is_same_v<T, Symbol*>
+                         || std::is_same_v<T, SymbolTable*>
+                         || std::is_same_v<T, AstModule*>
+                         || std::is_same_v<T, ir::lib::Value*>) {
+        field = nullptr;
+    }
+}
+
+/**
+ * Move the ranges of @p root and everything it owns by @p offset, and
+ * return the nodes to their parsed state, see reset(). Parents are reset
+ * before their children are listed, so the walk descends into the parsed
+ * expressions rather than the ones analysis put in their place.
+ * forEachChild() follows owning edges only, so declarations listed again
+ * in AstStmtList::getDecls() are handled once, through their statements.
+ */
+void relocate(AstRoot& root, const std::int64_t offset) {
+    llvm::SmallVector<AstRoot*, 16> pending { &root };
+    while (not pending.empty()) {
+        auto* node = pending.pop_back_val();
+        node->setRange(moved(node->getRange(), offset));
+        visit(*node, [](auto& ast) {
+            ast.forEachField([](auto& field) { reset(field); });
+        });
+        forEachChild(*node, [&](AstRoot& child) { pending.push_back(&child); });
+    }
+}
+
+} // namespace
+
+auto Parser::reparse(AstModule& previous, const unsigned previousId, const std::span<const Edit> edits) -> Result<AstModule*> {
+    // reuse is verified against the new tokens, so they are needed up front
+    m_tokens.fill();
+    if (not m_tokens.getError().isValid()) {
+        collectReusable(previous, previousId, edits);
+    }
+    if (m_lazy) {
+        deferBodies();
+    }
+    return module();
+}
+
+/**
+ * An edit touching a statement, even only at its first or last byte, may
+ * change its tokens, so the statement is parsed again. Edits entirely
+ * before a statement shift it by their change in length.
+ */
+void Parser::collectReusable(AstModule& previous, const unsigned previousId, const std::span<const Edit> edits) {
+    const auto previousBase = getContext().getLocationBase(previousId);
+    for (auto* stmt : previous.getStmtList()->getStmts()) {
+        // a deferred body can only be parsed by the parser that skipped it
+        if (const auto* func = llvm::dyn_cast<AstFuncStmt>(stmt); func != nullptr && func->getDeferred()) {
+            continue;
+        }
+
+        const auto range = stmt->getRange();
+        const std::int64_t start = range.getOffset() - previousBase;
+        const std::int64_t end = start + range.getLength();
+        std::int64_t shift = 0;
+        bool touched = false;
+        for (const auto& edit : edits) {
+            const std::int64_t editStart = edit.offset;
+            const std::int64_t editEnd = editStart + edit.removed;
+            if (editEnd < start) {
+                shift += std::int64_t { edit.inserted } - std::int64_t { edit.removed };
+            } else if (editStart <= end) {
+                touched = true;
+                break;
+            }
+        }
+        if (touched) {
+            continue;
+        }
+
+        const auto newStart = std::int64_t { m_locationBase } + start + shift;
+        m_reusable.try_emplace(
+            static_cast<std::uint32_t>(newStart),
+            Reusable {
+                .stmt = stmt,
+                .end = static_cast<std::uint32_t>(newStart + range.getLength()),
+                .offset = newStart - range.getOffset(),
+            }
+        );
+    }
+}
+
+auto Parser::reuse() -> AstStmt* {
+    if (m_reusable.empty()) {
+        return nullptr;
+    }
+    const auto iter = m_reusable.find(location(startLoc()));
+    if (iter == m_reusable.end()) {
+        return nullptr;
+    }
+    const auto reusable = iter->second;
+    m_reusable.erase(iter);
+
+    // The text is unchanged and lexing starts at a token boundary, so the
+    // tokens are the same if the statement still ends on one, before an EOS.
+    const auto next = tokenAt(reusable.end);
+    if (next < m_index
+        || m_tokens.kind(next) != TokenKind::EndOfStmt
+        || location(m_tokens.token(next - 1).getRange().End) != reusable.end) {
+        return nullptr;
+    }
+
+    relocate(*reusable.stmt, reusable.offset);
+    seek(next);
+    return reusable.stmt;
+}
+
+auto Parser::tokenAt(const std::uint32_t loc) -> std::size_t {
+    std::size_t first = 0;
+    std::size_t count = m_tokens.size();
+    while (count > 0) {
+        const auto step = count / 2;
+        const auto index = first + step;
+        if (location(m_tokens.token(index).getRange().Start) < loc) {
+            first = index + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
@@ -16,18 +16,24 @@ auto isTerminator(const Token& tkn) -> bool {
 /// stmtList = { statement EOS } .
 auto Parser::stmtList() -> Result<AstStmtList*> {
     const auto start = m_token.getRange().Start;
-    Sequencer<AstDecl> decls {};
-    Sequencer<AstStmt> stmts {};
+    auto decls = scratch<AstDecl>();
+    auto stmts = scratch<AstStmt>();
 
     // { Statement EOS } .
     while (not isTerminator(m_token)) {
-        TRY_DECL(stmt, statement())
+        AstStmt* stmt = reuse(); // NOLINT(*-const-correctness)
+        if (stmt == nullptr) {
+            TRY_ASSIGN(stmt, statement())
+        }
         TRY(consume(TokenKind::EndOfStmt))
         stmts.add(stmt);
         const auto visitor = Visitor {
             [&](const AstDimStmt& ast) {
                 decls.append(ast.getDecls());
             },
+            [&](const AstConstStmt& ast) {
+                decls.append(ast.getDecls());
+            },
             [&](const AstDeclareStmt& ast) {
                 decls.add(ast.getDecl());
             },
@@ -45,9 +51,11 @@ auto Parser::stmtList() -> Result<AstStmtList*> {
 /**
  * statement = declareStmt
  *           | externStmt
+ *           | importStmt
  *           | funcStmt
  *           | returnStmt
  *           | dimStmt
+ *           | constStmt
  *           | ( expression [ "=" expression ] )
  *           .
  */
@@ -55,6 +63,8 @@ auto Parser::statement() -> Result<AstStmt*> {
     switch (m_token.kind().value()) {
     case TokenKind::Dim:
         return dimStmt();
+    case TokenKind::Const:
+        return constStmt();
     case TokenKind::Declare:
         return declareStmt();
     case TokenKind::Sub:
@@ -64,6 +74,8 @@ auto Parser::statement() -> Result<AstStmt*> {
         return returnStmt();
     case TokenKind::Extern:
         return externStmt();
+    case TokenKind::Import:
+        return importStmt();
     default:
         TRY_DECL(primary, expression({ .callWithoutParens = true, .stopAtAssign = true }));
         TRY_IF (accept(TokenKind::Assign)) {
@@ -80,7 +92,7 @@ auto Parser::dimStmt() -> Result<AstStmt*> {
     TRY(consume(TokenKind::Dim))
 
     // varDecl { "," varDecl }
-    Sequencer<AstVarDecl> decls {};
+    auto decls = scratch<AstVarDecl>();
     TRY_ADD(decls, varDecl())
     TRY_WHILE (accept(TokenKind::Comma)) {
         TRY_ADD(decls, varDecl())
@@ -89,6 +101,21 @@ auto Parser::dimStmt() -> Result<AstStmt*> {
     return make<AstDimStmt>(range(start), sequence(decls));
 }
 
+/// constStmt = "CONST" constDecl { "," constDecl } .
+auto Parser::constStmt() -> Result<AstStmt*> {
+    const auto start = startLoc();
+    TRY(consume(TokenKind::Const))
+
+    // constDecl { "," constDecl }
+    auto decls = scratch<AstConstDecl>();
+    TRY_ADD(decls, constDecl())
+    TRY_WHILE (accept(TokenKind::Comma)) {
+        TRY_ADD(decls, constDecl())
+    }
+
+    return make<AstConstStmt>(range(start), sequence(decls));
+}
+
 /// declareStmt = "DECLARE" ( subDecl | funcDecl )
 auto Parser::declareStmt() -> Result<AstStmt*> {
     const auto start = startLoc();
@@ -114,6 +141,9 @@ auto Parser::declareStmt() -> Result<AstStmt*> {
  *
  * Reuses the declaration parsers for the header, parses the body up to the
  * matching END SUB / END FUNCTION, and links the definition onto its decl.
+ * A body already parsed by parseBodies() is attached instead of parsed, or
+ * its errors logged if it failed, and in lazy mode a body recorded by
+ * deferBodies() is skipped.
  */
 auto Parser::funcStmt() -> Result<AstStmt*> {
     const auto start = startLoc();
@@ -128,12 +158,36 @@ auto Parser::funcStmt() -> Result<AstStmt*> {
 
     // EOS stmtList "END" ( "SUB" | "FUNCTION" )
     TRY(consume(TokenKind::EndOfStmt))
-    TRY_DECL(body, stmtList())
+    AstStmtList* body {}; // NOLINT(*-const-correctness)
+    std::optional<BodySpan> deferred;
+    if (const auto iter = m_bodies.find(m_index - 1); iter != m_bodies.end()) {
+        if (not iter->second.diagnostics.empty()) {
+            // failed on a worker thread with the errors parsing it here gives
+            return DiagError(iter->second.diagnostics.flush(getContext().getDiag()));
+        }
+        const auto bodyStart = startLoc();
+        const BodySpan span { .begin = m_index - 1, .end = iter->second.end };
+        seek(span.end);
+        if (iter->second.body != nullptr) {
+            // parsed ahead on a worker thread
+            body = iter->second.body;
+        } else {
+            // lazy mode, parseBody() fills in the statements
+            body = make<AstStmtList>(range(bodyStart), std::span<AstDecl*> {}, std::span<AstStmt*> {});
+            deferred = span;
+        }
+    } else {
+        TRY_ASSIGN(body, stmtList())
+    }
     TRY(consume(TokenKind::End))
     TRY(consume(isSub ? TokenKind::Sub : TokenKind::Function))
 
     auto* stmt = make<AstFuncStmt>(range(start), decl, body);
     decl->setImpl(stmt);
+    if (deferred.has_value()) {
+        stmt->setDeferred(true);
+        m_deferred.try_emplace(stmt, *deferred);
+    }
     return stmt;
 }
 
@@ -177,7 +231,7 @@ auto Parser::externStmt() -> Result<AstStmt*> {
 
     // For now only DECLARE statements are accepted inside; the AstStmt* element
     // type leaves room for extern variables and other declarations later.
-    Sequencer<AstStmt> stmts {};
+    auto stmts = scratch<AstStmt>();
     if (m_token.kind() == TokenKind::EndOfStmt) {
         // Block form: EXTERN "C" <EOS> { declareStmt <EOS> } END EXTERN
         TRY(consume(TokenKind::EndOfStmt))
@@ -194,3 +248,17 @@ auto Parser::externStmt() -> Result<AstStmt*> {
 
     return make<AstExtern>(range(start), ExternKind::C, sequence(stmts));
 }
+
+/**
+ * importStmt = "IMPORT" id .
+ *
+ * Keeps the module name as written, it names the interface file. Sema loads
+ * the interface.
+ */
+auto Parser::importStmt() -> Result<AstStmt*> {
+    const auto start = startLoc();
+    TRY(consume(TokenKind::Import))
+    const auto name = getContext().retain(m_token.lexeme());
+    TRY(identifier())
+    return make<AstImport>(range(start), name);
+}
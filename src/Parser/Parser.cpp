@@ -6,15 +6,40 @@
 #include "Driver/Context.hpp"
 using namespace lbc;
 
-Parser::Parser(Context& context, const unsigned id)
-: m_lexer(context, id)
-, m_lastLoc(m_lexer.range().Start) {
+Parser::Parser(Context& context, const unsigned id, const Tokenise tokenise, const Bodies bodies)
+: m_ownTokens(std::make_unique<TokenBuffer>(context, id))
+, m_tokens(*m_ownTokens)
+, m_arena(context.getAstArena())
+, m_lastLoc(m_tokens.getLexer().range().Start)
+, m_bufferStart(context.getSourceMgr().getMemoryBuffer(id)->getBufferStart())
+, m_locationBase(context.getLocationBase(id)) {
+    m_lazy = bodies == Bodies::Lazy;
+    if (tokenise == Tokenise::Upfront || m_lazy) {
+        m_tokens.fill();
+    }
 }
 
+Parser::Parser(const Parser& parent, AstArena& arena, DiagBuffer& diagnostics)
+: m_tokens(parent.m_tokens)
+, m_arena(arena)
+, m_lastLoc(parent.m_lastLoc)
+, m_bufferStart(parent.m_bufferStart)
+, m_locationBase(parent.m_locationBase)
+, m_diagBuffer(&diagnostics) {}
+
 Parser::~Parser() = default;
 
-// module = stmtList EOF .
 auto Parser::parse() -> Result<AstModule*> {
+    if (m_lazy) {
+        deferBodies();
+    } else {
+        parseBodies();
+    }
+    return module();
+}
+
+// module = stmtList EOF .
+auto Parser::module() -> Result<AstModule*> {
     TRY(advance())
 
     TRY_DECL(stmts, stmtList())
@@ -24,6 +49,27 @@ auto Parser::parse() -> Result<AstModule*> {
     return make<AstModule>(stmts->getRange(), stmts);
 }
 
+auto Parser::parseBody(AstFuncStmt& ast) -> Result<void> {
+    const auto iter = m_deferred.find(&ast);
+    if (iter == m_deferred.end()) {
+        return {};
+    }
+    const auto span = iter->second;
+    m_deferred.erase(iter);
+
+    seek(span.begin);
+    TRY_DECL(body, stmtList())
+    if (m_index - 1 != span.end) {
+        return unexpected();
+    }
+
+    auto* list = ast.getStmtList();
+    list->setDecls(body->getDecls());
+    list->setStmts(body->getStmts());
+    ast.setDeferred(false);
+    return {};
+}
+
 auto Parser::unexpected(const std::source_location& location) -> DiagError {
     if (m_deferredError.isValid()) {
         return DiagError(std::exchange(m_deferredError, {}));
@@ -35,12 +81,15 @@ auto Parser::advance() -> Result<void> {
     if (m_deferredError.isValid()) {
         return DiagError(std::exchange(m_deferredError, {}));
     }
-    if (auto res = m_lexer.next(); res) {
-        m_lastLoc = m_token.getRange().End;
-        m_token = res.value();
+    const auto next = m_tokens.token(m_index);
+    if (next.kind() == TokenKind::Invalid) {
+        // the buffer ends with the token that failed to lex
+        m_token = next;
+        m_deferredError = m_tokens.getError();
     } else {
-        m_token = Token(TokenKind::Invalid, m_lexer.range());
-        m_deferredError = res.error();
+        m_lastLoc = m_token.getRange().End;
+        m_token = next;
+        m_index++;
     }
     return {};
 }
@@ -68,9 +117,16 @@ auto Parser::consume(const TokenKind kind) -> Result<void> {
     return advance();
 }
 
-auto Parser::identifier() -> Result<llvm::StringRef> {
+void Parser::seek(const std::size_t index) {
+    assert(index > 0 && "cannot seek to the first token");
+    m_lastLoc = m_tokens.token(index - 1).getRange().End;
+    m_token = m_tokens.token(index);
+    m_index = index + 1;
+}
+
+auto Parser::identifier() -> Result<Identifier> {
     TRY(expect(TokenKind::Identifier))
-    const auto id = std::get<llvm::StringRef>(m_token.getValue().storage());
+    const auto id = Identifier::fromInterned(std::get<llvm::StringRef>(m_token.getValue().storage()));
     TRY(advance())
     return id;
 }
@@ -4,13 +4,16 @@
 #pragma once
 #include "pch.hpp"
 
+#include <llvm/ADT/DenseMap.h>
 #include "Ast/Ast.hpp"
+#include "Ast/AstArena.hpp"
 #include "Ast/AstFwdDecl.hpp"
+#include "Diag/DiagBuffer.hpp"
 #include "Diag/DiagEngine.hpp"
 #include "Diag/LogProvider.hpp"
-#include "Lexer/Lexer.hpp"
 #include "Lexer/Token.hpp"
-#include "Utilities/Sequencer.hpp"
+#include "Lexer/TokenBuffer.hpp"
+#include "Utilities/ScratchStack.hpp"
 namespace lbc {
 class Context;
 
@@ -23,11 +26,13 @@ class Context;
  * @code
  * module     = stmtList EOF .
  * stmtList   = { statement EOS } .
- * statement  = declareStmt | dimStmt | funcStmt | returnStmt .
+ * statement  = declareStmt | dimStmt | constStmt | funcStmt | returnStmt .
  * funcStmt   = ( subDecl | funcDecl ) EOS stmtList "END" ( "SUB" | "FUNCTION" ) .
  * returnStmt = "RETURN" [ expression ] .
  * dimStmt    = "DIM" varDecl { "," varDecl } .
  * varDecl    = id ( "AS" typeExpr [ "=" expression ] | "=" expression ) .
+ * constStmt  = "CONST" constDecl { "," constDecl } .
+ * constDecl  = id [ "AS" typeExpr ] "=" expression .
  * expression = primary { <binary-op> primary } .
  * primary    = variable | literal | "(" expression ")" | prefix .
  * variable   = id .
@@ -37,6 +42,19 @@ class Context;
  * function   = callee "(" [ params ] ")" .
  * params     = expression { "," expression } .
  * @endcode
+ *
+ * When the source is tokenised up front, parse() first skims the token
+ * kinds for the bodies of top-level SUB and FUNCTION definitions. If there
+ * are enough of them, the bodies are parsed concurrently by worker parsers,
+ * each allocating from its own arena, and the module is then parsed
+ * serially, attaching the finished bodies as it reaches them. A body that
+ * fails to parse on a worker is parsed again serially, so diagnostics are
+ * reported exactly as without the parallel pass.
+ *
+ * In lazy mode the same skim lets parse() step over top-level bodies
+ * entirely. Each such definition gets an empty, deferred statement list,
+ * and parseBody() fills it in once semantic analysis finds the definition
+ * is used. Syntax errors in a body are reported only if it is parsed.
  */
 class Parser final : protected LogProvider {
 public:
@@ -48,10 +66,38 @@ public:
     template<typename T>
     using Result = DiagResult<T>;
 
+    /// How the source is turned into tokens.
+    enum class Tokenise : std::uint8_t {
+        OnDemand, ///< lex each token as the parser reaches it
+        Upfront,  ///< lex the whole buffer before parsing starts, enables parallel body parsing
+    };
+
+    /// When SUB / FUNCTION bodies are parsed.
+    enum class Bodies : std::uint8_t {
+        Eager, ///< parse every body with the rest of the module
+        Lazy,  ///< skip top-level bodies until parseBody() is called
+    };
+
+    /// A replaced byte range of the previous source, for reparse().
+    struct Edit final {
+        std::uint32_t offset;   ///< first replaced byte, from the start of the previous buffer
+        std::uint32_t removed;  ///< number of bytes replaced
+        std::uint32_t inserted; ///< number of bytes of the replacement
+    };
+
+    /// Least number of SUB / FUNCTION bodies worth parsing in parallel
+    static constexpr std::size_t kParallelBodies = 16;
+
+    /// Bodies parsed by one worker task, so small bodies share an arena and a parser
+    static constexpr std::size_t kBodiesPerTask = 8;
+
     /**
      * Construct a parser for the source buffer identified by @param context @param id @param
+     * tokenise selects whether the token buffer is filled lazily or up front. @param bodies
+     * selects whether top-level SUB / FUNCTION bodies are parsed with the module or on
+     * demand. Lazy bodies need every token, so they imply up front tokenising.
      */
-    Parser(Context& context, unsigned id);
+    Parser(Context& context, unsigned id, Tokenise tokenise = Tokenise::OnDemand, Bodies bodies = Bodies::Eager);
     ~Parser();
 
     /**
@@ -59,12 +105,119 @@ public:
      */
     auto parse() -> Result<AstModule*>;
 
+    /**
+     * Parse the buffer as an edited copy of buffer @param previousId, whose
+     * module @param previous was parsed in the same context. @param edits
+     * are the byte ranges replaced in the previous buffer, in any order.
+     *
+     * Top-level statements of the previous module that no edit touches are
+     * moved into the new module, SUB / FUNCTION bodies included, once the
+     * new tokens confirm the statement is still there. Their source ranges
+     * are shifted to the new buffer. Only what the parser built is reused:
+     * if the previous module was analysed, the expressions analysis replaced
+     * are restored, and its types and symbols are dropped. Symbol tables are
+     * not kept either, as they may depend on an edited statement; analysis
+     * of the new module creates them again. Everything else is parsed as
+     * usual. The previous module is consumed and must not be used afterwards.
+     */
+    auto reparse(AstModule& previous, unsigned previousId, std::span<const Edit> edits) -> Result<AstModule*>;
+
+    /**
+     * Parse the body of a definition skipped in lazy mode. Its statement list,
+     * created empty by parse(), receives the parsed statements and declarations,
+     * so a symbol table already attached to it is kept. Does nothing if the body
+     * is not deferred. Must be called after parse().
+     */
+    auto parseBody(AstFuncStmt& ast) -> Result<void>;
+
     /**
      * Get associated context object
      */
-    [[nodiscard]] auto getContext() const -> Context& { return m_lexer.getContext(); }
+    [[nodiscard]] auto getContext() const -> Context& { return m_tokens.getContext(); }
+
+    /**
+     * Get the buffer diagnostics are recorded in, which is the case for the
+     * workers parsing bodies in parallel. Null when they are logged.
+     */
+    [[nodiscard]] auto getDiagBuffer() const -> DiagBuffer* { return m_diagBuffer; }
 
 private:
+    /**
+     * Construct a worker parser sharing the complete token buffer of @param parent,
+     * allocating nodes from @param arena and recording diagnostics in @param diagnostics
+     */
+    Parser(const Parser& parent, AstArena& arena, DiagBuffer& diagnostics);
+
+    // -------------------------------------------------------------------------
+    // Parallel bodies (ParseBodies.cpp)
+    // -------------------------------------------------------------------------
+
+    /// Tokens of a SUB / FUNCTION body
+    struct BodySpan final {
+        std::size_t begin; ///< index of the first body token, after the header's EOS
+        std::size_t end;   ///< index of the END token closing the definition
+    };
+
+    /// Body parsed ahead of the module
+    struct ParsedBody final {
+        AstStmtList* body;         ///< parsed statements, nullptr for a deferred or failed body
+        std::size_t end;           ///< index of the END token closing the definition
+        DiagBuffer diagnostics {}; ///< errors of a body that failed to parse, logged when it is reached
+    };
+
+    /**
+     * Find the bodies of top-level SUB and FUNCTION definitions by their
+     * token kinds alone. Requires a complete token buffer.
+     */
+    [[nodiscard]] auto skimBodies() -> std::vector<BodySpan>;
+
+    /**
+     * Parse the bodies found by skimBodies() on worker threads and store
+     * them in m_bodies, along with the errors of the first that fails.
+     */
+    void parseBodies();
+
+    /**
+     * Record the bodies found by skimBodies() in m_bodies without parsing
+     * them, so funcStmt() skips over them.
+     */
+    void deferBodies();
+
+    /**
+     * Make the token at @param index current, as if everything before it
+     * had been consumed.
+     */
+    void seek(std::size_t index);
+
+    // -------------------------------------------------------------------------
+    // Incremental reparse (ParseIncremental.cpp)
+    // -------------------------------------------------------------------------
+
+    /// Statement of the previous module that may be reused
+    struct Reusable final {
+        AstStmt* stmt;       ///< the statement
+        std::uint32_t end;   ///< compact location of its end in the new buffer
+        std::int64_t offset; ///< distance its ranges move by
+    };
+
+    /**
+     * Fill m_reusable with the top-level statements of @param previous that
+     * none of @param edits touch, keyed by their start in the new buffer.
+     */
+    void collectReusable(AstModule& previous, unsigned previousId, std::span<const Edit> edits);
+
+    /**
+     * If a reusable statement starts at the current token and the new tokens
+     * still end it where expected, move its ranges, skip its tokens and
+     * return it. Otherwise return nullptr.
+     */
+    [[nodiscard]] auto reuse() -> AstStmt*;
+
+    /**
+     * Index of the first token starting at or after compact location @param loc
+     */
+    [[nodiscard]] auto tokenAt(std::uint32_t loc) -> std::size_t;
+
     // --------------------------------
     // Utilities
     // --------------------------------
@@ -145,9 +298,9 @@ private:
 
     /**
      * Expect the current token to be an identifier, consume it,
-     * and return its string value.
+     * and return its interned name.
      */
-    [[nodiscard]] auto identifier() -> Result<llvm::StringRef>;
+    [[nodiscard]] auto identifier() -> Result<Identifier>;
 
     // -------------------------------------------------------------------------
     // Source location and range
@@ -156,35 +309,54 @@ private:
     /** Return the start location of the current token. */
     [[nodiscard]] auto startLoc() const -> llvm::SMLoc { return m_token.getRange().Start; }
 
-    /** Build a range from @param start to the end of the last consumed token. */
-    [[nodiscard]] auto range(const llvm::SMLoc start) const -> llvm::SMRange {
-        return { start, m_lastLoc };
+    /** Compact location of @param loc in the parsed buffer. */
+    [[nodiscard]] auto location(const llvm::SMLoc loc) const -> std::uint32_t {
+        return m_locationBase + static_cast<std::uint32_t>(loc.getPointer() - m_bufferStart);
+    }
+
+    /** Build a range from @param start to the end of the last consumed token, empty if nothing was consumed since. */
+    [[nodiscard]] auto range(const llvm::SMLoc start) const -> SourceRange {
+        const auto offset = location(start);
+        return { offset, std::max(location(m_lastLoc), offset) - offset };
     }
 
     /** Build a range from the start of @param start node to the end of the last consumed token. */
-    [[nodiscard]] auto range(const AstRoot* start) const -> llvm::SMRange {
-        return { start->getRange().Start, m_lastLoc };
+    [[nodiscard]] auto range(const AstRoot* start) const -> SourceRange {
+        const auto offset = start->getRange().getOffset();
+        return { offset, std::max(location(m_lastLoc), offset) - offset };
+    }
+
+    /** Build a range covering @param token. */
+    [[nodiscard]] auto range(const Token& token) const -> SourceRange {
+        const auto offset = location(token.getRange().Start);
+        return { offset, location(token.getRange().End) - offset };
     }
 
     /** Build a range spanning from @param first to @param last node. */
-    [[nodiscard]] static auto range(const AstRoot* first, const AstRoot* last) -> llvm::SMRange {
-        return { first->getRange().Start, last->getRange().End };
+    [[nodiscard]] static auto range(const AstRoot* first, const AstRoot* last) -> SourceRange {
+        return first->getRange().to(last->getRange());
     }
 
     // -------------------------------------------------------------------------
     // Memory handling
     // -------------------------------------------------------------------------
 
-    /** Arena-allocate an AST node via the context. */
+    /** Allocate an AST node in its group's pool of the parser's arena. */
     template<typename T, typename... Args>
     auto make(Args&&... args) -> T* {
-        return getContext().create<T>(std::forward<Args>(args)...);
+        return m_arena.create<T>(std::forward<Args>(args)...);
+    }
+
+    /** Open a scratch list for collecting the nodes of one AST list. */
+    template<typename T>
+    [[nodiscard]] auto scratch() -> ScratchStack::List<T> {
+        return m_scratch.list<T>();
     }
 
-    /** Flatten a sequencer into a contiguous arena-allocated span. */
+    /** Copy a scratch list into a contiguous arena-allocated span. */
     template<typename T>
-    [[nodiscard]] auto sequence(Sequencer<T>& seq) -> std::span<T*> {
-        return seq.sequence(getContext());
+    [[nodiscard]] auto sequence(const ScratchStack::List<T>& list) -> std::span<T*> {
+        return list.sequence(m_arena.getAllocator());
     }
 
     // -------------------------------------------------------------------------
@@ -194,6 +366,9 @@ private:
     /** Parse a variable declaration (name, optional type, optional initializer). */
     [[nodiscard]] auto varDecl() -> Result<AstVarDecl*>;
 
+    /** Parse a constant declaration (name, optional type, initializer). */
+    [[nodiscard]] auto constDecl() -> Result<AstConstDecl*>;
+
     /** Parse a subroutine declaration (name and optional parameter list, no return type). */
     [[nodiscard]] auto subDecl() -> Result<AstFuncDecl*>;
 
@@ -210,6 +385,9 @@ private:
     // Statements (ParseStmt.cpp)
     // -------------------------------------------------------------------------
 
+    /** Parse the whole module: statements up to the end of file. */
+    [[nodiscard]] auto module() -> Result<AstModule*>;
+
     /** Parse a list of statements terminated by a block-ending token. */
     [[nodiscard]] auto stmtList() -> Result<AstStmtList*>;
 
@@ -219,6 +397,9 @@ private:
     /** Parse a DIM statement with one or more variable declarations. */
     [[nodiscard]] auto dimStmt() -> Result<AstStmt*>;
 
+    /** Parse a CONST statement with one or more constant declarations. */
+    [[nodiscard]] auto constStmt() -> Result<AstStmt*>;
+
     /** Parse a DECLARE forward-declaration statement. */
     [[nodiscard]] auto declareStmt() -> Result<AstStmt*>;
 
@@ -231,6 +412,9 @@ private:
     /** Parse an EXTERN linkage block — either a single-line or a blcok */
     [[nodiscard]] auto externStmt() -> Result<AstStmt*>;
 
+    /** Parse an IMPORT statement. */
+    [[nodiscard]] auto importStmt() -> Result<AstStmt*>;
+
     // -------------------------------------------------------------------------
     // Expressions (ParseExpr.cpp)
     // -------------------------------------------------------------------------
@@ -282,12 +466,23 @@ private:
     // -------------------------------------------------------------------------
     // Parser Data
     // -------------------------------------------------------------------------
-    Lexer m_lexer;                            ///< Lexer producing tokens from the source buffer
-    Token m_token;                            ///< Currently read token (one-token lookahead)
-    llvm::SMLoc m_lastLoc;                    ///< End location of the last consumed token
-    DiagIndex m_deferredError;                ///< Lexer error deferred until token is demanded
-    Scope m_scope = Scope::Module;            ///< Current parsing scope
-    ExprFlags m_exprFlags = defaultExprFlags; ///< Active expression parsing flags
+    std::unique_ptr<TokenBuffer> m_ownTokens;           ///< Token buffer owned by the main parser, null in workers
+    TokenBuffer& m_tokens;                              ///< Tokens scanned from the source buffer
+    AstArena& m_arena;                                  ///< Arena the nodes are allocated from
+    std::size_t m_index = 0;                            ///< Index of the token following m_token
+    Token m_token;                                      ///< Currently read token
+    llvm::SMLoc m_lastLoc;                              ///< End location of the last consumed token
+    const char* m_bufferStart;                          ///< Start of the parsed source buffer
+    std::uint32_t m_locationBase;                       ///< Compact location of m_bufferStart
+    DiagIndex m_deferredError;                          ///< Lexer error deferred until token is demanded
+    Scope m_scope = Scope::Module;                      ///< Current parsing scope
+    ExprFlags m_exprFlags = defaultExprFlags;           ///< Active expression parsing flags
+    ScratchStack m_scratch;                             ///< Reusable buffers for lists being parsed
+    llvm::DenseMap<std::size_t, ParsedBody> m_bodies;   ///< Bodies parsed in parallel or deferred, by first token index
+    llvm::DenseMap<AstFuncStmt*, BodySpan> m_deferred;  ///< Definitions whose body is not parsed yet
+    llvm::DenseMap<std::uint32_t, Reusable> m_reusable; ///< Previous statements to reuse, by start in the new buffer
+    DiagBuffer* m_diagBuffer = nullptr;                 ///< Records diagnostics in worker parsers, null when logged
+    bool m_lazy = false;                                ///< Defer top-level bodies
 };
 
 } // namespace lbc
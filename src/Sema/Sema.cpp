@@ -1,19 +1,48 @@
 //
 // Created by Albert Varaksin on 19/02/2026.
 //
+#include "Driver/Context.hpp"
 #include "SemanticAnalyser.hpp"
+#include "Symbol/Symbol.hpp"
 using namespace lbc;
 
 SemanticAnalyser::SemanticAnalyser(Context& context)
-: m_context(context) {
+: m_context(context)
+, m_arena(context.getAstArena())
+, m_references(std::make_shared<ReferenceGraph>())
+, m_evaluable(std::make_shared<llvm::DenseMap<const Symbol*, const AstFuncStmt*>>()) {
+}
+
+SemanticAnalyser::SemanticAnalyser(const SemanticAnalyser& parent, AstArena& arena, DiagBuffer& diagnostics)
+: m_context(parent.m_context)
+, m_arena(arena)
+, m_bindings(&parent.m_bindings)
+, m_diagBuffer(&diagnostics)
+, m_references(parent.m_references)
+, m_evaluable(parent.m_evaluable) {
 }
 
 SemanticAnalyser::~SemanticAnalyser() = default;
 
-auto SemanticAnalyser::analyse(const AstModule& ast) -> Result {
-    return accept(ast);
+auto SemanticAnalyser::analyse(const AstModule& ast, const BodyLoader loader) -> Result {
+    const ValueRestorer restore { m_bodyLoader };
+    m_bodyLoader = loader;
+    TRY(accept(ast))
+    TRY(analyseDeferredBodies())
+    removeUnreachable();
+    return {};
 }
 
 auto SemanticAnalyser::accept(const AstModule& ast) -> Result {
     return accept(*ast.getStmtList());
 }
+
+void SemanticAnalyser::removeUnreachable() {
+    const auto removed = m_references->prune();
+    if (not m_context.getOptions().isVerbose()) {
+        return;
+    }
+    for (const auto* symbol : removed) {
+        std::ignore = diag(diagnostics::unreachableDefinition(symbol->getName()), symbol->getRange());
+    }
+}
@@ -0,0 +1,120 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include <llvm/Support/Parallel.h>
+#include "Diag/DiagBuffer.hpp"
+#include "Driver/Context.hpp"
+#include "SemanticAnalyser.hpp"
+using namespace lbc;
+
+/**
+ * A body sees the module scope as the statements before it left it, so
+ * any statement that is not a definition ends the run of bodies collected
+ * so far, which is analysed before it. DECLARE and IMPORT are handled by
+ * the statement list and analyse to nothing, so they do not end a run.
+ */
+auto SemanticAnalyser::analyseStatements(const std::span<AstStmt*> stmts) -> Result {
+    std::vector<AstFuncStmt*> bodies;
+    for (auto* stmt : stmts) {
+        if (auto* func = llvm::dyn_cast<AstFuncStmt>(stmt)) {
+            bodies.push_back(func);
+            continue;
+        }
+        if (llvm::isa<AstDeclareStmt, AstImport>(stmt)) {
+            continue;
+        }
+        TRY(analyseBodies(bodies))
+        bodies.clear();
+        TRY(visit(*stmt))
+    }
+    return analyseBodies(bodies);
+}
+
+namespace {
+/** Whether @p body declares constants, whose initialisers may call other bodies. */
+auto declaresConstants(const AstFuncStmt& body) -> bool {
+    for (const auto* decl : body.getStmtList()->getDecls()) {
+        if (llvm::isa<AstConstDecl>(decl)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+/**
+ * Until its turn comes, each body of the run waits and may be analysed on
+ * demand by a constant that calls it. Bodies without constants never call
+ * another at compile time, so those between two that declare constants are
+ * free to be analysed together, in parallel if there are enough of them.
+ */
+auto SemanticAnalyser::analyseBodies(const std::span<AstFuncStmt*> bodies) -> Result {
+    for (auto* body : bodies) {
+        m_waitingBodies.try_emplace(body->getDecl()->getSymbol(), body);
+    }
+
+    std::vector<AstFuncStmt*> part;
+    const auto analysePart = [&]() -> Result {
+        if (part.size() < kParallelBodies) {
+            for (auto* body : part) {
+                TRY(analyseBody(*body))
+            }
+        } else {
+            TRY(analyseInParallel(part))
+            for (const auto* body : part) {
+                m_waitingBodies.erase(body->getDecl()->getSymbol());
+                m_evaluable->try_emplace(body->getDecl()->getSymbol(), body);
+            }
+        }
+        part.clear();
+        return {};
+    };
+
+    for (auto* body : bodies) {
+        if (m_evaluable->contains(body->getDecl()->getSymbol())) {
+            continue; // analysed on demand
+        }
+        if (not declaresConstants(*body)) {
+            part.push_back(body);
+            continue;
+        }
+        TRY(analysePart())
+        TRY(analyseBody(*body))
+    }
+    return analysePart();
+}
+
+/**
+ * Bodies only declare into their own scopes and read the module scope,
+ * which nothing changes while they run. Each task owns a worker analyser
+ * with its own arena, diagnostic buffer and bindings layered over the
+ * module's, and analyses a run of consecutive bodies, stopping at the
+ * first that fails. The buffers are then logged in source order up to the
+ * first failure, which is where serial analysis would have stopped.
+ */
+auto SemanticAnalyser::analyseInParallel(const std::span<AstFuncStmt*> bodies) -> Result {
+    /// Result of one worker task
+    struct Outcome final {
+        DiagBuffer diagnostics;
+        bool failed = false;
+    };
+
+    const auto tasks = (bodies.size() + kBodiesPerTask - 1) / kBodiesPerTask;
+    std::vector<Outcome> outcomes(tasks);
+    llvm::parallelFor(0, tasks, [&](const std::size_t task) {
+        auto& outcome = outcomes[task];
+        SemanticAnalyser worker { *this, m_context.createAstArena(), outcome.diagnostics };
+        const auto last = std::min((task + 1) * kBodiesPerTask, bodies.size());
+        for (auto index = task * kBodiesPerTask; index < last && !outcome.failed; index++) {
+            outcome.failed = !worker.accept(*bodies[index]).has_value();
+        }
+    });
+
+    for (auto& outcome : outcomes) {
+        const auto last = outcome.diagnostics.flush(m_context.getDiag());
+        if (outcome.failed) {
+            return DiagError(last);
+        }
+    }
+    return {};
+}
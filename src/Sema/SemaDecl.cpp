@@ -9,12 +9,12 @@
 using namespace lbc;
 
 auto SemanticAnalyser::declare(AstDecl& ast) -> Result {
-    if (m_symbolTable->contains(ast.getName(), false)) {
+    if (m_bindings.findLocal(ast.getName()) != nullptr) {
         return diag(diagnostics::redefinition(ast.getName()), ast.getRange());
     }
 
-    auto* symbol = m_context.create<Symbol>(ast.getName(), ast.getType(), ast.getRange());
-    m_symbolTable->insert(symbol);
+    auto* symbol = create<Symbol>(ast.getName(), ast.getType(), ast.getRange());
+    m_bindings.declare(symbol);
     symbol->setVisibility(SymbolVisibility::Private);
     // Record the active language linkage; under C the symbol keeps its verbatim
     // (as-written) name as an alias — the name the IR and C ABI use.
@@ -27,6 +27,8 @@ auto SemanticAnalyser::declare(AstDecl& ast) -> Result {
         symbol->setFlag(SymbolFlags::Function);
     } else if (llvm::isa<AstVarDecl>(&ast)) {
         symbol->setFlag(SymbolFlags::Variable);
+    } else if (llvm::isa<AstConstDecl>(&ast)) {
+        symbol->setFlag(SymbolFlags::Constant);
     }
 
     ast.setSymbol(symbol);
@@ -62,9 +64,22 @@ auto SemanticAnalyser::accept(AstVarDecl& ast) -> Result {
         exprType = type->removeReference();
     }
 
-    // init expression
+    // init expression, at module level possibly evaluated at compile time
     if (auto* expr = ast.getExpr()) {
+        const bool global = m_returnType == nullptr;
+        llvm::SmallVector<const Symbol*, 4> uses;
+        const ValueRestorer restore { m_initialiserUses };
+        if (global) {
+            m_initialiserUses = &uses;
+        }
         TRY_DECL(repl, expression(*expr, exprType));
+        // without a type the literal subtree keeps its natural type
+        if (std::exchange(m_coercible, false)) {
+            repl = foldLiterals(*repl);
+        }
+        if (global) {
+            TRY_ASSIGN(repl, evaluateInitialiser(*repl, uses))
+        }
         ast.setExpr(repl);
         if (type == nullptr) {
             type = repl->getType();
@@ -92,6 +107,48 @@ auto SemanticAnalyser::accept(AstVarDecl& ast) -> Result {
     return {};
 }
 
+auto SemanticAnalyser::accept(AstConstDecl& ast) -> Result {
+    const Type* type = nullptr;
+    if (auto* ty = ast.getTypeExpr()) {
+        TRY(visit(*ty));
+        type = ty->getType();
+        if (type->isReference()) {
+            return diag(diagnostics::constantReference(ast.getName()), ty->getRange());
+        }
+    }
+
+    llvm::SmallVector<const Symbol*, 4> uses;
+    const ValueRestorer restore { m_initialiserUses };
+    m_initialiserUses = &uses;
+    TRY_DECL(repl, expression(*ast.getExpr(), type));
+    // An untyped constant initialised from a literal subtree stays coercible
+    const bool untyped = type == nullptr && std::exchange(m_coercible, false);
+    if (untyped) {
+        repl = foldLiterals(*repl);
+    }
+    // Calls to functions are evaluated at compile time, analysing them if need be
+    TRY_ASSIGN(repl, evaluateInitialiser(*repl, uses))
+    ast.setExpr(repl);
+
+    const auto* literal = llvm::dyn_cast<AstLiteralExpr>(repl);
+    if (literal == nullptr) {
+        return diag(diagnostics::notConstant(ast.getName()), repl->getRange());
+    }
+    type = literal->getType();
+    if (type->isNull()) {
+        return diag(diagnostics::nullVariable(), ast.getRange());
+    }
+
+    ast.setType(type);
+    auto* symbol = ast.getSymbol();
+    symbol->setType(type);
+    symbol->setValue(constantValue(*literal));
+    if (untyped) {
+        symbol->setFlag(SymbolFlags::Untyped);
+    }
+    return {};
+}
+
 auto SemanticAnalyser::accept(AstFuncDecl& ast) -> Result {
     // C-style variadics are an ABI concern: only meaningful under C linkage. The
     // symbol already carries its linkage (set during declare).
@@ -101,17 +158,16 @@ auto SemanticAnalyser::accept(AstFuncDecl& ast) -> Result {
 
     const auto count = ast.getParams().size();
 
-    auto related = m_context.span<Symbol*>(count);
-    auto params = m_context.span<const Type*>(count);
+    auto related = span<Symbol*>(count);
+    auto params = span<const Type*>(count);
 
     // Parameters live in the function body's scope, not the enclosing one.
     // Build that scope now and declare the parameters into it; a definition
     // (one carrying a body) hands the scope to its body below so the parameters
     // are visible there, while a forward declaration simply discards it.
-    auto* paramScope = m_context.create<SymbolTable>(m_symbolTable);
+    auto* paramScope = create<SymbolTable>(m_bindings.getTable());
     {
-        const ValueRestorer restore { m_symbolTable };
-        m_symbolTable = paramScope;
+        const auto scope = m_bindings.enter(*paramScope);
         std::size_t index = 0;
         for (auto* param : ast.getParams()) {
             TRY(visit(*param));
@@ -127,7 +183,7 @@ auto SemanticAnalyser::accept(AstFuncDecl& ast) -> Result {
         TRY(visit(*retTyExpr));
         returnType = retTyExpr->getType();
     } else {
-        returnType = m_context.getTypeFactory().getVoid();
+        returnType = getTypeFactory().getVoid();
     }
 
     // Get function type
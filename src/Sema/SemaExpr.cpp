@@ -1,6 +1,8 @@
 //
 // Created by Albert Varaksin on 19/02/2026.
 //
+#include <llvm/ADT/SmallVector.h>
+#include "Ast/AstArena.hpp"
 #include "Driver/Context.hpp"
 #include "SemanticAnalyser.hpp"
 #include "Symbol/Symbol.hpp"
@@ -13,49 +15,64 @@ using namespace lbc;
 // Entry point
 // =============================================================================
 
-// Expression analysis uses two type propagation mechanisms:
+// Expression analysis is a single pass over the tree:
 //
-// - m_explicitType (top-down): pushed from the caller, e.g. the declared
-//   type of a variable in `DIM x AS BYTE = <expr>`. After the expression
-//   visitor completes, if the result type differs from the explicit type
-//   the expression is coerced or wrapped in an implicit cast.
+// - Types are synthesised bottom-up. Every node is visited once and gets
+//   its natural type from its operands: a variable its declared type, an
+//   unsuffixed literal INTEGER, DOUBLE, BOOL, ZSTRING or NULL.
 //
-// - m_suggestedType (bottom-up): set by any typed sub-expression (variables,
-//   literals, casts, calls) and propagated upward through the expression tree.
-//   When multiple suggestions compete, their common type is used. Allows
-//   `2 + 3 AS BYTE` or `2 + b` (where b is BYTE) to type the literals as BYTE.
+// - Literal coercion is deferred. An expression built only from unsuffixed
+//   literals, negation and arithmetic (`1 + 2 * 3`) has no fixed type yet,
+//   which each accept() reports through m_coercible. The first typed context
+//   it meets, a typed sibling in a binary expression (`2 + b` where b is
+//   BYTE) or the explicit type of the caller (`DIM x AS BYTE = 1 + 2`),
+//   re-types the whole literal subtree top-down in one walk, see coerce().
+//   Once typed it is fixed, so no node is coerced more than once.
 //
-// Both are saved/restored per expression() call via ValueRestorer so nested
-// expression analyses (e.g. function arguments) don't leak state.
+// Everything else converts with an implicit cast after the visit.
+//
+// Expressions with a value known at compile time fold to literals, see
+// fold(). A node folds as soon as it is analysed, once its operands have.
+// A literal subtree folds as a whole when its type is final, either when
+// it is coerced or when its parent takes it as is, see foldLiterals().
 
 auto SemanticAnalyser::expression(AstExpr& ast, const Type* explicitType) -> DiagResult<AstExpr*> {
-    const ValueRestorer restore { m_explicitType, m_suggestedType };
-    m_explicitType = explicitType;
-    m_suggestedType = nullptr;
-
     TRY(visit(ast));
     AstExpr* res = &ast;
 
-    // strip unnecessary cast
-    if (const auto* cast = llvm::dyn_cast<AstCastExpr>(res)) {
+    // strip unnecessary cast, its operand links back to it for a reparse
+    if (auto* cast = llvm::dyn_cast<AstCastExpr>(res)) {
         if (cast->getType() == cast->getExpr()->getType()) {
             res = cast->getExpr();
+            cast->setExpr(parsed(*res));
+            res->setOriginal(cast);
         }
     }
 
-    if (m_explicitType != nullptr) {
-        if (res->getType() != m_explicitType) {
-            return castOrCoerce(*res, m_explicitType);
-        }
+    // A literal subtree waits for its type, a constant is a single literal
+    if (not m_coercible || llvm::isa<AstVarExpr>(res)) {
+        res = fold(*res);
+    }
+
+    if (explicitType == nullptr) {
         return res;
     }
 
-    if (m_suggestedType != nullptr) {
-        // re-examine the expression again, with new suggested type
-        return expression(*res, m_suggestedType);
+    const bool coercible = std::exchange(m_coercible, false);
+    if (res->getType() == explicitType) {
+        return coercible ? foldLiterals(*res) : res;
+    }
+
+    if (coercible) {
+        TRY(coerce(*res, explicitType))
+        return foldLiterals(*res);
     }
 
-    return res;
+    if (explicitType->convertible(res->getType(), Type::Conversion::Implicit)) {
+        return fold(*cast(*res, explicitType));
+    }
+
+    return diag(diagnostics::typeMismatch(*res->getType(), *explicitType), res->getRange());
 }
 
 // =============================================================================
@@ -100,38 +117,45 @@ auto SemanticAnalyser::cast(AstExpr& ast, const Type* targetType) const -> AstEx
     if (ast.getType() == targetType) {
         return &ast;
     }
-    auto* castExpr = m_context.create<AstCastExpr>(ast.getRange(), &ast, nullptr, true);
+    auto* castExpr = make<AstCastExpr>(ast.getRange(), &ast, nullptr, true);
     castExpr->setType(targetType);
+    castExpr->setOriginal(&ast);
     return castExpr;
 }
 
-auto SemanticAnalyser::castOrCoerce(AstExpr& ast, const Type* targetType) -> DiagResult<AstExpr*> {
-    if (ast.getType() == targetType) {
-        return &ast;
-    }
-
-    if (auto* literal = llvm::dyn_cast<AstLiteralExpr>(&ast)) {
-        TRY(coerceLiteral(*literal, targetType))
-        return &ast;
-    }
-
-    if (targetType->convertible(ast.getType(), Type::Conversion::Implicit)) {
-        return cast(ast, targetType);
+// Every expression analysis puts in the place of another links back to it,
+// so a reparse reusing the statement can restore what the parser built
+// before analysing it again, with the constants it uses changed.
+auto SemanticAnalyser::parsed(AstExpr& ast) -> AstExpr* {
+    auto* expr = &ast;
+    while (auto* original = expr->getOriginal()) {
+        expr = original;
     }
-
-    return diag(diagnostics::typeMismatch(*ast.getType(), *targetType), ast.getRange());
+    return expr;
 }
 
-void SemanticAnalyser::setSuggestedType(const Type* type) {
-    if (m_explicitType != nullptr) {
-        return;
-    }
-
-    if (m_suggestedType == nullptr) {
-        m_suggestedType = type;
-    } else {
-        m_suggestedType = type->common(m_suggestedType);
+// Walk the literal subtree with an explicit stack, so coercing a long
+// chain like `1 + 2 + ... + n` does not recurse once per term.
+auto SemanticAnalyser::coerce(AstExpr& ast, const Type* targetType) -> Result {
+    llvm::SmallVector<AstExpr*, 16> pending { &ast };
+    while (not pending.empty()) {
+        auto* expr = pending.pop_back_val();
+        if (auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr)) {
+            TRY(coerceLiteral(*literal, targetType))
+        } else if (auto* unary = llvm::dyn_cast<AstUnaryExpr>(expr)) {
+            if (!(targetType->isSignedIntegral() || targetType->isFloatingPoint())) {
+                return diag(diagnostics::typeMismatch(*unary->getType(), *targetType), unary->getRange());
+            }
+            unary->setType(targetType);
+            pending.push_back(unary->getExpr());
+        } else {
+            auto* binary = llvm::cast<AstBinaryExpr>(expr);
+            binary->setType(targetType);
+            pending.push_back(binary->getRight());
+            pending.push_back(binary->getLeft());
+        }
     }
+    return {};
 }
 
 auto SemanticAnalyser::ensureAddressable(const AstExpr& ast) -> Result {
@@ -155,13 +179,19 @@ auto SemanticAnalyser::ensureAssignable(const AstExpr& ast) -> Result {
 // Expressions
 // =============================================================================
 
-// Determine the literal's natural type, then attempt coercion to the
-// suggested type (from an AS cast) or implicit type (from the caller).
-// Coercion only succeeds within the same type family.
+// Give the literal its natural type. Coercion to the type of its context is
+// left to the parent, see coerce(). A type suffix gives the literal its type
+// outright, like a typed variable.
 auto SemanticAnalyser::accept(AstLiteralExpr& ast) -> Result {
     const auto& factory = getTypeFactory();
     const auto value = ast.getValue();
 
+    if (ast.getTypeSuffix() != TokenKind::Invalid) {
+        ast.setType(factory.getType(ast.getTypeSuffix()));
+        m_coercible = false;
+        return {};
+    }
+
     const Type* naturalType = nullptr;
     if (value.isIntegral()) {
         naturalType = factory.getInteger();
@@ -176,20 +206,12 @@ auto SemanticAnalyser::accept(AstLiteralExpr& ast) -> Result {
     }
 
     ast.setType(naturalType);
-
-    // Try coercion to suggested or implicit type
-    if (m_explicitType != nullptr) {
-        TRY(coerceLiteral(ast, m_explicitType));
-    } else if (m_suggestedType != nullptr) {
-        TRY(coerceLiteral(ast, m_suggestedType));
-    } else {
-        setSuggestedType(ast.getType());
-    }
+    m_coercible = true;
     return {};
 }
 
 auto SemanticAnalyser::accept(AstVarExpr& ast) -> Result {
-    auto* symbol = m_symbolTable->find(ast.getName(), true);
+    auto* symbol = m_bindings.find(ast.getName());
     if (symbol == nullptr) {
         return diag(diagnostics::undeclaredIdentifier(ast.getName()), ast.getRange());
     }
@@ -198,13 +220,36 @@ auto SemanticAnalyser::accept(AstVarExpr& ast) -> Result {
         return diag(diagnostics::useBeforeDefinition(symbol->getName()), ast.getRange());
     }
 
+    // A referenced function becomes reachable, so its deferred body is needed.
+    if (m_bodyLoader && symbol->hasFlag(SymbolFlags::Function)) {
+        reference(*symbol);
+    }
+
+    // Module level definitions are lowered only if something reachable uses them.
+    // An initialiser that is evaluated at compile time does not use them at run time.
+    if (symbol->hasFlag(SymbolFlags::Function) || symbol->hasFlag(SymbolFlags::Variable)) {
+        if (m_initialiserUses != nullptr) {
+            m_initialiserUses->push_back(symbol);
+        } else {
+            m_references->reference(m_definition, *symbol);
+        }
+    }
+
     ast.setSymbol(symbol);
     ast.setType(symbol->getType()->removeReference());
+
+    // A constant is a pure Value, it folds to its literal. Without a declared
+    // type it coerces like one.
+    if (symbol->hasFlag(SymbolFlags::Constant)) {
+        m_coercible = symbol->hasFlag(SymbolFlags::Untyped);
+        return {};
+    }
+
     // A named variable designates an object: it is Addressable (lvalue). This
     // holds whether or not the symbol is reference-bound — naming a reference
     // yields the referent as an Addressable place.
     ast.setValueCategory(ValueCategory::Addressable);
-    setSuggestedType(ast.getType());
+    m_coercible = false;
     return {};
 }
 
@@ -214,8 +259,10 @@ auto SemanticAnalyser::accept(AstVarExpr& ast) -> Result {
 // - AddressOf: operand must be addressable (lvalue); produces a pointer
 // - Dereference: pointer types only; produces the pointee type
 // - Move: operand must designate an object (glvalue); produces an xvalue
+// Negating a literal subtree keeps it coercible.
 auto SemanticAnalyser::accept(AstUnaryExpr& ast) -> Result {
     TRY_EXPRESSION(ast, Expr, nullptr)
+    const bool coercible = std::exchange(m_coercible, false);
 
     const auto* operandType = ast.getExpr()->getType();
     const auto op = ast.getOp();
@@ -226,7 +273,16 @@ auto SemanticAnalyser::accept(AstUnaryExpr& ast) -> Result {
             return diag(diagnostics::invalidUnaryOperand(op, *operandType), ast.getRange());
         }
         ast.setType(operandType);
-    } else if (op == TokenKind::LogicalNot) {
+        m_coercible = coercible;
+        return {};
+    }
+
+    // Any other operator takes a literal operand as is
+    if (coercible) {
+        ast.setExpr(foldLiterals(*ast.getExpr()));
+    }
+
+    if (op == TokenKind::LogicalNot) {
         if (!operandType->isBool()) {
             return diag(diagnostics::invalidUnaryOperand(op, *operandType), ast.getRange());
         }
@@ -257,25 +313,47 @@ auto SemanticAnalyser::accept(AstUnaryExpr& ast) -> Result {
     } else {
         std::unreachable();
     }
+    return {};
+}
+
+// A chain like `a + b + ... + n` nests on its left operands. They are
+// analysed from the innermost outwards in a loop, each left as expression()
+// would leave it, so a long chain does not recurse once per term. Right
+// operands, and other nesting, still recurse.
+auto SemanticAnalyser::accept(AstBinaryExpr& ast) -> Result {
+    llvm::SmallVector<AstBinaryExpr*, 8> chain { &ast };
+    while (auto* left = llvm::dyn_cast<AstBinaryExpr>(chain.back()->getLeft())) {
+        chain.push_back(left);
+    }
 
-    setSuggestedType(ast.getType());
+    TRY_EXPRESSION(*chain.back(), Left, nullptr)
+    TRY(binary(*chain.back()))
+    for (auto index = chain.size() - 1; index-- > 0;) {
+        auto* expr = chain[index];
+        if (not m_coercible) {
+            expr->setLeft(fold(*expr->getLeft()));
+        }
+        TRY(binary(*expr))
+    }
     return {};
 }
 
 // Binary expression analysis by operator category:
 //
 // Arithmetic / Comparison:
-//   1. Analyse both operands
-//   2. If types differ and one is a literal, coerce the literal to match
-//   3. If types differ and neither is a literal, find the common type and
-//      insert implicit casts for both operands
-//   4. Result is the operand type (arithmetic) or BOOL (comparison)
+//   1. Analyse the right operand, the left one already is
+//   2. If types differ and one is a literal subtree, coerce it to match
+//   3. If types differ and neither is a literal subtree, find the common
+//      type and insert implicit casts for both operands
+//   4. Result is the operand type (arithmetic) or BOOL (comparison).
+//      Arithmetic on two literal subtrees is itself a literal subtree.
 //
 // Logical (AND, OR):
 //   Both operands must be BOOL. Result is BOOL.
-auto SemanticAnalyser::accept(AstBinaryExpr& ast) -> Result {
-    TRY_EXPRESSION(ast, Left, nullptr)
+auto SemanticAnalyser::binary(AstBinaryExpr& ast) -> Result {
+    const bool leftCoercible = m_coercible;
     TRY_EXPRESSION(ast, Right, nullptr)
+    const bool rightCoercible = std::exchange(m_coercible, false);
 
     auto* left = ast.getLeft();
     auto* right = ast.getRight();
@@ -284,12 +362,12 @@ auto SemanticAnalyser::accept(AstBinaryExpr& ast) -> Result {
     const auto category = op.getCategory();
 
     if (category == TokenKind::Category::Arithmetic || category == TokenKind::Category::Comparison) {
-        // If types still differ and one is a literal, coerce the literal to match
+        // If types differ and one is a literal subtree, coerce it to match
         if (left->getType() != right->getType()) {
-            if (auto* leftLit = llvm::dyn_cast<AstLiteralExpr>(left)) {
-                TRY(coerceLiteral(*leftLit, right->getType()));
-            } else if (auto* rightLit = llvm::dyn_cast<AstLiteralExpr>(right)) {
-                TRY(coerceLiteral(*rightLit, left->getType()));
+            if (leftCoercible) {
+                TRY(coerce(*left, right->getType()));
+            } else if (rightCoercible) {
+                TRY(coerce(*right, left->getType()));
             } else if (const auto* commonType = left->getType()->common(right->getType())) {
                 auto* lhs = cast(*left, commonType);
                 ast.setLeft(lhs);
@@ -304,6 +382,7 @@ auto SemanticAnalyser::accept(AstBinaryExpr& ast) -> Result {
             ast.setType(getTypeFactory().getBool());
         } else {
             ast.setType(ast.getLeft()->getType());
+            m_coercible = leftCoercible && rightCoercible;
         }
     } else if (category == TokenKind::Category::Logical) {
         if (!left->getType()->isBool() || !right->getType()->isBool()) {
@@ -311,14 +390,26 @@ auto SemanticAnalyser::accept(AstBinaryExpr& ast) -> Result {
         }
         ast.setType(getTypeFactory().getBool());
     }
-    setSuggestedType(ast.getType());
+
+    // Literal operands are typed now, unless the whole expression is a literal subtree
+    if (not m_coercible) {
+        if (leftCoercible) {
+            ast.setLeft(foldLiterals(*ast.getLeft()));
+        }
+        if (rightCoercible) {
+            ast.setRight(foldLiterals(*ast.getRight()));
+        }
+    }
     return {};
 }
 
-// Analyse an explicit AS cast. Sets m_suggestedType so that sibling literals
+// Analyse an explicit AS cast. The cast fixes the type, so sibling literals
 // in parent binary expressions adopt the cast's target type.
 auto SemanticAnalyser::accept(AstCastExpr& ast) -> Result {
     TRY_EXPRESSION(ast, Expr, nullptr)
+    if (std::exchange(m_coercible, false)) {
+        ast.setExpr(foldLiterals(*ast.getExpr()));
+    }
     const auto* from = ast.getExpr()->getType();
 
     const Type* to = nullptr;
@@ -333,7 +424,6 @@ auto SemanticAnalyser::accept(AstCastExpr& ast) -> Result {
         return diag(diagnostics::typeMismatch(*from, *to), ast.getRange());
     }
     ast.setType(to);
-    setSuggestedType(to);
     return {};
 }
 
@@ -366,6 +456,9 @@ auto SemanticAnalyser::accept(AstCallExpr& ast) -> Result {
         // their natural type (no coercion target).
         const Type* target = i < params.size() ? params[i] : nullptr;
         TRY_ASSIGN(args[i], expression(*args[i], target));
+        if (std::exchange(m_coercible, false)) {
+            args[i] = foldLiterals(*args[i]);
+        }
     }
 
     const Type* rawRetType = funcType->getReturnType();
@@ -375,7 +468,7 @@ auto SemanticAnalyser::accept(AstCallExpr& ast) -> Result {
     if (rawRetType->isReference()) {
         ast.setValueCategory(ValueCategory::Addressable);
     }
-    setSuggestedType(ast.getType());
+    m_coercible = false;
     return {};
 }
 
@@ -0,0 +1,642 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include <cmath>
+#include <llvm/ADT/SmallVector.h>
+#include "SemanticAnalyser.hpp"
+#include "Symbol/Symbol.hpp"
+#include "Type/Aggregate.hpp"
+#include "Type/Numeric.hpp"
+using namespace lbc;
+
+// Constant folding evaluates an operation the way the generated code would:
+// integral arithmetic wraps at the width of the operand type, signed
+// division truncates towards zero, and SINGLE results are rounded to float.
+// Integral values are kept in LiteralValue's uint64 storage, sign-extended
+// for signed types, so equal values of a type always compare equal.
+
+namespace {
+
+/** Truncate @p value to the width of @p type, sign-extending signed types. */
+auto normalise(std::uint64_t value, const TypeIntegral& type) -> std::uint64_t {
+    const auto bits = type.getBits();
+    if (bits >= 64) {
+        return value;
+    }
+    const auto mask = (std::uint64_t { 1 } << bits) - 1;
+    value &= mask;
+    if (type.isSigned() && ((value >> (bits - 1)) & 1U) != 0) {
+        value |= ~mask;
+    }
+    return value;
+}
+
+/** Round @p value to the precision of @p type. */
+auto round(const double value, const TypeFloatingPoint& type) -> double {
+    if (type.getBits() == 32) {
+        return static_cast<double>(static_cast<float>(value));
+    }
+    return value;
+}
+
+/** Convert a floating point value to @p type, nullopt if it does not fit. */
+auto toIntegral(const double value, const TypeIntegral& type) -> std::optional<LiteralValue> {
+    if (not std::isfinite(value)) {
+        return std::nullopt;
+    }
+    const double truncated = std::trunc(value);
+    std::uint64_t bits = 0;
+    if (type.isSigned()) {
+        if (truncated < -0x1p63 || truncated >= 0x1p63) {
+            return std::nullopt;
+        }
+        bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(truncated));
+    } else {
+        if (truncated < 0 || truncated >= 0x1p64) {
+            return std::nullopt;
+        }
+        bits = static_cast<std::uint64_t>(truncated);
+    }
+    // out of range conversions have no defined result at run time
+    if (normalise(bits, type) != bits) {
+        return std::nullopt;
+    }
+    return LiteralValue::from(bits);
+}
+
+/**
+ * Convert @p value of type @p from to type @p to, the way a cast does.
+ * Returns nullopt for conversions that are not folded.
+ */
+auto convert(const LiteralValue& value, const Type* from, const Type* to) -> std::optional<LiteralValue> {
+    if (value.isIntegral()) {
+        const auto* source = llvm::dyn_cast<TypeIntegral>(from);
+        if (source == nullptr) {
+            return std::nullopt;
+        }
+        const auto bits = normalise(value.get<std::uint64_t>(), *source);
+        if (const auto* integral = llvm::dyn_cast<TypeIntegral>(to)) {
+            return LiteralValue::from(normalise(bits, *integral));
+        }
+        if (const auto* fp = llvm::dyn_cast<TypeFloatingPoint>(to)) {
+            const auto real = source->isSigned()
+                                ? static_cast<double>(static_cast<std::int64_t>(bits))
+                                : static_cast<double>(bits);
+            return LiteralValue::from(round(real, *fp));
+        }
+        return std::nullopt;
+    }
+
+    if (value.isFloatingPoint()) {
+        const auto real = value.get<double>();
+        if (const auto* fp = llvm::dyn_cast<TypeFloatingPoint>(to)) {
+            return LiteralValue::from(round(real, *fp));
+        }
+        if (const auto* integral = llvm::dyn_cast<TypeIntegral>(to)) {
+            return toIntegral(real, *integral);
+        }
+        return std::nullopt;
+    }
+
+    if (from == to || (value.isNull() && to->isPointer())) {
+        return value;
+    }
+    return std::nullopt;
+}
+
+/** Value of @p expr if it is a literal, converted to its type. */
+auto literalValue(const AstExpr& expr) -> std::optional<LiteralValue> {
+    if (const auto* literal = llvm::dyn_cast<AstLiteralExpr>(&expr)) {
+        return convert(literal->getValue(), literal->getType(), literal->getType());
+    }
+    return std::nullopt;
+}
+
+/** Compare two values of the same type with a comparison operator. */
+template<typename T>
+auto compare(const TokenKind op, const T lhs, const T rhs) -> std::optional<LiteralValue> {
+    switch (op.value()) {
+    case TokenKind::Equal:
+        return LiteralValue::from(lhs == rhs);
+    case TokenKind::NotEqual:
+        return LiteralValue::from(lhs != rhs);
+    case TokenKind::LessThan:
+        return LiteralValue::from(lhs < rhs);
+    case TokenKind::LessOrEqual:
+        return LiteralValue::from(lhs <= rhs);
+    case TokenKind::GreaterThan:
+        return LiteralValue::from(lhs > rhs);
+    case TokenKind::GreaterOrEqual:
+        return LiteralValue::from(lhs >= rhs);
+    default:
+        return std::nullopt;
+    }
+}
+
+/** Evaluate a binary operation on two integral values of @p type. */
+auto evaluate(const TokenKind op, const std::uint64_t lhs, const std::uint64_t rhs, const TypeIntegral& type) -> std::optional<LiteralValue> {
+    if (op.getCategory() == TokenKind::Category::Comparison) {
+        if (type.isSigned()) {
+            return compare(op, static_cast<std::int64_t>(lhs), static_cast<std::int64_t>(rhs));
+        }
+        return compare(op, lhs, rhs);
+    }
+
+    std::uint64_t result = 0;
+    switch (op.value()) {
+    case TokenKind::Plus:
+        result = lhs + rhs;
+        break;
+    case TokenKind::Minus:
+        result = lhs - rhs;
+        break;
+    case TokenKind::Multiply:
+        result = lhs * rhs;
+        break;
+    case TokenKind::Divide:
+    case TokenKind::Modulus: {
+        if (rhs == 0) {
+            return std::nullopt;
+        }
+        const bool divide = op == TokenKind::Divide;
+        if (type.isSigned()) {
+            const auto dividend = static_cast<std::int64_t>(lhs);
+            const auto divisor = static_cast<std::int64_t>(rhs);
+            // the smallest value divided by -1 overflows
+            const auto smallest = static_cast<std::int64_t>(normalise(std::uint64_t { 1 } << (type.getBits() - 1), type));
+            if (dividend == smallest && divisor == -1) {
+                return std::nullopt;
+            }
+            result = static_cast<std::uint64_t>(divide ? dividend / divisor : dividend % divisor);
+        } else {
+            result = divide ? lhs / rhs : lhs % rhs;
+        }
+        break;
+    }
+    default:
+        return std::nullopt;
+    }
+    return LiteralValue::from(normalise(result, type));
+}
+
+/** Evaluate a binary operation on two floating point values of @p type. */
+auto evaluate(const TokenKind op, const double lhs, const double rhs, const TypeFloatingPoint& type) -> std::optional<LiteralValue> {
+    if (op.getCategory() == TokenKind::Category::Comparison) {
+        // leave unordered comparisons to the target
+        if (std::isnan(lhs) || std::isnan(rhs)) {
+            return std::nullopt;
+        }
+        return compare(op, lhs, rhs);
+    }
+
+    switch (op.value()) {
+    case TokenKind::Plus:
+        return LiteralValue::from(round(lhs + rhs, type));
+    case TokenKind::Minus:
+        return LiteralValue::from(round(lhs - rhs, type));
+    case TokenKind::Multiply:
+        return LiteralValue::from(round(lhs * rhs, type));
+    case TokenKind::Divide:
+        return LiteralValue::from(round(lhs / rhs, type));
+    case TokenKind::Modulus:
+        return LiteralValue::from(round(std::fmod(lhs, rhs), type));
+    default:
+        return std::nullopt;
+    }
+}
+
+/** Evaluate a binary operation on two values of @p type. */
+auto evaluate(const TokenKind op, const LiteralValue& lhs, const LiteralValue& rhs, const Type* type) -> std::optional<LiteralValue> {
+    if (const auto* integral = llvm::dyn_cast<TypeIntegral>(type)) {
+        return evaluate(op, lhs.get<std::uint64_t>(), rhs.get<std::uint64_t>(), *integral);
+    }
+    if (const auto* fp = llvm::dyn_cast<TypeFloatingPoint>(type)) {
+        return evaluate(op, lhs.get<double>(), rhs.get<double>(), *fp);
+    }
+    if (lhs.isBool() && rhs.isBool()) {
+        switch (op.value()) {
+        case TokenKind::LogicalAnd:
+            return LiteralValue::from(lhs.get<bool>() && rhs.get<bool>());
+        case TokenKind::LogicalOr:
+            return LiteralValue::from(lhs.get<bool>() || rhs.get<bool>());
+        case TokenKind::Equal:
+        case TokenKind::NotEqual:
+            return compare(op, lhs.get<bool>(), rhs.get<bool>());
+        default:
+            return std::nullopt;
+        }
+    }
+    if (lhs.isNull() && rhs.isNull()) {
+        return compare(op, 0, 0);
+    }
+    return std::nullopt;
+}
+
+/** Evaluate a unary operation on a value of @p type. */
+auto evaluate(const TokenKind op, const LiteralValue& value, const Type* type) -> std::optional<LiteralValue> {
+    if (op == TokenKind::LogicalNot && value.isBool()) {
+        return LiteralValue::from(not value.get<bool>());
+    }
+    if (op != TokenKind::Negate) {
+        return std::nullopt;
+    }
+    if (const auto* integral = llvm::dyn_cast<TypeIntegral>(type)) {
+        return LiteralValue::from(normalise(std::uint64_t { 0 } - value.get<std::uint64_t>(), *integral));
+    }
+    if (const auto* fp = llvm::dyn_cast<TypeFloatingPoint>(type)) {
+        return LiteralValue::from(round(-value.get<double>(), *fp));
+    }
+    return std::nullopt;
+}
+
+/** Value of a variable of @p type that is not initialised, nullopt if not evaluated. */
+auto zero(const Type* type) -> std::optional<LiteralValue> {
+    if (llvm::isa<TypeIntegral>(type)) {
+        return LiteralValue::from(std::uint64_t { 0 });
+    }
+    if (llvm::isa<TypeFloatingPoint>(type)) {
+        return LiteralValue::from(0.0);
+    }
+    if (type->isBool()) {
+        return LiteralValue::from(false);
+    }
+    if (type->isPointer()) {
+        return LiteralValue {};
+    }
+    return std::nullopt;
+}
+
+/**
+ * Interpreter running analysed SUB and FUNCTION bodies at compile time.
+ *
+ * Expressions are evaluated with the same operations fold() uses, so
+ * a value computed here is the value the generated code would compute.
+ * Parameters and locals live in a frame per call. Reading anything else
+ * than a constant, a parameter or a local, calling a function without an
+ * analysed body, or exceeding a limit fails the whole evaluation.
+ */
+class Interpreter final {
+public:
+    /// Finds the analysed body of a function, null if it has none
+    using BodyResolver = llvm::function_ref<const AstFuncStmt*(const Symbol*)>;
+
+    explicit Interpreter(const BodyResolver bodies)
+    : m_bodies(bodies) {}
+
+    /**
+     * Evaluate @p ast, nullopt if it cannot be evaluated. Operands are
+     * evaluated in post-order with explicit stacks, so a long chain of them
+     * does not recurse once per term. Only calls nest, up to kEvaluationDepth.
+     */
+    auto value(const AstExpr& ast) -> std::optional<LiteralValue> {
+        llvm::SmallVector<std::pair<const AstExpr*, bool>, 16> pending { { &ast, false } };
+        llvm::SmallVector<LiteralValue, 16> values;
+        while (not pending.empty()) {
+            const auto [expr, visited] = pending.pop_back_val();
+            if (not visited) {
+                if (not step()) {
+                    return std::nullopt;
+                }
+                if (const auto* unary = llvm::dyn_cast<AstUnaryExpr>(expr)) {
+                    pending.emplace_back(expr, true);
+                    pending.emplace_back(unary->getExpr(), false);
+                } else if (const auto* binary = llvm::dyn_cast<AstBinaryExpr>(expr)) {
+                    pending.emplace_back(expr, true);
+                    pending.emplace_back(binary->getRight(), false);
+                    pending.emplace_back(binary->getLeft(), false);
+                } else if (const auto* cast = llvm::dyn_cast<AstCastExpr>(expr)) {
+                    pending.emplace_back(expr, true);
+                    pending.emplace_back(cast->getExpr(), false);
+                } else if (const auto leaf = operand(*expr)) {
+                    values.push_back(*leaf);
+                } else {
+                    return std::nullopt;
+                }
+                continue;
+            }
+
+            std::optional<LiteralValue> result;
+            if (const auto* unary = llvm::dyn_cast<AstUnaryExpr>(expr)) {
+                result = evaluate(unary->getOp(), values.pop_back_val(), unary->getType());
+            } else if (const auto* binary = llvm::dyn_cast<AstBinaryExpr>(expr)) {
+                const auto rhs = values.pop_back_val();
+                const auto lhs = values.pop_back_val();
+                result = evaluate(binary->getOp(), lhs, rhs, binary->getLeft()->getType());
+            } else {
+                const auto* cast = llvm::cast<AstCastExpr>(expr);
+                result = convert(values.pop_back_val(), cast->getExpr()->getType(), cast->getType());
+            }
+            if (not result) {
+                return std::nullopt;
+            }
+            values.push_back(*result);
+        }
+        return values.back();
+    }
+
+private:
+    /// Parameters and locals of a call, by symbol
+    using Frame = llvm::SmallDenseMap<const Symbol*, LiteralValue, 8>;
+
+    /// How a statement completed
+    enum class Flow : std::uint8_t {
+        Next,   ///< continue with the next statement
+        Return, ///< the body returned m_result
+        Fail,   ///< the statement cannot be evaluated
+    };
+
+    /** Count one evaluation step, false once the budget is spent. */
+    auto step() -> bool {
+        if (m_steps == SemanticAnalyser::kEvaluationSteps) {
+            return false;
+        }
+        m_steps++;
+        return true;
+    }
+
+    /** Value of an expression without operands: a literal, a variable or a call. */
+    auto operand(const AstExpr& ast) -> std::optional<LiteralValue> {
+        if (const auto* literal = llvm::dyn_cast<AstLiteralExpr>(&ast)) {
+            return literalValue(*literal);
+        }
+        if (const auto* var = llvm::dyn_cast<AstVarExpr>(&ast)) {
+            return variable(*var->getSymbol());
+        }
+        if (const auto* call = llvm::dyn_cast<AstCallExpr>(&ast)) {
+            return invoke(*call);
+        }
+        return std::nullopt;
+    }
+
+    /** Value of a constant, or of a parameter or local of the current call. */
+    auto variable(const Symbol& symbol) const -> std::optional<LiteralValue> {
+        if (symbol.hasFlag(SymbolFlags::Constant)) {
+            return symbol.getValue();
+        }
+        if (m_frame != nullptr) {
+            if (const auto iter = m_frame->find(&symbol); iter != m_frame->end()) {
+                return iter->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /** Bind a new parameter or local @p symbol in the current frame. */
+    auto bind(const Symbol& symbol, const LiteralValue& value) -> bool {
+        if (m_values == SemanticAnalyser::kEvaluationValues) {
+            return false;
+        }
+        m_values++;
+        (*m_frame)[&symbol] = value;
+        return true;
+    }
+
+    /** Run the body of the function @p ast calls. */
+    auto invoke(const AstCallExpr& ast) -> std::optional<LiteralValue> {
+        const auto* callee = llvm::dyn_cast<AstVarExpr>(ast.getCallee());
+        if (callee == nullptr || m_depth == SemanticAnalyser::kEvaluationDepth) {
+            return std::nullopt;
+        }
+        const auto* found = m_bodies(callee->getSymbol());
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        const auto& body = *found;
+        const auto* returnType = llvm::cast<TypeFunction>(body.getDecl()->getType())->getReturnType();
+        const auto params = body.getDecl()->getParams();
+        if (returnType->isReference() || ast.getArgs().size() != params.size()) {
+            return std::nullopt;
+        }
+
+        // arguments are evaluated in the caller's frame
+        llvm::SmallVector<LiteralValue, 4> args;
+        for (const auto* arg : ast.getArgs()) {
+            const auto argument = value(*arg);
+            if (not argument) {
+                return std::nullopt;
+            }
+            args.push_back(*argument);
+        }
+
+        // the callee's values are released when it returns
+        const ValueRestorer restore { m_frame, m_depth, m_values, m_result };
+        Frame frame;
+        m_frame = &frame;
+        m_depth++;
+        m_result.reset();
+        for (std::size_t index = 0; index < params.size(); index++) {
+            const auto* symbol = params[index]->getSymbol();
+            if (symbol->getType()->isReference() || not bind(*symbol, args[index])) {
+                return std::nullopt;
+            }
+        }
+
+        switch (execute(*body.getStmtList())) {
+        case Flow::Return:
+            return m_result;
+        case Flow::Next:
+            // a SUB may end without RETURN, a FUNCTION would return garbage
+            if (returnType->isVoid()) {
+                return LiteralValue {};
+            }
+            return std::nullopt;
+        case Flow::Fail:
+            return std::nullopt;
+        }
+        std::unreachable();
+    }
+
+    /** Run a statement of the current call. */
+    auto execute(const AstStmt& ast) -> Flow {
+        if (not step()) {
+            return Flow::Fail;
+        }
+
+        if (const auto* list = llvm::dyn_cast<AstStmtList>(&ast)) {
+            for (const auto* stmt : list->getStmts()) {
+                if (const auto flow = execute(*stmt); flow != Flow::Next) {
+                    return flow;
+                }
+            }
+            return Flow::Next;
+        }
+
+        if (const auto* dim = llvm::dyn_cast<AstDimStmt>(&ast)) {
+            for (const auto* decl : dim->getDecls()) {
+                const auto* symbol = decl->getSymbol();
+                if (symbol->getType()->isReference()) {
+                    return Flow::Fail;
+                }
+                const auto init = decl->getExpr() != nullptr ? value(*decl->getExpr()) : zero(symbol->getType());
+                if (not init || not bind(*symbol, *init)) {
+                    return Flow::Fail;
+                }
+            }
+            return Flow::Next;
+        }
+
+        // uses of a constant are folded already
+        if (llvm::isa<AstConstStmt>(&ast)) {
+            return Flow::Next;
+        }
+
+        if (const auto* assign = llvm::dyn_cast<AstAssignStmt>(&ast)) {
+            const auto* target = llvm::dyn_cast<AstVarExpr>(assign->getAssignee());
+            const auto result = value(*assign->getExpr());
+            if (target == nullptr || not result) {
+                return Flow::Fail;
+            }
+            const auto iter = m_frame->find(target->getSymbol());
+            if (iter == m_frame->end()) {
+                return Flow::Fail;
+            }
+            iter->second = *result;
+            return Flow::Next;
+        }
+
+        if (const auto* stmt = llvm::dyn_cast<AstExprStmt>(&ast)) {
+            return value(*stmt->getExpr()) ? Flow::Next : Flow::Fail;
+        }
+
+        if (const auto* ret = llvm::dyn_cast<AstReturnStmt>(&ast)) {
+            m_result = ret->getExpr() != nullptr ? value(*ret->getExpr()) : LiteralValue {};
+            return m_result ? Flow::Return : Flow::Fail;
+        }
+
+        return Flow::Fail;
+    }
+
+    BodyResolver m_bodies;                ///< bodies that may be called
+    Frame* m_frame = nullptr;             ///< frame of the current call
+    std::optional<LiteralValue> m_result; ///< value the current call returns
+    std::size_t m_steps = 0;              ///< steps taken so far
+    std::size_t m_depth = 0;              ///< calls in progress
+    std::size_t m_values = 0;             ///< values bound in all frames
+};
+
+} // namespace
+
+auto SemanticAnalyser::fold(AstExpr& ast) const -> AstExpr* {
+    std::optional<LiteralValue> value;
+    // A folded literal analyses to the same type again, unless it stands
+    // for a constant without a type, which coerces like a literal.
+    bool untyped = false;
+
+    if (const auto* var = llvm::dyn_cast<AstVarExpr>(&ast)) {
+        if (const auto* symbol = var->getSymbol(); symbol->hasFlag(SymbolFlags::Constant)) {
+            value = symbol->getValue();
+            untyped = symbol->hasFlag(SymbolFlags::Untyped);
+        }
+    } else if (auto* unary = llvm::dyn_cast<AstUnaryExpr>(&ast)) {
+        if (const auto operand = literalValue(*unary->getExpr())) {
+            value = evaluate(unary->getOp(), *operand, unary->getType());
+        }
+    } else if (auto* binary = llvm::dyn_cast<AstBinaryExpr>(&ast)) {
+        // Operands are folded already, but may have been wrapped in implicit
+        // casts to their common type since. Folding only those keeps a chain
+        // from being folded again, recursively, at every term.
+        if (llvm::isa<AstCastExpr>(binary->getLeft())) {
+            binary->setLeft(fold(*binary->getLeft()));
+        }
+        if (llvm::isa<AstCastExpr>(binary->getRight())) {
+            binary->setRight(fold(*binary->getRight()));
+        }
+        const auto lhs = literalValue(*binary->getLeft());
+        const auto rhs = literalValue(*binary->getRight());
+        if (lhs && rhs) {
+            value = evaluate(binary->getOp(), *lhs, *rhs, binary->getLeft()->getType());
+        }
+    } else if (auto* cast = llvm::dyn_cast<AstCastExpr>(&ast)) {
+        if (const auto operand = literalValue(*cast->getExpr())) {
+            value = convert(*operand, cast->getExpr()->getType(), cast->getType());
+        }
+    }
+
+    if (not value) {
+        return &ast;
+    }
+    return makeLiteral(ast, *value, untyped);
+}
+
+// A literal subtree holds only literals, negation and arithmetic, see
+// coerce(). Fold it in post-order with an explicit stack, so a long chain
+// like `1 + 2 + ... + n` does not recurse once per term.
+auto SemanticAnalyser::foldLiterals(AstExpr& ast) const -> AstExpr* {
+    llvm::SmallVector<std::pair<AstExpr*, bool>, 16> pending { { &ast, false } };
+    llvm::SmallVector<AstExpr*, 16> folded;
+    while (!pending.empty()) {
+        const auto [expr, visited] = pending.pop_back_val();
+        auto* unary = llvm::dyn_cast<AstUnaryExpr>(expr);
+        auto* binary = llvm::dyn_cast<AstBinaryExpr>(expr);
+
+        if (visited) {
+            if (unary != nullptr) {
+                unary->setExpr(folded.pop_back_val());
+            } else {
+                binary->setRight(folded.pop_back_val());
+                binary->setLeft(folded.pop_back_val());
+            }
+            folded.push_back(fold(*expr));
+        } else if (unary != nullptr) {
+            pending.emplace_back(expr, true);
+            pending.emplace_back(unary->getExpr(), false);
+        } else if (binary != nullptr) {
+            pending.emplace_back(expr, true);
+            pending.emplace_back(binary->getRight(), false);
+            pending.emplace_back(binary->getLeft(), false);
+        } else {
+            folded.push_back(fold(*expr));
+        }
+    }
+    return folded.back();
+}
+
+// Evaluated code does not run, so what an evaluated initialiser uses is not
+// referenced: a function only called to compute a table is not lowered.
+// A callee whose body is waiting for its turn, later in the current run or
+// deferred, is analysed when first called; if that fails, so does the
+// initialiser, with the diagnostics of the body.
+auto SemanticAnalyser::evaluateInitialiser(AstExpr& ast, const std::span<const Symbol* const> uses) -> DiagResult<AstExpr*> {
+    if (llvm::isa<AstLiteralExpr>(&ast)) {
+        return &ast;
+    }
+
+    Result analysed {};
+    const auto resolve = [&](const Symbol* symbol) -> const AstFuncStmt* {
+        if (const auto iter = m_evaluable->find(symbol); iter != m_evaluable->end()) {
+            return iter->second;
+        }
+        const auto iter = m_waitingBodies.find(symbol);
+        if (iter == m_waitingBodies.end() || not analysed) {
+            return nullptr;
+        }
+        auto* body = iter->second;
+        analysed = analyseOnDemand(*body);
+        return analysed ? body : nullptr;
+    };
+
+    Interpreter interpreter { resolve };
+    const auto value = interpreter.value(ast);
+    TRY(analysed)
+    if (value) {
+        return makeLiteral(ast, *value, false);
+    }
+
+    for (const auto* symbol : uses) {
+        m_references->reference(m_definition, *symbol);
+    }
+    return &ast;
+}
+
+auto SemanticAnalyser::makeLiteral(AstExpr& ast, const LiteralValue& value, const bool untyped) const -> AstLiteralExpr* {
+    const auto* type = ast.getType();
+    const auto suffix = untyped ? TokenKind::Invalid : type->getTokenKind().value_or(TokenKind::Invalid);
+    auto* literal = make<AstLiteralExpr>(ast.getRange(), value, suffix);
+    literal->setType(type);
+    literal->setOriginal(&ast);
+    return literal;
+}
+
+auto SemanticAnalyser::constantValue(const AstLiteralExpr& ast) -> std::optional<LiteralValue> {
+    return literalValue(ast);
+}
@@ -1,20 +1,27 @@
 //
 // Created by Albert Varaksin on 19/02/2026.
 //
+#include "Ast/AstImage.hpp"
+#include "Driver/Context.hpp"
 #include "SemanticAnalyser.hpp"
 #include "Symbol/Symbol.hpp"
 #include "Type/Aggregate.hpp"
 using namespace lbc;
 
 auto SemanticAnalyser::accept(AstStmtList& ast) -> Result {
-    const ValueRestorer restore { m_symbolTable };
+    // Enter the symbol table (scope)
+    auto* symbolTable = ast.getSymbolTable();
+    if (symbolTable == nullptr) {
+        symbolTable = create<SymbolTable>(m_bindings.getTable());
+        ast.setSymbolTable(symbolTable);
+    }
+    const auto scope = m_bindings.enter(*symbolTable);
 
-    // Set active symbol table (scope)
-    if (auto* symbolTable = ast.getSymbolTable()) {
-        m_symbolTable = symbolTable;
-    } else {
-        m_symbolTable = m_context.create<SymbolTable>(m_symbolTable);
-        ast.setSymbolTable(m_symbolTable);
+    // imported symbols, declared before the module's own
+    for (auto* stmt : ast.getStmts()) {
+        if (auto* import = llvm::dyn_cast<AstImport>(stmt)) {
+            TRY(importModule(*import))
+        }
     }
 
     // declare symbols
@@ -29,7 +36,25 @@ auto SemanticAnalyser::accept(AstStmtList& ast) -> Result {
         }
     }
 
-    // process statements
+    // module level definitions are lowered only if reachable, exported ones always are
+    if (m_returnType == nullptr) {
+        const auto exported = m_context.getOptions().isEmitInterface();
+        for (auto* stmt : ast.getStmts()) {
+            if (const auto* func = llvm::dyn_cast<AstFuncStmt>(stmt)) {
+                auto* symbol = func->getDecl()->getSymbol();
+                m_references->add(*symbol, exported || symbol->getVisibility() == SymbolVisibility::External);
+            } else if (const auto* dim = llvm::dyn_cast<AstDimStmt>(stmt)) {
+                for (auto* decl : dim->getDecls()) {
+                    m_references->add(*decl->getSymbol(), false);
+                }
+            }
+        }
+    }
+
+    // process statements, module level bodies possibly in parallel
+    if (m_returnType == nullptr && !m_bodyLoader) {
+        return analyseStatements(ast.getStmts());
+    }
     for (auto& stmt : ast.getStmts()) {
         TRY(visit(*stmt));
     }
@@ -49,17 +74,76 @@ auto SemanticAnalyser::accept(AstDeclareStmt& /*ast*/) -> Result {
 }
 
 auto SemanticAnalyser::accept(AstFuncStmt& ast) -> Result {
+    // A deferred body waits until the function is known to be reachable.
+    if (ast.getDeferred()) {
+        assert(m_bodyLoader && "deferred body without a body loader");
+        const auto* symbol = ast.getDecl()->getSymbol();
+        if (m_referenced.contains(symbol) || symbol->getVisibility() == SymbolVisibility::External) {
+            m_pendingBodies.push_back(&ast);
+        } else {
+            m_deferredBodies.try_emplace(symbol, &ast);
+        }
+        m_waitingBodies.try_emplace(symbol, &ast);
+        return {};
+    }
+
     const auto* funcType = llvm::cast<TypeFunction>(ast.getDecl()->getType());
 
     // Track the active return type so RETURN statements within the body can be
     // checked. The body's scope — already populated with the parameters by the
     // function declaration — is analysed here.
-    const ValueRestorer restore { m_returnType };
+    const ValueRestorer restore { m_returnType, m_definition };
     m_returnType = funcType->getReturnType();
+    m_definition = ast.getDecl()->getSymbol();
 
     return accept(*ast.getStmtList());
 }
 
+void SemanticAnalyser::reference(const Symbol& symbol) {
+    if (not m_referenced.insert(&symbol).second) {
+        return;
+    }
+    if (const auto iter = m_deferredBodies.find(&symbol); iter != m_deferredBodies.end()) {
+        m_pendingBodies.push_back(iter->second);
+        m_deferredBodies.erase(iter);
+    }
+}
+
+auto SemanticAnalyser::analyseDeferredBodies() -> Result {
+    // Analysing a body may queue more, so the queue grows while it is drained.
+    // Bodies analysed on demand are already done.
+    for (std::size_t index = 0; index < m_pendingBodies.size(); index++) {
+        auto& ast = *m_pendingBodies[index];
+        if (not m_evaluable->contains(ast.getDecl()->getSymbol())) {
+            TRY(analyseBody(ast))
+        }
+    }
+    m_pendingBodies.clear();
+    return {};
+}
+
+auto SemanticAnalyser::analyseBody(AstFuncStmt& ast) -> Result {
+    const auto* symbol = ast.getDecl()->getSymbol();
+    m_waitingBodies.erase(symbol);
+    if (ast.getDeferred()) {
+        TRY(m_bodyLoader(ast))
+    }
+    TRY(accept(ast))
+    m_evaluable->try_emplace(symbol, &ast);
+    return {};
+}
+
+auto SemanticAnalyser::analyseOnDemand(AstFuncStmt& ast) -> Result {
+    // The body is analysed as it would be from the statement list of its
+    // module: in module scope, outside any initialiser or EXTERN block.
+    const auto suspension = m_bindings.suspend();
+    const ValueRestorer restore { m_initialiserUses, m_externKind, m_coercible };
+    m_initialiserUses = nullptr;
+    m_externKind = ExternKind::Default;
+    m_coercible = false;
+    return analyseBody(ast);
+}
+
 auto SemanticAnalyser::accept(AstReturnStmt& ast) -> Result {
     // RETURN is only valid inside a function or subroutine body.
     if (m_returnType == nullptr) {
@@ -87,6 +171,13 @@ auto SemanticAnalyser::accept(const AstDimStmt& ast) -> Result {
     return {};
 }
 
+auto SemanticAnalyser::accept(const AstConstStmt& ast) -> Result {
+    for (auto* decl : ast.getDecls()) {
+        TRY(define(*decl));
+    }
+    return {};
+}
+
 auto SemanticAnalyser::accept(AstAssignStmt& ast) -> Result {
     TRY(visit(*ast.getAssignee()))
     TRY(ensureAssignable(*ast.getAssignee()))
@@ -114,3 +205,38 @@ auto SemanticAnalyser::accept(const AstExtern& ast) -> Result {
     }
     return {};
 }
+
+auto SemanticAnalyser::accept(const AstImport& /*ast*/) -> Result {
+    /* NO OP, handled in stmtList */
+    return {};
+}
+
+auto SemanticAnalyser::importModule(AstImport& ast) -> Result {
+    if (m_returnType != nullptr) {
+        return diag(diagnostics::importOutsideModule(), ast.getRange());
+    }
+
+    const auto path = m_context.findInterface(ast.getName());
+    if (path.empty()) {
+        return diag(diagnostics::moduleNotFound(ast.getName()), ast.getRange());
+    }
+
+    auto& module = m_imports[path];
+    if (module == nullptr) {
+        AstImageReader reader { m_context };
+        TRY_ASSIGN(module, reader.load(path))
+    }
+    ast.setModule(module);
+
+    for (auto* decl : module->getStmtList()->getDecls()) {
+        auto* symbol = decl->getSymbol();
+        if (const auto* existing = m_bindings.findLocal(symbol->getName())) {
+            if (existing == symbol) {
+                continue;
+            }
+            return diag(diagnostics::redefinition(symbol->getName()), ast.getRange());
+        }
+        m_bindings.declare(symbol);
+    }
+    return {};
+}
@@ -3,13 +3,24 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <memory>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/STLFunctionalExtras.h>
 #include "Ast/Ast.hpp"
+#include "Ast/AstArena.hpp"
 #include "Ast/AstVisitor.hpp"
 #include "Diag/DiagEngine.hpp"
 #include "Diag/LogProvider.hpp"
 #include "Symbol/ExternKind.hpp"
+#include "Symbol/ReferenceGraph.hpp"
+#include "Symbol/ScopeBindings.hpp"
 namespace lbc {
 class Context;
+class DiagBuffer;
+class Symbol;
 class SymbolTable;
 
 /**
@@ -31,8 +42,22 @@ class SymbolTable;
 
 /**
  * Semantic analyser. Implementation is split across multiple
- * .cpp files by concern: SemaDecl, SemaExpr, SemaStmt,
- * SemaType, and Sema.cpp for common utilities.
+ * .cpp files by concern: SemaBodies, SemaDecl, SemaExpr, SemaFold,
+ * SemaStmt, SemaType, and Sema.cpp for common utilities.
+ *
+ * The bodies of consecutive top-level SUB and FUNCTION definitions only
+ * read the module scope, so enough of them are analysed concurrently by
+ * worker analysers, each allocating from its own arena and recording its
+ * diagnostics in its own buffer. The buffers are logged in source order,
+ * so the error reported is the one serial analysis would report.
+ *
+ * Uses of module level definitions are recorded in a ReferenceGraph, and
+ * once the module is analysed the definitions that nothing reachable uses
+ * are flagged as unreachable, so that they are not lowered.
+ *
+ * Initialisers of constants and module level variables may call analysed
+ * functions, which are then run at compile time (see SemaFold.cpp), so the
+ * value is static data instead of code in the global initialisation.
  */
 class SemanticAnalyser final : LogProvider, AstVisitor<DiagResult<void>> {
 public:
@@ -44,24 +69,69 @@ public:
     explicit SemanticAnalyser(Context& context);
     ~SemanticAnalyser() override;
 
+    /// Least number of consecutive SUB / FUNCTION bodies worth analysing in parallel
+    static constexpr std::size_t kParallelBodies = 16;
+
+    /// Bodies analysed by one worker task, so small bodies share an arena and an analyser
+    static constexpr std::size_t kBodiesPerTask = 8;
+
+    /// Most expressions and statements run to evaluate one initialiser at compile time
+    static constexpr std::size_t kEvaluationSteps = 100000;
+
+    /// Deepest nesting of calls evaluated at compile time
+    static constexpr std::size_t kEvaluationDepth = 64;
+
+    /// Most parameters and locals alive at once while evaluating at compile time
+    static constexpr std::size_t kEvaluationValues = 4096;
+
+    /// Parses the body of a deferred definition, see Parser::parseBody
+    using BodyLoader = llvm::function_ref<DiagResult<void>(AstFuncStmt&)>;
+
     /**
      * Run semantic analysis on the given AST module.
+     *
+     * Definitions whose body was deferred by a lazy parser are analysed only
+     * once reachable: when a function is referenced from module code or from
+     * another analysed body, or when it has external visibility. Their bodies
+     * are parsed through @param loader first. Bodies never reached stay
+     * deferred, and are neither analysed nor lowered.
+     *
+     * Afterwards SUB, FUNCTION and module level variable definitions that
+     * are not reachable from top-level code or from an exported definition
+     * are flagged with SymbolFlags::Unreachable, and reported under -verbose.
      */
-    [[nodiscard]] auto analyse(const AstModule& ast) -> Result;
+    [[nodiscard]] auto analyse(const AstModule& ast, BodyLoader loader = {}) -> Result;
 
     /**
      * Get associated context object.
      */
     [[nodiscard]] auto getContext() const -> Context& { return m_context; }
 
+    /**
+     * Get the buffer diagnostics are recorded in, which is the case for the
+     * workers analysing bodies in parallel. Null when they are logged.
+     */
+    [[nodiscard]] auto getDiagBuffer() const -> DiagBuffer* { return m_diagBuffer; }
+
 private:
     friend AstVisitor;
 
+    /**
+     * Construct a worker analyser for the bodies of @param parent's module,
+     * allocating from @param arena and recording diagnostics in @param diagnostics.
+     * Its bindings are layered over the parent's, which must stay in the module
+     * scope until the worker is done.
+     */
+    SemanticAnalyser(const SemanticAnalyser& parent, AstArena& arena, DiagBuffer& diagnostics);
+
     [[nodiscard]] auto getTypeFactory() const -> TypeFactory& { return m_context.getTypeFactory(); }
 
     /** Analyse the module root node. */
     [[nodiscard]] auto accept(const AstModule& ast) -> Result;
 
+    /** Flag the unreachable definitions, reporting them if verbose. */
+    void removeUnreachable();
+
     // -------------------------------------------------------------------------
     // Declarations (SemaDecl.cpp)
     // -------------------------------------------------------------------------
@@ -79,6 +149,12 @@ private:
     /** Analyse a variable declaration. */
     [[nodiscard]] auto accept(AstVarDecl& ast) -> Result;
 
+    /**
+     * Analyse a constant declaration. The initialiser must fold to a
+     * literal, whose value the symbol keeps.
+     */
+    [[nodiscard]] auto accept(AstConstDecl& ast) -> Result;
+
     /** Analyse a function declaration. */
     [[nodiscard]] auto accept(AstFuncDecl& ast) -> Result;
 
@@ -101,12 +177,40 @@ private:
     /** Analyse a function body statement. */
     [[nodiscard]] auto accept(AstFuncStmt& ast) -> Result;
 
+    /**
+     * Note a reference to a function symbol. Queues the function's deferred
+     * body for analysis the first time it is referenced.
+     */
+    void reference(const Symbol& symbol);
+
+    /**
+     * Parse and analyse the queued deferred bodies, including those queued
+     * while analysing them, until no reachable body is left.
+     */
+    [[nodiscard]] auto analyseDeferredBodies() -> Result;
+
+    /**
+     * Analyse the body of @p ast, parsing it first if it is deferred, and
+     * make it callable by initialisers evaluated at compile time.
+     */
+    [[nodiscard]] auto analyseBody(AstFuncStmt& ast) -> Result;
+
+    /**
+     * Analyse a body that is waiting for its turn because an initialiser
+     * evaluated at compile time calls it. It is analysed in module scope
+     * with the scopes being analysed suspended, as if its turn had come.
+     */
+    [[nodiscard]] auto analyseOnDemand(AstFuncStmt& ast) -> Result;
+
     /** Analyse a RETURN statement. */
     [[nodiscard]] auto accept(AstReturnStmt& ast) -> Result;
 
     /** Analyse a DIM statement. */
     [[nodiscard]] auto accept(const AstDimStmt& ast) -> Result;
 
+    /** Analyse a CONST statement. */
+    [[nodiscard]] auto accept(const AstConstStmt& ast) -> Result;
+
     /** Analyse an assignment statement. */
     [[nodiscard]] auto accept(AstAssignStmt& ast) -> Result;
 
@@ -116,6 +220,37 @@ private:
     /** Analyse an EXTERN linkage block, resolving the linkage of its declarations. */
     [[nodiscard]] auto accept(const AstExtern& ast) -> Result;
 
+    /** Analyse an IMPORT statement. */
+    [[nodiscard]] static auto accept(const AstImport& ast) -> Result;
+
+    /**
+     * Load the interface of an imported module and declare the functions it
+     * exports in the current scope. A module imported again reuses the
+     * interface loaded first.
+     */
+    [[nodiscard]] auto importModule(AstImport& ast) -> Result;
+
+    // -------------------------------------------------------------------------
+    // Parallel bodies (SemaBodies.cpp)
+    // -------------------------------------------------------------------------
+
+    /**
+     * Analyse the statements of the module in order, collecting the bodies of
+     * consecutive definitions and analysing them together with analyseBodies().
+     */
+    [[nodiscard]] auto analyseStatements(std::span<AstStmt*> stmts) -> Result;
+
+    /**
+     * Analyse function bodies that are free to run in any order, on worker
+     * threads if there are at least kParallelBodies of them. Bodies that
+     * declare constants may evaluate calls to the others at compile time, so
+     * they are analysed serially and split the run into parts.
+     */
+    [[nodiscard]] auto analyseBodies(std::span<AstFuncStmt*> bodies) -> Result;
+
+    /** Analyse function bodies on worker threads, see analyseBodies(). */
+    [[nodiscard]] auto analyseInParallel(std::span<AstFuncStmt*> bodies) -> Result;
+
     // -------------------------------------------------------------------------
     // Expressions (SemaExpr.cpp)
     // -------------------------------------------------------------------------
@@ -123,9 +258,9 @@ private:
     /**
      * Analyse an expression, applying implicit type coercion if needed.
      *
-     * Saves and restores m_explicitType / m_suggestedType via ValueRestorer.
-     * After the expression visitor runs, if the result type differs from
-     * @p implicitType the expression is wrapped in an implicit cast.
+     * Each node is visited once. If the result type differs from
+     * @p explicitType, a literal subtree is re-typed in place and any other
+     * expression is wrapped in an implicit cast.
      *
      * @param ast          The expression AST node to analyse.
      * @param explicitType Target type for coercion, or nullptr if unconstrained.
@@ -148,18 +283,21 @@ private:
     /** Analyse a unary expression. */
     [[nodiscard]] auto accept(AstUnaryExpr& ast) -> Result;
 
-    /** Analyse a binary expression. */
+    /** Analyse a binary expression, and the chain of them on its left. */
     [[nodiscard]] auto accept(AstBinaryExpr& ast) -> Result;
 
+    /** Analyse a binary expression whose left operand is already analysed. */
+    [[nodiscard]] auto binary(AstBinaryExpr& ast) -> Result;
+
     /** Analyse a member access expression. */
     [[nodiscard]] auto accept(AstMemberExpr& ast) -> Result;
 
     /**
-     * Try literal coercion first, then fall back to implicit cast.
-     * For literals this may simply re-type the node (no cast node needed);
-     * for non-literals it inserts an implicit cast if the types are convertible.
+     * Re-type a literal subtree (see m_coercible) to the target type, top-down
+     * in a single walk. Fails if a literal does not coerce, or if a negation
+     * is re-typed to anything but a signed integral or floating-point type.
      */
-    [[nodiscard]] auto castOrCoerce(AstExpr& ast, const Type* targetType) -> DiagResult<AstExpr*>;
+    [[nodiscard]] auto coerce(AstExpr& ast, const Type* targetType) -> Result;
 
     /**
      * Wrap the expression in an implicit AstCastExpr targeting the given type.
@@ -167,6 +305,12 @@ private:
      */
     [[nodiscard]] auto cast(AstExpr& ast, const Type* targetType) const -> AstExpr*;
 
+    /**
+     * Get the expression the parser built in the place of @p ast, following
+     * the expressions analysis replaced, see AstExpr::getOriginal().
+     */
+    [[nodiscard]] static auto parsed(AstExpr& ast) -> AstExpr*;
+
     /**
      * Re-type a literal to match the target type within the same type family.
      * Integral literals can adopt any integral type, float literals any float
@@ -174,14 +318,6 @@ private:
      */
     [[nodiscard]] auto coerceLiteral(AstLiteralExpr& ast, const Type* targetType) -> Result;
 
-    /**
-     * Record a type suggestion that propagates upward through the expression tree.
-     * Set by any typed sub-expression (variables, literals, casts, calls). When
-     * multiple suggestions compete, their common type is used. Guides literal
-     * coercion in parent binary expressions (e.g. `2 + b` where b is BYTE).
-     */
-    void setSuggestedType(const Type* implicitType);
-
     /**
      * Verify that an expression is addressable (can have its address taken or
      * be bound to a reference). Only Place expressions (C++ lvalues) qualify.
@@ -194,6 +330,51 @@ private:
      */
     [[nodiscard]] auto ensureAssignable(const AstExpr& ast) -> Result;
 
+    // -------------------------------------------------------------------------
+    // Constant folding (SemaFold.cpp)
+    // -------------------------------------------------------------------------
+
+    /**
+     * Fold an analysed expression whose value is known at compile time into
+     * a literal: a use of a constant, or a unary, binary or cast expression
+     * whose operands are literals. Operands must be folded already.
+     * Operations that would trap or are undefined at run time, like division
+     * by zero, are left unfolded.
+     *
+     * @return The literal replacing @p ast, or @p ast itself.
+     */
+    [[nodiscard]] auto fold(AstExpr& ast) const -> AstExpr*;
+
+    /**
+     * Fold a literal subtree bottom-up once its type is final. A literal
+     * subtree is not folded while it is coercible, because coercion changes
+     * the type its arithmetic is done in.
+     */
+    [[nodiscard]] auto foldLiterals(AstExpr& ast) const -> AstExpr*;
+
+    /**
+     * Evaluate the analysed initialiser of a constant or of a module level
+     * variable at compile time, running the SUB and FUNCTION bodies it
+     * calls and analysing those still waiting for their turn on demand.
+     * Bodies may only read and assign their parameters and locals, and
+     * evaluation gives up past kEvaluationSteps, kEvaluationDepth or
+     * kEvaluationValues. The module level definitions the initialiser uses,
+     * collected in @p uses, are referenced only if it is not replaced.
+     *
+     * @return The literal replacing @p ast, or @p ast itself.
+     */
+    [[nodiscard]] auto evaluateInitialiser(AstExpr& ast, std::span<const Symbol* const> uses) -> DiagResult<AstExpr*>;
+
+    /** Create a literal of @p value replacing the analysed expression @p ast. */
+    [[nodiscard]] auto makeLiteral(AstExpr& ast, const LiteralValue& value, bool untyped) const -> AstLiteralExpr*;
+
+    /**
+     * Get the value of a literal in its type: integral values truncated to
+     * the width of the type, SINGLE values rounded. Nullopt if the value
+     * is not of the type's kind.
+     */
+    [[nodiscard]] static auto constantValue(const AstLiteralExpr& ast) -> std::optional<LiteralValue>;
+
     // -------------------------------------------------------------------------
     // Types (SemaType.cpp)
     // -------------------------------------------------------------------------
@@ -210,22 +391,51 @@ private:
     /** Analyse a const-qualified type expression. */
     [[nodiscard]] auto accept(AstConstType& ast) -> Result;
 
+    // -------------------------------------------------------------------------
+    // Memory handling
+    // -------------------------------------------------------------------------
+
+    /** Allocate an AST node in its group's pool of the analyser's arena. */
+    template<typename T, typename... Args>
+    [[nodiscard]] auto make(Args&&... args) const -> T* {
+        return m_arena.create<T>(std::forward<Args>(args)...);
+    }
+
+    /** Allocate a symbol or symbol table from the analyser's arena. */
+    template<typename T, typename... Args>
+    [[nodiscard]] auto create(Args&&... args) const -> T* {
+        auto* obj = m_arena.getAllocator().Allocate<T>();
+        return std::construct_at(obj, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Allocate an uninitialized array of T from the analyser's arena. Unlike
+     * Context::span(), this is safe in workers analysing bodies in parallel.
+     */
+    template<typename T>
+    [[nodiscard]] auto span(const std::size_t count) const -> std::span<T> {
+        return { m_arena.getAllocator().Allocate<T>(count), count };
+    }
+
     // -------------------------------------------------------------------------
     // Data
     // -------------------------------------------------------------------------
 
     Context& m_context;
-    SymbolTable* m_symbolTable = nullptr;
+    AstArena& m_arena; ///< Arena nodes and symbols are allocated from
 
-    /// Target type pushed down from the caller (e.g. `DIM x AS BYTE = <expr>`).
-    /// Literals adopt this type if compatible; non-literals are coerced after visit.
-    const Type* m_explicitType = nullptr;
+    /// Names in scope, mirroring the symbol tables of the scopes being
+    /// analysed. The innermost table is where declarations go.
+    ScopeBindings m_bindings;
 
-    /// Type that propagates upward from typed sub-expressions (variables, casts,
-    /// calls, literals). Guides literal coercion in binary expressions: `2 + b`
-    /// where b is BYTE suggests BYTE, coercing the literal 2 to match.
-    /// When multiple suggestions compete, their common type is used.
-    const Type* m_suggestedType = nullptr;
+    /// Buffer recording diagnostics of a worker, null in the main analyser.
+    DiagBuffer* m_diagBuffer = nullptr;
+
+    /// Whether the expression visited last is a literal subtree: unsuffixed
+    /// literals combined by negation and arithmetic only. It has no fixed type
+    /// yet, so the parent or caller coerces it in place instead of casting it:
+    /// in `2 + b` where b is BYTE, the literal 2 becomes BYTE.
+    bool m_coercible = false;
 
     /// Active language linkage. Set while analysing an EXTERN block; controls
     /// whether declared symbols take their verbatim name as an alias.
@@ -234,6 +444,43 @@ private:
     /// Return type of the function/subroutine body currently being analysed, or
     /// nullptr at module scope. Drives RETURN statement checking.
     const Type* m_returnType = nullptr;
+
+    /// Function whose body is being analysed, null in top-level code. Uses of
+    /// module level definitions are recorded as references from it.
+    const Symbol* m_definition = nullptr;
+
+    /// Module level definitions and their references, shared with the workers.
+    std::shared_ptr<ReferenceGraph> m_references;
+
+    /// Analysed bodies by function symbol, which initialisers evaluated at
+    /// compile time may call. Shared with the workers, and updated as soon as
+    /// a body is analysed serially, or after bodies analysed in parallel.
+    std::shared_ptr<llvm::DenseMap<const Symbol*, const AstFuncStmt*>> m_evaluable;
+
+    /// Bodies reached in source order but not analysed yet, by function
+    /// symbol: the rest of the run being analysed and deferred bodies. An
+    /// initialiser evaluated at compile time analyses those it calls.
+    llvm::DenseMap<const Symbol*, AstFuncStmt*> m_waitingBodies;
+
+    /// Module level definitions used by the initialiser being analysed, null
+    /// outside one. They are referenced once it is known to run at run time.
+    llvm::SmallVectorImpl<const Symbol*>* m_initialiserUses = nullptr;
+
+    /// Parser callback for deferred bodies, unset when the parser is eager.
+    BodyLoader m_bodyLoader;
+
+    /// Deferred bodies not referenced yet, by function symbol.
+    llvm::DenseMap<const Symbol*, AstFuncStmt*> m_deferredBodies;
+
+    /// Function symbols referenced so far, including those whose definition
+    /// has not been reached yet.
+    llvm::DenseSet<const Symbol*> m_referenced;
+
+    /// Reachable deferred bodies waiting to be parsed and analysed.
+    std::vector<AstFuncStmt*> m_pendingBodies;
+
+    /// Interfaces of imported modules, by path.
+    llvm::StringMap<AstModule*> m_imports;
 };
 
 } // namespace lbc
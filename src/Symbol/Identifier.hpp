@@ -0,0 +1,107 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <llvm/ADT/DenseMapInfo.h>
+namespace lbc {
+
+/**
+ * Handle of a name interned by the IdentifierTable.
+ *
+ * Every spelling of a name interns to the same entry, so handles compare
+ * by pointer without looking at the characters. Entries are numbered in
+ * the order they are interned, which lets data kept per name live in flat
+ * arrays indexed by getIndex() instead of hash maps (see ScopeBindings).
+ * A default constructed handle names nothing.
+ */
+class Identifier final {
+public:
+    /// Interned entry, stored right before the name's upper case characters
+    struct Entry final {
+        std::uint32_t index;  ///< dense index, in the order names were interned
+        std::uint32_t length; ///< number of characters
+    };
+
+    constexpr Identifier() = default;
+
+    /**
+     * Get the handle of @p name, which must be a name returned by
+     * IdentifierTable::intern(), like the value of an identifier token.
+     */
+    [[nodiscard]] static auto fromInterned(const llvm::StringRef name) -> Identifier {
+        if (name.data() == nullptr) {
+            return {};
+        }
+        return Identifier { std::prev(reinterpret_cast<const Entry*>(name.data())) }; // NOLINT(*-reinterpret-cast)
+    }
+
+    /** Check whether the handle names an identifier. */
+    [[nodiscard]] constexpr auto isValid() const -> bool { return m_entry != nullptr; }
+
+    /** Get the upper case name, empty for an invalid handle. */
+    [[nodiscard]] auto str() const -> llvm::StringRef {
+        if (m_entry == nullptr) {
+            return {};
+        }
+        return { reinterpret_cast<const char*>(std::next(m_entry)), m_entry->length }; // NOLINT(*-reinterpret-cast)
+    }
+
+    /** Get the dense index of the name, unique within its IdentifierTable. */
+    [[nodiscard]] auto getIndex() const -> std::uint32_t {
+        assert(m_entry != nullptr && "index of an invalid identifier");
+        return m_entry->index;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Identifier& other) const -> bool = default;
+
+private:
+    friend class IdentifierTable;
+    friend struct llvm::DenseMapInfo<Identifier>;
+
+    constexpr explicit Identifier(const Entry* entry)
+    : m_entry(entry) {}
+
+    const Entry* m_entry = nullptr;
+};
+
+} // namespace lbc
+
+/**
+ * Use lbc::Identifier as a DenseMap key, hashed by its index so that
+ * iteration order does not depend on where names were allocated.
+ */
+template<>
+struct llvm::DenseMapInfo<lbc::Identifier> final {
+    using Entry = const lbc::Identifier::Entry*;
+
+    static auto getEmptyKey() -> lbc::Identifier {
+        return lbc::Identifier { DenseMapInfo<Entry>::getEmptyKey() };
+    }
+
+    static auto getTombstoneKey() -> lbc::Identifier {
+        return lbc::Identifier { DenseMapInfo<Entry>::getTombstoneKey() };
+    }
+
+    static auto getHashValue(const lbc::Identifier& id) -> unsigned {
+        return DenseMapInfo<std::uint32_t>::getHashValue(id.getIndex());
+    }
+
+    static auto isEqual(const lbc::Identifier& lhs, const lbc::Identifier& rhs) -> bool {
+        return lhs == rhs;
+    }
+};
+
+/**
+ * Support using lbc::Identifier with std::print and std::format.
+ */
+template<>
+struct std::formatter<lbc::Identifier, char> final {
+    static constexpr auto parse(std::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    static auto format(const lbc::Identifier& id, std::format_context& ctx) {
+        return std::format_to(ctx.out(), "{}", std::string_view(id.str()));
+    }
+};
@@ -0,0 +1,75 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "IdentifierTable.hpp"
+using namespace lbc;
+
+namespace {
+/// Initial number of slots, always a power of two
+constexpr std::size_t kInitialCapacity = 256;
+} // namespace
+
+IdentifierTable::IdentifierTable(llvm::BumpPtrAllocator& allocator)
+: m_allocator(allocator)
+, m_slots(kInitialCapacity, Slot { .hash = 0, .entry = nullptr }) {
+}
+
+auto IdentifierTable::intern(const llvm::StringRef spelling, const std::uint64_t hash) -> llvm::StringRef {
+    assert(hash == IdentifierTable::hash(spelling) && "Hash does not match the spelling");
+
+    // keep the load factor under 3/4
+    if ((m_size + 1) * 4 > m_slots.size() * 3) {
+        grow();
+    }
+
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t index = hash & mask;; index = (index + 1) & mask) {
+        auto& slot = m_slots[index];
+        if (slot.entry == nullptr) {
+            // the entry, then the upper case name and its terminator
+            auto* memory = m_allocator.Allocate(sizeof(Identifier::Entry) + spelling.size() + 1, alignof(Identifier::Entry));
+            auto* entry = new (memory) Identifier::Entry {
+                .index = static_cast<std::uint32_t>(m_size),
+                .length = static_cast<std::uint32_t>(spelling.size()),
+            };
+            auto* data = reinterpret_cast<char*>(std::next(entry)); // NOLINT(*-reinterpret-cast)
+            std::transform(spelling.begin(), spelling.end(), data, &IdentifierTable::toUpper);
+            data[spelling.size()] = '\0'; // NOLINT(*-pro-bounds-pointer-arithmetic)
+            slot = Slot { .hash = hash, .entry = entry };
+            m_size++;
+            return Identifier { entry }.str();
+        }
+        if (slot.hash == hash && matches(slot, spelling)) {
+            return Identifier { slot.entry }.str();
+        }
+    }
+}
+
+auto IdentifierTable::matches(const Slot& slot, const llvm::StringRef spelling) -> bool {
+    const auto name = Identifier { slot.entry }.str();
+    if (name.size() != spelling.size()) {
+        return false;
+    }
+    for (std::size_t idx = 0; idx < name.size(); ++idx) {
+        if (name[idx] != toUpper(spelling[idx])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IdentifierTable::grow() {
+    std::vector<Slot> slots(m_slots.size() * 2, Slot { .hash = 0, .entry = nullptr });
+    const std::size_t mask = slots.size() - 1;
+    for (const auto& slot : m_slots) {
+        if (slot.entry == nullptr) {
+            continue;
+        }
+        auto index = slot.hash & mask;
+        while (slots[index].entry != nullptr) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+    m_slots = std::move(slots);
+}
@@ -0,0 +1,104 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <vector>
+#include "Identifier.hpp"
+namespace lbc {
+
+/**
+ * Interning table for identifier names.
+ *
+ * BASIC identifiers are case-insensitive, so names are stored in their
+ * upper case form and every spelling of a name maps to the same interned
+ * string. The hash is case-folded and can be computed incrementally, which
+ * lets the lexer hash an identifier while scanning it and intern it with a
+ * single probe. A spelling that is already interned is never copied; a new
+ * name is copied once, upper cased, into the arena.
+ *
+ * Interned strings are stable for the lifetime of the table's allocator,
+ * so equal names share the same data pointer. Each is stored after its
+ * Identifier::Entry, so an interned name is also an Identifier handle.
+ */
+class IdentifierTable final {
+public:
+    NO_COPY_AND_MOVE(IdentifierTable)
+
+    /// Initial hash value, feed characters with hash()
+    static constexpr std::uint64_t kHashSeed = 0xCBF2'9CE4'8422'2325ULL;
+
+    /** Construct an empty table allocating names from the given arena. */
+    explicit IdentifierTable(llvm::BumpPtrAllocator& allocator);
+    ~IdentifierTable() = default;
+
+    /**
+     * Fold the next character of a name into a running hash.
+     * Letters hash the same regardless of case.
+     */
+    [[nodiscard]] static constexpr auto hash(const std::uint64_t hash, const char ch) -> std::uint64_t {
+        constexpr std::uint64_t prime = 0x0000'0100'0000'01B3ULL;
+        return (hash ^ static_cast<std::uint8_t>(toUpper(ch))) * prime;
+    }
+
+    /** Compute the case-folded hash of a whole name. */
+    [[nodiscard]] static auto hash(const llvm::StringRef name) -> std::uint64_t {
+        std::uint64_t result = kHashSeed;
+        for (const char ch : name) {
+            result = hash(result, ch);
+        }
+        return result;
+    }
+
+    /**
+     * Intern a name given in any case, with its hash already computed.
+     *
+     * @param spelling name as it appears in the source
+     * @param hash case-folded hash of spelling
+     * @return the stable upper case form of the name
+     */
+    [[nodiscard]] auto intern(llvm::StringRef spelling, std::uint64_t hash) -> llvm::StringRef;
+
+    /**
+     * Intern a name given in any case.
+     */
+    [[nodiscard]] auto intern(const llvm::StringRef spelling) -> llvm::StringRef {
+        return intern(spelling, hash(spelling));
+    }
+
+    /**
+     * Intern a name given in any case and get its handle.
+     */
+    [[nodiscard]] auto get(const llvm::StringRef spelling) -> Identifier {
+        return Identifier::fromInterned(intern(spelling));
+    }
+
+    /** Number of distinct names interned. */
+    [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+
+private:
+    /// Table slot, empty when entry is null
+    struct Slot final {
+        std::uint64_t hash;
+        const Identifier::Entry* entry;
+    };
+
+    [[nodiscard]] static constexpr auto toUpper(const char ch) -> char {
+        if (ch >= 'a' && ch <= 'z') {
+            return static_cast<char>(ch - ('a' - 'A'));
+        }
+        return ch;
+    }
+
+    /** Check if spelling matches the upper case name stored in slot. */
+    [[nodiscard]] static auto matches(const Slot& slot, llvm::StringRef spelling) -> bool;
+
+    /** Double the slot count and reinsert all entries. */
+    void grow();
+
+    llvm::BumpPtrAllocator& m_allocator;
+    std::vector<Slot> m_slots;
+    std::size_t m_size = 0;
+};
+
+} // namespace lbc
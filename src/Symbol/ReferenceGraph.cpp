@@ -0,0 +1,70 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "ReferenceGraph.hpp"
+#include "Symbol.hpp"
+using namespace lbc;
+
+void ReferenceGraph::add(Symbol& symbol, const bool root) {
+    const auto index = static_cast<std::uint32_t>(m_nodes.size());
+    if (m_index.try_emplace(&symbol, index).second) {
+        m_nodes.push_back({ .symbol = &symbol, .references = {}, .root = root });
+    }
+}
+
+void ReferenceGraph::reference(const Symbol* from, const Symbol& to) {
+    const auto target = find(&to);
+    if (not target) {
+        return;
+    }
+    if (from == nullptr) {
+        m_nodes[*target].root = true;
+        return;
+    }
+    if (const auto source = find(from)) {
+        // a body tends to use the same definition several times in a row
+        auto& references = m_nodes[*source].references;
+        if (references.empty() || references.back() != *target) {
+            references.push_back(*target);
+        }
+    }
+}
+
+auto ReferenceGraph::prune() -> std::vector<Symbol*> {
+    std::vector<bool> reachable(m_nodes.size(), false);
+    std::vector<std::uint32_t> pending;
+    for (std::uint32_t index = 0; index < m_nodes.size(); index++) {
+        if (m_nodes[index].root) {
+            reachable[index] = true;
+            pending.push_back(index);
+        }
+    }
+
+    while (not pending.empty()) {
+        const auto index = pending.back();
+        pending.pop_back();
+        for (const auto target : m_nodes[index].references) {
+            if (not reachable[target]) {
+                reachable[target] = true;
+                pending.push_back(target);
+            }
+        }
+    }
+
+    std::vector<Symbol*> removed;
+    for (std::uint32_t index = 0; index < m_nodes.size(); index++) {
+        if (not reachable[index]) {
+            auto* symbol = m_nodes[index].symbol;
+            symbol->setFlag(SymbolFlags::Unreachable);
+            removed.push_back(symbol);
+        }
+    }
+    return removed;
+}
+
+auto ReferenceGraph::find(const Symbol* symbol) const -> std::optional<std::uint32_t> {
+    if (const auto iter = m_index.find(symbol); iter != m_index.end()) {
+        return iter->second;
+    }
+    return std::nullopt;
+}
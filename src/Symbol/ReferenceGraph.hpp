@@ -0,0 +1,67 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <vector>
+namespace lbc {
+class Symbol;
+
+/**
+ * Module level definitions and the references between them, which decide
+ * the definitions worth lowering.
+ *
+ * Sema adds every SUB, FUNCTION and module level variable it defines, and
+ * records each use of one as a reference from the definition whose body
+ * uses it. Uses in top-level code, and exported definitions, are roots.
+ * Definitions no path of references leads to from a root are unreachable:
+ * they are flagged with SymbolFlags::Unreachable and not lowered.
+ *
+ * References from different bodies may be recorded concurrently, as each
+ * body only appends to its own definition. Adding definitions and roots
+ * must not overlap with that.
+ *
+ * @code
+ * graph.add(*func, false);
+ * graph.reference(nullptr, *func); // called from top-level code
+ * const auto removed = graph.prune();
+ * @endcode
+ */
+class ReferenceGraph final {
+public:
+    /**
+     * Add the definition of @p symbol, reachable regardless of references
+     * if it is a @p root.
+     */
+    void add(Symbol& symbol, bool root);
+
+    /**
+     * Record that the body of @p from uses @p to, or top-level code does if
+     * @p from is null. Symbols that were not added are ignored.
+     */
+    void reference(const Symbol* from, const Symbol& to);
+
+    /**
+     * Flag the definitions that are not reachable from a root as unreachable.
+     * @return The unreachable definitions, in the order they were added.
+     */
+    [[nodiscard]] auto prune() -> std::vector<Symbol*>;
+
+private:
+    /// An added definition
+    struct Node final {
+        Symbol* symbol;                                 ///< defined symbol
+        llvm::SmallVector<std::uint32_t, 4> references; ///< nodes used by the body
+        bool root;                                      ///< reachable regardless of references
+    };
+
+    /** Get the node of @p symbol, nullopt if it was not added. */
+    [[nodiscard]] auto find(const Symbol* symbol) const -> std::optional<std::uint32_t>;
+
+    llvm::DenseMap<const Symbol*, std::uint32_t> m_index; ///< node index by symbol
+    std::vector<Node> m_nodes;                            ///< definitions in the order added
+};
+
+} // namespace lbc
@@ -0,0 +1,71 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "ScopeBindings.hpp"
+#include "Symbol.hpp"
+using namespace lbc;
+
+auto ScopeBindings::enter(SymbolTable& table) -> Scope {
+    push(table);
+    return Scope { *this };
+}
+
+ScopeBindings::Suspension::Suspension(ScopeBindings& bindings)
+: m_bindings(bindings) {
+    m_tables.reserve(bindings.m_scopes.size());
+    for (const auto& frame : bindings.m_scopes) {
+        m_tables.push_back(frame.table);
+    }
+    while (not bindings.m_scopes.empty()) {
+        bindings.leave();
+    }
+}
+
+ScopeBindings::Suspension::~Suspension() {
+    assert(m_bindings.m_scopes.empty() && "scope still entered when resuming suspended scopes");
+    for (auto* table : m_tables) {
+        m_bindings.push(*table);
+    }
+}
+
+void ScopeBindings::push(SymbolTable& table) {
+    const auto* outer = getTable();
+    m_scopes.push_back({ .table = &table, .undo = m_undo.size() });
+    bindChain(&table, outer);
+}
+
+void ScopeBindings::declare(Symbol* symbol) {
+    assert((not m_scopes.empty() || m_shared == nullptr) && "declaring into frozen shared bindings");
+    auto* table = getTable();
+    assert(table != nullptr && "declaring outside of any scope");
+    table->insert(symbol);
+    bind(symbol, table);
+}
+
+void ScopeBindings::bindChain(const SymbolTable* table, const SymbolTable* stop) {
+    if (table == stop) {
+        return;
+    }
+    assert(table != nullptr && "scope entered outside of its enclosing scope");
+    bindChain(static_cast<const SymbolTable*>(table->getParent()), stop); // NOLINT(*-static-cast-downcast)
+    table->forEach([&](Symbol* symbol) { bind(symbol, table); });
+}
+
+void ScopeBindings::bind(Symbol* symbol, const SymbolTable* table) {
+    const auto index = symbol->getName().getIndex();
+    if (index >= m_bindings.size()) {
+        m_bindings.resize(index + 1);
+    }
+    m_bindings[index].push_back({ .symbol = symbol, .table = table });
+    m_undo.push_back(index);
+}
+
+void ScopeBindings::leave() {
+    assert(not m_scopes.empty() && "leaving a scope that was not entered");
+    const auto undo = m_scopes.back().undo;
+    while (m_undo.size() > undo) {
+        m_bindings[m_undo.back()].pop_back();
+        m_undo.pop_back();
+    }
+    m_scopes.pop_back();
+}
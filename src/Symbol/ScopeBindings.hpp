@@ -0,0 +1,158 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <llvm/ADT/SmallVector.h>
+#include <vector>
+#include "Identifier.hpp"
+namespace lbc {
+class Symbol;
+class SymbolTable;
+
+/**
+ * Flat map from identifiers to the symbols they resolve to in the scopes
+ * currently entered.
+ *
+ * Each identifier owns a stack of bindings, indexed by Identifier::getIndex(),
+ * whose top is the innermost declaration in scope. Entering a scope pushes
+ * the symbols of its SymbolTable, declaring pushes one more, and leaving pops
+ * what the scope pushed. Lookup is a single array access at any nesting depth
+ * and never hashes or compares names.
+ *
+ * The symbol tables stay the record of what each scope declares; bindings
+ * only mirror the tables along the current chain of scopes. A table entered
+ * out of order, such as a deferred function body analysed after its module,
+ * has its missing enclosing tables entered with it.
+ *
+ * Bindings may be layered over a shared, frozen instance, such as the module
+ * scope while bodies are analysed in parallel. Scopes entered on top of it
+ * are bound locally, and names not bound locally are looked up in the shared
+ * bindings, so nothing is copied and the shared instance is only read.
+ *
+ * @code
+ * const auto scope = bindings.enter(*table);
+ * bindings.declare(symbol);
+ * auto* found = bindings.find(name);
+ * @endcode
+ */
+class ScopeBindings final {
+public:
+    /**
+     * Leaves the scope entered by ScopeBindings::enter() when destroyed.
+     */
+    class [[nodiscard]] Scope final {
+    public:
+        NO_COPY_AND_MOVE(Scope)
+
+        explicit Scope(ScopeBindings& bindings)
+        : m_bindings(bindings) {}
+
+        ~Scope() { m_bindings.leave(); }
+
+    private:
+        ScopeBindings& m_bindings;
+    };
+
+    /**
+     * Leaves every scope entered when constructed and enters them again,
+     * outermost first, when destroyed. Scopes entered meanwhile see the
+     * bindings as they were before the first scope was entered.
+     */
+    class [[nodiscard]] Suspension final {
+    public:
+        NO_COPY_AND_MOVE(Suspension)
+
+        explicit Suspension(ScopeBindings& bindings);
+        ~Suspension();
+
+    private:
+        ScopeBindings& m_bindings;
+        std::vector<SymbolTable*> m_tables; ///< tables of the suspended scopes, outermost first
+    };
+
+    NO_COPY_AND_MOVE(ScopeBindings)
+    ScopeBindings() = default;
+
+    /**
+     * Layer new bindings over @p shared, which must not change while they
+     * are in use. The innermost scope of @p shared is the enclosing scope
+     * of the first one entered.
+     */
+    explicit ScopeBindings(const ScopeBindings* shared)
+    : m_shared(shared) {}
+
+    /**
+     * Enter the scope of @p table, binding the symbols it already holds.
+     * Tables between the innermost entered scope and @p table are entered
+     * along with it, outermost first.
+     */
+    [[nodiscard]] auto enter(SymbolTable& table) -> Scope;
+
+    /** Leave every entered scope until the returned suspension is destroyed. */
+    [[nodiscard]] auto suspend() -> Suspension { return Suspension { *this }; }
+
+    /** Insert @p symbol into the innermost table and bind its name. */
+    void declare(Symbol* symbol);
+
+    /** Find the innermost symbol bound to @p id, nullptr if none. */
+    [[nodiscard]] auto find(const Identifier id) const -> Symbol* {
+        const auto index = id.getIndex();
+        if (index >= m_bindings.size() || m_bindings[index].empty()) {
+            return m_shared == nullptr ? nullptr : m_shared->find(id);
+        }
+        return m_bindings[index].back().symbol;
+    }
+
+    /** Find the symbol @p id is bound to in the innermost table, nullptr if none. */
+    [[nodiscard]] auto findLocal(const Identifier id) const -> Symbol* {
+        if (m_scopes.empty()) {
+            return m_shared == nullptr ? nullptr : m_shared->findLocal(id);
+        }
+        const auto index = id.getIndex();
+        if (index >= m_bindings.size() || m_bindings[index].empty() || m_bindings[index].back().table != getTable()) {
+            return nullptr;
+        }
+        return m_bindings[index].back().symbol;
+    }
+
+    /** Get the table of the innermost scope, nullptr outside any scope. */
+    [[nodiscard]] auto getTable() const -> SymbolTable* {
+        if (m_scopes.empty()) {
+            return m_shared == nullptr ? nullptr : m_shared->getTable();
+        }
+        return m_scopes.back().table;
+    }
+
+private:
+    /// A symbol an identifier resolves to
+    struct Binding final {
+        Symbol* symbol;           ///< bound symbol
+        const SymbolTable* table; ///< table the symbol is declared in
+    };
+
+    /// An entered scope
+    struct Frame final {
+        SymbolTable* table; ///< innermost table of the scope
+        std::size_t undo;   ///< size of m_undo when the scope was entered
+    };
+
+    /** Push a scope for @p table and bind it over the innermost one. */
+    void push(SymbolTable& table);
+
+    /** Bind the symbols of @p table and of its parents up to @p stop. */
+    void bindChain(const SymbolTable* table, const SymbolTable* stop);
+
+    /** Push a binding of @p symbol declared in @p table. */
+    void bind(Symbol* symbol, const SymbolTable* table);
+
+    /** Pop the bindings of the innermost scope. */
+    void leave();
+
+    std::vector<llvm::SmallVector<Binding, 1>> m_bindings; ///< binding stacks by identifier index
+    std::vector<std::uint32_t> m_undo;                     ///< identifier indices in binding order
+    std::vector<Frame> m_scopes;                           ///< entered scopes, innermost last
+    const ScopeBindings* m_shared = nullptr;               ///< frozen bindings enclosing the scopes, if layered
+};
+
+} // namespace lbc
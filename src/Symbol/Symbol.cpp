@@ -5,7 +5,7 @@
 #include "Type/Type.hpp"
 using namespace lbc;
 
-Symbol::Symbol(const llvm::StringRef name, const Type* type, const llvm::SMRange origin)
+Symbol::Symbol(const Identifier name, const Type* type, const SourceRange origin)
 : m_name(name)
 , m_type(type)
 , m_range(origin)
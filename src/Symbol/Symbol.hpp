@@ -3,7 +3,9 @@
 //
 #pragma once
 #include "pch.hpp"
+#include "Diag/SourceRange.hpp"
 #include "ExternKind.hpp"
+#include "Identifier.hpp"
 #include "LiteralValue.hpp"
 #include "SymbolTable.hpp"
 namespace lbc {
@@ -27,6 +29,8 @@ enum class SymbolFlags : std::uint8_t {
     Variable = 1U << 3U,     ///< The symbol is a variable
     Constant = 1U << 4U,     ///< The symbol is a constant
     Type = 1U << 5U,         ///< The symbol is a type
+    Untyped = 1U << 6U,      ///< Constant declared without a type, coerces like a literal
+    Unreachable = 1U << 7U,  ///< Definition nothing reachable uses, it is not lowered
 };
 
 /**
@@ -40,16 +44,16 @@ public:
     NO_COPY_AND_MOVE(Symbol)
 
     /** Construct a symbol with the given name, type, and source location. */
-    Symbol(llvm::StringRef name, const Type* type, llvm::SMRange origin);
+    Symbol(Identifier name, const Type* type, SourceRange origin);
 
     /** Get the effective name, preferring alias over the original name. */
     [[nodiscard]] auto getSymbolName() const -> llvm::StringRef {
-        return m_alias.empty() ? m_name : m_alias;
+        return m_alias.empty() ? m_name.str() : m_alias;
     }
 
     /** Get the original declared name. */
-    [[nodiscard]] auto getName() const -> llvm::StringRef { return m_name; }
-    void setName(const llvm::StringRef name) { m_name = name; }
+    [[nodiscard]] auto getName() const -> Identifier { return m_name; }
+    void setName(const Identifier name) { m_name = name; }
 
     /** Get the optional alias for this symbol. */
     [[nodiscard]] auto getAlias() const -> llvm::StringRef { return m_alias; }
@@ -64,8 +68,8 @@ public:
     void setType(const Type* type) { m_type = type; }
 
     /** Get the source location where this symbol was declared. */
-    [[nodiscard]] auto getRange() const -> llvm::SMRange { return m_range; }
-    void setRange(const llvm::SMRange origin) { m_range = origin; }
+    [[nodiscard]] auto getRange() const -> SourceRange { return m_range; }
+    void setRange(const SourceRange origin) { m_range = origin; }
 
     /** Get the visibility of this symbol. */
     [[nodiscard]] auto getVisibility() const -> SymbolVisibility { return m_visibility; }
@@ -84,11 +88,11 @@ public:
     void setOperand(ir::lib::Value* operand) { m_operand = operand; }
 
 private:
-    llvm::StringRef m_name;                        ///< symbol name
+    Identifier m_name;                             ///< symbol name
     llvm::StringRef m_alias;                       ///< optional alias
     ExternKind m_externKind = ExternKind::Default; ///< language linkage
     const Type* m_type;                            ///< symbol type
-    llvm::SMRange m_range;                         ///< declaration location
+    SourceRange m_range;                           ///< declaration location
     SymbolVisibility m_visibility;                 ///< visibility of the symbol
     std::optional<LiteralValue> m_value;           ///< constant value associated with the symbol
     std::span<Symbol*> m_relatedSymbols;           ///< related symbols, e.g. function parameters, or UDT members
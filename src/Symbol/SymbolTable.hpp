@@ -3,15 +3,17 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <llvm/ADT/DenseMap.h>
+#include "Identifier.hpp"
 namespace lbc {
 
 /**
  * Concept for types that can be stored in a SymbolTableBase.
- * Requires a getName() method returning something convertible to llvm::StringRef.
+ * Requires a getName() method returning the Identifier of the value.
  */
 template<typename T>
 concept Named = requires(const T& value) {
-    { value.getName() } -> std::convertible_to<llvm::StringRef>;
+    { value.getName() } -> std::same_as<Identifier>;
 };
 
 /**
@@ -19,6 +21,8 @@ concept Named = requires(const T& value) {
  *
  * Symbol tables form a chain via parent pointers, representing nested lexical scopes.
  * Lookups walk the chain upward by default, finding the innermost definition of a name.
+ * Names are interned, so each scope is keyed by the Identifier without hashing the
+ * string. Sema resolves names through ScopeBindings instead, which does not walk.
  */
 template<Named T>
 class SymbolTableBase {
@@ -36,7 +40,7 @@ public:
      * @param id the name to look up.
      * @param recursive if true, search parent scopes as well.
      */
-    [[nodiscard]] auto contains(const llvm::StringRef id, const bool recursive = true) const -> bool {
+    [[nodiscard]] auto contains(const Identifier id, const bool recursive = true) const -> bool {
         return find(id, recursive) != nullptr;
     }
 
@@ -46,7 +50,7 @@ public:
      * @param recursive if true, search parent scopes as well.
      * @return the symbol, or nullptr if not found.
      */
-    [[nodiscard]] auto find(llvm::StringRef id, const bool recursive = true) const -> T* {
+    [[nodiscard]] auto find(const Identifier id, const bool recursive = true) const -> T* {
         if (const auto it = m_symbols.find(id); it != m_symbols.end()) {
             return it->second;
         }
@@ -67,8 +71,19 @@ public:
         m_symbols.try_emplace(value->getName(), value);
     }
 
+    /** Number of values declared directly in this scope. */
+    [[nodiscard]] auto size() const -> std::size_t { return m_symbols.size(); }
+
+    /** Call @p fn with each value declared directly in this scope, in no particular order. */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& entry : m_symbols) {
+            fn(entry.second);
+        }
+    }
+
 private:
-    using Container = llvm::StringMap<T*>;
+    using Container = llvm::DenseMap<Identifier, T*>;
 
     SymbolTableBase* m_parent;
     Container m_symbols;
@@ -9,24 +9,6 @@ using namespace lbc;
 
 namespace {
 
-// target <- from
-auto toIntegral(const TypeIntegral* target, const Type* from) -> bool {
-    if (const auto* rhs = llvm::dyn_cast<TypeIntegral>(from)) {
-        if (target->getBytes() > rhs->getBytes()) {
-            return target->isSigned() || !rhs->isSigned();
-        }
-    }
-    return false;
-}
-
-// target <- from
-auto toFloatingPoint(const TypeFloatingPoint* target, const Type* from) -> bool {
-    if (const auto* rhs = llvm::dyn_cast<TypeFloatingPoint>(from)) {
-        return target->getBytes() > rhs->getBytes();
-    }
-    return false;
-}
-
 // target <- from
 auto toPointer(const TypePointer* target, const Type* from) -> bool {
     if (target->isAnyPtr() && from->isPointer()) {
@@ -53,37 +35,34 @@ auto Type::convertible(const Type* from, const Conversion mode) const -> bool {
         return true;
     }
 
-    switch (mode) {
-    case Conversion::Implicit:
-        // integral
-        if (const auto* to = llvm::dyn_cast<TypeIntegral>(this)) {
-            return toIntegral(to, from);
-        }
-
-        // floating point
-        if (const auto* to = llvm::dyn_cast<TypeFloatingPoint>(this)) {
-            return toFloatingPoint(to, from);
+    // primitive and numeric types: look up the generated table
+    if (isSingleton() && from->isSingleton()) {
+        switch (kTypeConversions[std::to_underlying(getKind())][std::to_underlying(from->getKind())]) {
+        case TypeConversion::None:
+            return false;
+        case TypeConversion::Cast:
+            return mode == Conversion::Cast;
+        case TypeConversion::ByWidth:
+            // INTEGER and UINTEGER against a fixed width integral, sized by the target
+            return mode == Conversion::Cast
+                || llvm::cast<TypeIntegral>(this)->getBytes() > llvm::cast<TypeIntegral>(from)->getBytes();
+        case TypeConversion::Implicit:
+            return true;
         }
+        std::unreachable();
+    }
 
-        // pointer
-        if (const auto* to = llvm::dyn_cast<TypePointer>(this)) {
+    // pointer <- null | pointer
+    if (const auto* to = llvm::dyn_cast<TypePointer>(this)) {
+        switch (mode) {
+        case Conversion::Implicit:
             return toPointer(to, from);
+        case Conversion::Cast:
+            return from->isNull() || from->isPointer();
         }
-        return false;
-    case Conversion::Cast: {
-        // number <- number
-        if (isNumeric() && from->isNumeric()) {
-            return true;
-        }
-        // pointer <- null | pointer
-        if (isPointer() && (from->isNull() || from->isPointer())) {
-            return true;
-        }
-        return false;
-    }
-    default:
         std::unreachable();
     }
+    return false;
 }
 
 auto Type::removeReference() const -> const Type* {
@@ -3,13 +3,17 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <atomic>
 #include "TypeBase.hpp"
 namespace llvm {
 class Type;
 }
 namespace lbc {
 class Context;
+class TypeConst;
 class TypeFactory;
+class TypePointer;
+class TypeReference;
 
 /**
  * Base type class for the lbc type system.
@@ -109,6 +113,13 @@ protected:
 
 private:
     mutable llvm::Type* m_llvmType = nullptr; ///< memoised LLVM lowering
+
+    // Types derived from this one, memoised by TypeFactory so that getting
+    // them again is a single load. Atomic because the factory is shared by
+    // threads: a slot is only written once, under the lock of its shard.
+    mutable std::atomic<const TypePointer*> m_pointerTo {};     ///< `this PTR`
+    mutable std::atomic<const TypeReference*> m_referenceTo {}; ///< `BYREF this`
+    mutable std::atomic<const TypeConst*> m_constOf {};         ///< `CONST this`
 };
 
 } // namespace lbc
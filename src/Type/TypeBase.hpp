@@ -38,6 +38,49 @@ enum class TypeKind : std::uint8_t {
     Const,
     Function,
 };
+/**
+ * Conversion allowed from one singleton type kind to another
+ */
+enum class TypeConversion : std::uint8_t {
+    /// Not convertible
+    None,
+    /// Only by an explicit cast
+    Cast,
+    /// Implicit if the target is wider, which depends on the target pointer width, otherwise by a cast
+    ByWidth,
+    /// Implicit, and so by a cast as well
+    Implicit,
+};
+
+/**
+ * Conversions between singleton type kinds, indexed [to][from]
+ */
+inline constexpr auto kTypeConversions = [] {
+    using enum TypeConversion;
+    using Row = std::array<TypeConversion, 18>;
+    return std::array<Row, 18> {
+        // Label, Void, Null, Any, Bool, ZString, UByte, UShort, UInteger, ULong, ULongInt, Byte, Short, Integer, Long, LongInt, Single, Double
+        Row { Implicit, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None }, // Label
+        Row { None, Implicit, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None }, // Void
+        Row { None, None, Implicit, None, None, None, None, None, None, None, None, None, None, None, None, None, None, None }, // Null
+        Row { None, None, None, Implicit, None, None, None, None, None, None, None, None, None, None, None, None, None, None }, // Any
+        Row { None, None, None, None, Implicit, None, None, None, None, None, None, None, None, None, None, None, None, None }, // Bool
+        Row { None, None, None, None, None, Implicit, None, None, None, None, None, None, None, None, None, None, None, None }, // ZString
+        Row { None, None, None, None, None, None, Implicit, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast }, // UByte
+        Row { None, None, None, None, None, None, Implicit, Implicit, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast }, // UShort
+        Row { None, None, None, None, None, None, Implicit, Implicit, Implicit, ByWidth, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast }, // UInteger
+        Row { None, None, None, None, None, None, Implicit, Implicit, Cast, Implicit, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast }, // ULong
+        Row { None, None, None, None, None, None, Implicit, Implicit, ByWidth, Implicit, Implicit, Cast, Cast, Cast, Cast, Cast, Cast, Cast }, // ULongInt
+        Row { None, None, None, None, None, None, Cast, Cast, Cast, Cast, Cast, Implicit, Cast, Cast, Cast, Cast, Cast, Cast }, // Byte
+        Row { None, None, None, None, None, None, Implicit, Cast, Cast, Cast, Cast, Implicit, Implicit, Cast, Cast, Cast, Cast, Cast }, // Short
+        Row { None, None, None, None, None, None, Implicit, Implicit, Cast, ByWidth, Cast, Implicit, Implicit, Implicit, ByWidth, Cast, Cast, Cast }, // Integer
+        Row { None, None, None, None, None, None, Implicit, Implicit, Cast, Cast, Cast, Implicit, Implicit, Cast, Implicit, Cast, Cast, Cast }, // Long
+        Row { None, None, None, None, None, None, Implicit, Implicit, ByWidth, Implicit, Cast, Implicit, Implicit, ByWidth, Implicit, Implicit, Cast, Cast }, // LongInt
+        Row { None, None, None, None, None, None, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Implicit, Cast }, // Single
+        Row { None, None, None, None, None, None, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Cast, Implicit, Implicit }, // Double
+    };
+}();
+
 /**
  * Base class for types
  */
@@ -112,6 +155,9 @@ public:
     }
     [[nodiscard]] constexpr auto isFunction() const -> bool { return m_kind == TypeKind::Function; }
 
+    /// Types with a single instance, the kinds kTypeConversions covers
+    [[nodiscard]] constexpr auto isSingleton() const -> bool { return m_kind <= TypeKind::Double; }
+
     /**
      * Get keyword TokenKind matching current type, or a std::nullopt
      */
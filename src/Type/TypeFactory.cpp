@@ -2,6 +2,7 @@
 // Created by Albert Varaksin on 21/02/2026.
 //
 #include "TypeFactory.hpp"
+#include <bit>
 #include "Driver/Context.hpp"
 #include "llvm/ADT/Hashing.h"
 using namespace lbc;
@@ -17,46 +18,65 @@ TypeFactory::TypeFactory(Context& context)
     m_anyPtr = getPointer(getAny()); // NOLINT(*-prefer-member-initializer)
 }
 
+template<std::derived_from<Type> T>
+auto TypeFactory::derive(std::atomic<const T*>& slot, const Type* base) -> const T* {
+    // pairs with the release store below, so the type is fully constructed when seen
+    if (const auto* existing = slot.load(std::memory_order_acquire)) {
+        return existing;
+    }
+
+    auto& shard = getShard(base);
+    const std::scoped_lock lock { shard.mutex };
+    // another thread may have created it while this one waited for the lock
+    if (const auto* existing = slot.load(std::memory_order_relaxed)) {
+        return existing;
+    }
+    const auto* type = create<T>(shard.allocator, base);
+    slot.store(type, std::memory_order_release);
+    return type;
+}
+
 auto TypeFactory::getPointer(const Type* type) -> const TypePointer* {
     assert(not type->isReference() && "pointer to a reference");
-    if (const auto iter = m_pointers.find(type); iter != m_pointers.end()) {
-        return iter->second;
-    }
-    return m_pointers.insert(std::make_pair(type, create<TypePointer>(type))).first->second;
+    return derive(type->m_pointerTo, type);
 }
 
 auto TypeFactory::getReference(const Type* type) -> const TypeReference* {
     assert(not type->isReference() && "reference to a reference");
-    if (const auto iter = m_references.find(type); iter != m_references.end()) {
-        return iter->second;
-    }
-    return m_references.insert(std::make_pair(type, create<TypeReference>(type))).first->second;
+    return derive(type->m_referenceTo, type);
 }
 
 auto TypeFactory::getConst(const Type* type) -> const TypeConst* {
     assert(not type->isConst() && "const of const");
-    if (const auto iter = m_consts.find(type); iter != m_consts.end()) {
-        return iter->second;
-    }
-    return m_consts.insert(std::make_pair(type, create<TypeConst>(type))).first->second;
+    return derive(type->m_constOf, type);
 }
 
 auto TypeFactory::getFunction(std::span<const Type*> params, const Type* returnType, bool variadic) -> const TypeFunction* {
     const auto hash = llvm::hash_combine(returnType, variadic, llvm::hash_combine_range(params.begin(), params.end()));
-    auto& arr = m_functions[hash];
+    auto& shard = getShard(hash);
+    const std::scoped_lock lock { shard.mutex };
+    auto& arr = shard.functions[hash];
     for (const auto* func : arr) {
         if (func->getReturnType() == returnType && func->isVariadic() == variadic && std::ranges::equal(params, func->getParams())) {
             return func;
         }
     }
-    return arr.emplace_back(create<TypeFunction>(params, returnType, variadic));
+    return arr.emplace_back(create<TypeFunction>(shard.allocator, params, returnType, variadic));
 }
 
-auto TypeFactory::allocate(const std::size_t size, const std::size_t alignment) const -> void* {
-    return m_context.allocate(size, alignment);
+auto TypeFactory::getShard(const std::size_t hash) -> Shard& {
+    static_assert(std::has_single_bit(kShards), "shard count must be a power of two");
+    return m_shards[hash & (kShards - 1)];
+}
+
+auto TypeFactory::getShard(const Type* base) -> Shard& {
+    return getShard(static_cast<std::size_t>(llvm::hash_value(base)));
 }
 
 void TypeFactory::createSingletonTypes() {
+    // singletons are created before the factory is shared, any shard's arena will do
+    auto& allocator = m_shards.front().allocator;
+
     // INTEGER / UINTEGER follow the target pointer width
     const auto pointerBytes = static_cast<std::uint8_t>(m_context.getTriple().isArch64Bit() ? 8 : 4);
 
@@ -68,43 +88,43 @@ void TypeFactory::createSingletonTypes() {
         case TypeKind::Any:
         case TypeKind::Bool:
         case TypeKind::ZString:
-            setSingleton(create<Type>(kind));
+            setSingleton(create<Type>(allocator, kind));
             break;
         case TypeKind::UByte:
-            setSingleton(create<TypeIntegral>(kind, size<std::uint8_t>, false));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::uint8_t>, false));
             break;
         case TypeKind::UShort:
-            setSingleton(create<TypeIntegral>(kind, size<std::uint16_t>, false));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::uint16_t>, false));
             break;
         case TypeKind::ULong:
-            setSingleton(create<TypeIntegral>(kind, size<std::uint32_t>, false));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::uint32_t>, false));
             break;
         case TypeKind::UInteger:
-            setSingleton(create<TypeIntegral>(kind, pointerBytes, false));
+            setSingleton(create<TypeIntegral>(allocator, kind, pointerBytes, false));
             break;
         case TypeKind::ULongInt:
-            setSingleton(create<TypeIntegral>(kind, size<std::uint64_t>, false));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::uint64_t>, false));
             break;
         case TypeKind::Byte:
-            setSingleton(create<TypeIntegral>(kind, size<std::int8_t>, true));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::int8_t>, true));
             break;
         case TypeKind::Short:
-            setSingleton(create<TypeIntegral>(kind, size<std::int16_t>, true));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::int16_t>, true));
             break;
         case TypeKind::Long:
-            setSingleton(create<TypeIntegral>(kind, size<std::int32_t>, true));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::int32_t>, true));
             break;
         case TypeKind::Integer:
-            setSingleton(create<TypeIntegral>(kind, pointerBytes, true));
+            setSingleton(create<TypeIntegral>(allocator, kind, pointerBytes, true));
             break;
         case TypeKind::LongInt:
-            setSingleton(create<TypeIntegral>(kind, size<std::int64_t>, true));
+            setSingleton(create<TypeIntegral>(allocator, kind, size<std::int64_t>, true));
             break;
         case TypeKind::Single:
-            setSingleton(create<TypeFloatingPoint>(kind, size<float>));
+            setSingleton(create<TypeFloatingPoint>(allocator, kind, size<float>));
             break;
         case TypeKind::Double:
-            setSingleton(create<TypeFloatingPoint>(kind, size<double>));
+            setSingleton(create<TypeFloatingPoint>(allocator, kind, size<double>));
             break;
         case TypeKind::Pointer:
         case TypeKind::Reference:
@@ -3,8 +3,11 @@
 //
 #pragma once
 #include "pch.hpp"
+#include <atomic>
+#include <mutex>
 #include "TypeFactoryBase.hpp"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
 namespace lbc {
 class Context;
 
@@ -15,12 +18,28 @@ class Context;
  * construction. Singleton types (primitives, integrals, floats, sentinels)
  * are created once during construction and accessed via inherited getters.
  * Compound and aggregate types are created on demand.
+ *
+ * Pointer, reference and const types are memoised in slots on their base
+ * type, so getting one that exists is a single load. Function types are
+ * hash-consed by their signature.
+ *
+ * Safe to use from multiple threads: the getters of singleton types only
+ * read, and types created on demand are created in one of kShards shards,
+ * picked by the hash of the type's key. Each shard has its own lock and
+ * arena, so threads only contend when they create types in the same shard,
+ * and every thread gets the same object for equal types.
  */
 class TypeFactory final : public TypeFactoryBase {
 public:
+    /// Number of independently locked cache shards, a power of two
+    static constexpr std::size_t kShards = 16;
+
     /** Construct the factory and initialize all singleton types. */
     explicit TypeFactory(Context& context);
 
+    /** Get a singleton type by its TypeKind. */
+    using TypeFactoryBase::getSingleton;
+
     /** Get the pre-created ANY PTR type (equivalent to C void*). */
     [[nodiscard]] auto getAnyPtr() const -> const TypePointer* { return m_anyPtr; }
 
@@ -40,27 +59,28 @@ public:
     [[nodiscard]] auto getContext() const -> Context& { return m_context; }
 
 private:
-    /** Allocate raw memory from the arena. */
-    [[nodiscard]] auto allocate(std::size_t size, std::size_t alignment) const -> void*;
-
     /**
-     * Construct a type in arena-allocated memory.
+     * Construct a type in memory from @p allocator.
      *
      * Types are never individually freed; the arena owns their lifetime.
      */
     template<std::derived_from<Type> T, typename... Args>
-    [[nodiscard]] auto create(Args&&... args) -> const T* {
-        void* addr = allocate(sizeof(T), alignof(T));
+    [[nodiscard]] static auto create(llvm::BumpPtrAllocator& allocator, Args&&... args) -> const T* {
+        void* addr = allocator.Allocate(sizeof(T), alignof(T));
         new (addr) T(std::forward<Args>(args)...);
         return static_cast<const T*>(addr);
     }
 
+    /**
+     * Get the type memoised in @p slot of @p base, creating it in the shard
+     * of @p base if it does not exist yet.
+     */
+    template<std::derived_from<Type> T>
+    [[nodiscard]] auto derive(std::atomic<const T*>& slot, const Type* base) -> const T*;
+
     /** Create and register all singleton type instances. */
     void createSingletonTypes();
 
-    Context& m_context;             ///< The owning context providing arena allocation
-    const TypePointer* m_anyPtr {}; ///< Any Ptr is frequent, so pre-create it
-
     // -------------------------------------------------------------------------
     // Function type cache (keyed by pre-computed hash, buckets for collisions)
     // -------------------------------------------------------------------------
@@ -72,16 +92,29 @@ private:
         }
     };
     using FunctionMap = std::unordered_map<llvm::hash_code, llvm::SmallVector<const TypeFunction*, 2>, FunctionKeyHash>;
-    FunctionMap m_functions; ///< Cached function types
 
     // -------------------------------------------------------------------------
-    // Compound type caches (keyed by base type pointer)
+    // Shards
     // -------------------------------------------------------------------------
 
-    template<typename T>
-    using Map = std::unordered_map<const Type*, T>;
-    Map<const TypePointer*> m_pointers;     ///< Cached pointer types
-    Map<const TypeReference*> m_references; ///< Cached reference types
-    Map<const TypeConst*> m_consts;         ///< Cached const-qualified types
+    /// Bytes between shards, so their locks do not share a cache line
+    static constexpr std::size_t kShardAlignment = 64;
+
+    /// A slice of the types with the lock and arena they are created with
+    struct alignas(kShardAlignment) Shard final {
+        std::mutex mutex;                 ///< Guards the rest of the shard and the slots of its base types
+        llvm::BumpPtrAllocator allocator; ///< Memory of the types created in this shard
+        FunctionMap functions;            ///< Cached function types
+    };
+
+    /** Get the shard of a key with @p hash. */
+    [[nodiscard]] auto getShard(std::size_t hash) -> Shard&;
+
+    /** Get the shard of a compound type with @p base. */
+    [[nodiscard]] auto getShard(const Type* base) -> Shard&;
+
+    Context& m_context;                  ///< The owning context
+    const TypePointer* m_anyPtr {};      ///< Any Ptr is frequent, so pre-create it
+    std::array<Shard, kShards> m_shards; ///< Hash-consed types by key hash
 };
 } // namespace lbc
@@ -0,0 +1,131 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include "pch.hpp"
+#include <cstring>
+#include <llvm/ADT/SmallVector.h>
+namespace lbc {
+
+/**
+ * A stack of reusable scratch buffers for collecting lists of nodes.
+ *
+ * Every open list borrows the buffer at the current depth and returns it
+ * when it goes out of scope, so nested lists (a statement list inside a
+ * function body, call arguments inside call arguments) each get their own
+ * buffer. Buffers are cleared, not freed, when reused. Once the stack has
+ * seen the deepest nesting of the input, collecting a list does not touch
+ * the heap, and a completed list is copied into the arena in one memcpy.
+ *
+ * Lists must be released in reverse order of acquisition, which scoped
+ * List objects guarantee.
+ *
+ * @code
+ * auto args = m_scratch.list<AstExpr>();
+ * TRY_ADD(args, expression())
+ * return args.sequence(allocator);
+ * @endcode
+ */
+class ScratchStack final {
+    /// Node pointers are stored type erased, all object pointers share one representation
+    using Buffer = llvm::SmallVector<void*, 16>;
+
+public:
+    NO_COPY_AND_MOVE(ScratchStack)
+    ScratchStack() = default;
+
+    /**
+     * A list of T pointers collected into a borrowed scratch buffer.
+     */
+    template<typename T>
+    class List final {
+    public:
+        NO_COPY_AND_MOVE(List)
+
+        /// Convenience alias for a pointer to the node type.
+        using pointer = T*;
+
+        ~List() { m_stack.release(m_depth); }
+
+        /**
+         * Add a node to the end of the list.
+         */
+        void add(pointer node) {
+            m_buffer.push_back(node);
+        }
+
+        /**
+         * Append content of the span to this list.
+         */
+        template<std::convertible_to<pointer> U>
+        void append(std::span<U> nodes) {
+            for (pointer node : nodes) {
+                add(node);
+            }
+        }
+
+        /// Number of nodes collected so far
+        [[nodiscard]] auto size() const -> std::size_t { return m_buffer.size(); }
+
+        /**
+         * Copy the collected nodes into a contiguous buffer allocated
+         * in the arena, in order of addition.
+         *
+         * @param allocator The memory arena to allocate the buffer from.
+         * @returns A std::span<T*> containing all nodes in order.
+         */
+        [[nodiscard]] auto sequence(llvm::BumpPtrAllocator& allocator) const -> std::span<pointer> {
+            if (m_buffer.empty()) {
+                return {};
+            }
+            auto* data = allocator.Allocate<pointer>(m_buffer.size());
+            std::memcpy(data, m_buffer.data(), m_buffer.size() * sizeof(pointer));
+            return { data, m_buffer.size() };
+        }
+
+    private:
+        friend class ScratchStack;
+
+        List(ScratchStack& stack, const std::size_t depth)
+        : m_stack(stack)
+        , m_buffer(stack.buffer(depth))
+        , m_depth(depth) {}
+
+        ScratchStack& m_stack; // NOLINT(*-avoid-const-or-ref-data-members)
+        Buffer& m_buffer;      // NOLINT(*-avoid-const-or-ref-data-members)
+        std::size_t m_depth;
+    };
+
+    /**
+     * Open a new list on top of the stack.
+     */
+    template<typename T>
+    [[nodiscard]] auto list() -> List<T> {
+        static_assert(sizeof(T*) == sizeof(void*), "scratch buffers store object pointers");
+        return List<T>(*this, m_depth++);
+    }
+
+private:
+    /// Get the cleared buffer at depth, creating it on first use
+    [[nodiscard]] auto buffer(const std::size_t depth) -> Buffer& {
+        if (depth == m_buffers.size()) {
+            m_buffers.push_back(std::make_unique<Buffer>());
+        }
+        auto& buffer = *m_buffers[depth];
+        buffer.clear();
+        return buffer;
+    }
+
+    /// Return the buffer at depth, which must be the top of the stack
+    void release([[maybe_unused]] const std::size_t depth) {
+        assert(depth + 1 == m_depth && "scratch lists released out of order");
+        m_depth--;
+    }
+
+    /// Buffers by depth. Held by pointer, so growing the stack keeps open lists valid
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+    /// Number of open lists
+    std::size_t m_depth = 0;
+};
+
+} // namespace lbc
@@ -129,13 +129,13 @@
 
 /**
  * Evaluate a `std::expected` expression, propagate on error,
- * and append the value to a `Sequencer` on success.
+ * and append the value to a `ScratchStack::List` on success.
  *
- * @param seq Sequencer to add the value to.
+ * @param seq List to add the value to.
  * @param ... Expression returning `std::expected`.
  *
  * @code
- * Sequencer<AstVarDecl> decls {};
+ * auto decls = scratch<AstVarDecl>();
  * TRY_ADD(decls, varDecl())
  * @endcode
  */
@@ -52,6 +52,8 @@ cl::opt<bool> dumpAst("dump-ast", cl::desc("Dump the parsed AST to stderr"), cl:
 cl::opt<bool> dumpIr("dump-ir", cl::desc("Dump the lbc IR to stderr"), cl::cat(lbcCategory));
 cl::opt<bool> dumpConfig("dump-config", cl::desc("Dump the options as a command line to stderr"), cl::cat(lbcCategory));
 cl::opt<bool> verbose("verbose", cl::desc("Enable verbose output"), cl::cat(lbcCategory));
+cl::opt<bool> lazyBodies("lazy-bodies", cl::desc("Parse, analyse and lower SUB / FUNCTION bodies only when reachable"), cl::cat(lbcCategory));
+cl::opt<bool> emitInterface("emit-interface", cl::desc("Write each module's interface for IMPORT to the build directory"), cl::cat(lbcCategory));
 
 cl::opt<CompileOptions::OptimizationLevel> optLevel(
     cl::desc("Optimisation level:"),
@@ -142,6 +144,8 @@ cl::opt<CompileOptions::Platform> targetPlatform(
     options.setDumpIr(dumpIr);
     options.setDumpConfig(dumpConfig);
     options.setVerbose(verbose);
+    options.setLazyBodies(lazyBodies);
+    options.setEmitInterface(emitInterface);
     return options;
 }
 } // namespace
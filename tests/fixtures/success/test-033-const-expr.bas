@@ -1,4 +1,4 @@
-'' SKIP: not yet supported: CONST declarations
+'' SKIP: not yet supported: IF expressions
 ''------------------------------------------------------------------------------
 '' test-0330-const-expr.bas
 '' Test constant expressions
@@ -1,4 +1,4 @@
-'' SKIP: not yet supported: CONST declarations
+'' SKIP: not yet supported: IF expressions
 ''------------------------------------------------------------------------------
 '' test-034-const-string-operations.bas
 ''
@@ -1,4 +1,3 @@
-'' SKIP: not yet supported: CONST declarations
 ''------------------------------------------------------------------------------
 '' test-035-const-conversions.bas
 ''
@@ -1,4 +1,4 @@
-'' SKIP: not yet supported: CONST declarations
+'' SKIP: not yet supported: IS expressions
 ''------------------------------------------------------------------------------
 '' test-036-is-expr.bas
 ''
@@ -0,0 +1,23 @@
+''------------------------------------------------------------------------------
+'' test-044-const-fold.bas
+'' - untyped constants coerce like literals
+'' - typed constants keep their type
+'' - constant expressions fold in the type of their context
+''
+'' CHECK: 10, 7, 7, 44, 2.5
+''------------------------------------------------------------------------------
+extern "C" declare function printf(fmt as zstring, ...) as integer
+
+const n = 2 + 3
+const b as ubyte = 300
+const half as double = 5.0 / 2.0
+
+dim x = n * 2
+dim y as byte = n + 2
+dim w as ubyte = (200 + 100) / 6
+
+dim iy as integer = y
+dim iw as integer = w
+dim ib as integer = b
+
+printf "%d, %d, %d, %d, %.1lf", x, iy, iw, ib, half
@@ -65,22 +65,44 @@ auto count(const std::string& haystack, const llvm::StringRef needle) -> std::si
 // -------------------------------------------------------------------------
 
 TEST(GenTests, GlobalVariableWithInitializer) {
-    const auto ir = emitLlvm("DIM x AS INTEGER = 42\n");
+    // passing x to an external SUB keeps it reachable without storing to it
+    const auto ir = emitLlvm("DECLARE SUB consume(value AS INTEGER)\nDIM x AS INTEGER = 42\nconsume x\n");
     // Exactly one global is materialised (a single declaration must not be
     // lowered twice), as a definition...
     EXPECT_EQ(count(ir, "= internal global"), 1U) << ir;
-    EXPECT_TRUE(contains(ir, "@X = internal global i64 0")) << ir;
-    // ...and its initialiser runs as a single store into that global in `main`.
-    EXPECT_TRUE(contains(ir, "store i64 42, ptr @X")) << ir;
-    EXPECT_EQ(count(ir, "store i64 42"), 1U) << ir;
+    // ...that starts out with the constant instead of storing it in `main`.
+    EXPECT_TRUE(contains(ir, "@X = internal global i64 42")) << ir;
+    EXPECT_FALSE(contains(ir, "store")) << ir;
 }
 
 TEST(GenTests, GlobalVariableWithoutInitializer) {
-    const auto ir = emitLlvm("DIM y AS INTEGER\n");
+    const auto ir = emitLlvm("DECLARE SUB consume(value AS INTEGER)\nDIM y AS INTEGER\nconsume y\n");
     // Still exactly one global definition, but with no store (no initialiser).
     EXPECT_EQ(count(ir, "= internal global"), 1U) << ir;
     EXPECT_TRUE(contains(ir, "@Y = internal global i64 0")) << ir;
     EXPECT_FALSE(contains(ir, "store")) << ir;
 }
 
+TEST(GenTests, UnreachableGlobalIsNotMaterialised) {
+    // Nothing reads z, so there is no global, yet its initialiser still runs.
+    const auto ir = emitLlvm("DECLARE FUNCTION counter() AS INTEGER\nDIM z AS INTEGER = counter()\n");
+    EXPECT_FALSE(contains(ir, "= internal global")) << ir;
+    EXPECT_TRUE(contains(ir, "call i64 @COUNTER(")) << ir;
+}
+
+TEST(GenTests, EvaluatedInitializerIsStaticData) {
+    // seed() runs at compile time, so it is neither called nor lowered
+    const auto ir = emitLlvm(
+        "DECLARE SUB consume(value AS INTEGER)\n"
+        "FUNCTION seed(n AS INTEGER) AS INTEGER\n"
+        "    RETURN n * 2 + 2\n"
+        "END FUNCTION\n"
+        "DIM x AS INTEGER = seed(20)\n"
+        "consume x\n"
+    );
+    EXPECT_TRUE(contains(ir, "@X = internal global i64 42")) << ir;
+    EXPECT_FALSE(contains(ir, "@SEED")) << ir;
+    EXPECT_FALSE(contains(ir, "store")) << ir;
+}
+
 } // namespace
@@ -36,6 +36,62 @@ auto irGenSucceeds(const llvm::StringRef source) -> bool {
     return gen.generate(**parsed).has_value();
 }
 
+/// What the pipeline lowered
+struct Lowered final {
+    std::size_t functions; ///< lowered function definitions
+    std::size_t globals;   ///< lowered module level variables
+    std::size_t removed;   ///< unreachable definitions reported under -verbose
+};
+
+/**
+ * Run the full pipeline with verbose output, parsing bodies as given by
+ * @p bodies, and return what was lowered, or nullopt if any stage failed.
+ */
+auto lower(const llvm::StringRef source, const Parser::Bodies bodies) -> std::optional<Lowered> {
+    CompileOptions options;
+    options.setVerbose(true);
+    Context context { options };
+    context.getDiag().setAutoPrint(false);
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id, Parser::Tokenise::Upfront, bodies };
+
+    const auto parsed = parser.parse();
+    if (!parsed.has_value()) {
+        return std::nullopt;
+    }
+
+    SemanticAnalyser sema { context };
+    const auto loader = [&](AstFuncStmt& ast) { return parser.parseBody(ast); };
+    const auto analysed = bodies == Parser::Bodies::Lazy ? sema.analyse(**parsed, loader) : sema.analyse(**parsed);
+    if (!analysed) {
+        return std::nullopt;
+    }
+
+    ir::gen::IrGenerator gen { context };
+    const auto module = gen.generate(**parsed);
+    if (!module.has_value()) {
+        return std::nullopt;
+    }
+    return Lowered {
+        .functions = (*module)->getFunctions().size(),
+        .globals = (*module)->getDeclarations().size(),
+        .removed = context.getDiag().count(llvm::SourceMgr::DK_Note),
+    };
+}
+
+/**
+ * Run the full pipeline with lazily parsed bodies and return the number of
+ * lowered function definitions, or nullopt if any stage failed.
+ */
+auto lazyFunctionCount(const llvm::StringRef source) -> std::optional<std::size_t> {
+    const auto lowered = lower(source, Parser::Bodies::Lazy);
+    if (!lowered) {
+        return std::nullopt;
+    }
+    return lowered->functions;
+}
+
 // -------------------------------------------------------------------------
 // Tests
 // -------------------------------------------------------------------------
@@ -67,4 +123,72 @@ TEST(IrGenTests, ExternVariadicSucceeds) {
     EXPECT_TRUE(irGenSucceeds("EXTERN \"C\" DECLARE FUNCTION printf(fmt AS ZSTRING, ...) AS INTEGER\n"));
 }
 
+TEST(IrGenTests, LazyBodiesLowerOnlyReachableFunctions) {
+    // unused() is never called, so its body is neither parsed nor analysed
+    EXPECT_EQ(lazyFunctionCount(
+        "DIM x = twice(2)\n"
+        "FUNCTION twice(a AS INTEGER) AS INTEGER\n"
+        "    RETURN add(a, a)\n"
+        "END FUNCTION\n"
+        "FUNCTION add(a AS INTEGER, b AS INTEGER) AS INTEGER\n"
+        "    RETURN a + b\n"
+        "END FUNCTION\n"
+        "SUB unused()\n"
+        "    DIM y AS INTEGER = undefined + + \n"
+        "END SUB\n"
+    ), 2U);
+}
+
+TEST(IrGenTests, LazyBodiesReportErrorsInReachableBodies) {
+    EXPECT_EQ(lazyFunctionCount(
+        "DIM x = used()\n"
+        "FUNCTION used() AS INTEGER\n"
+        "    RETURN undefined\n"
+        "END FUNCTION\n"
+    ), std::nullopt);
+}
+
+TEST(IrGenTests, UnreachableFunctionsAreNotLowered) {
+    // unused() is analysed, but nothing reachable calls it or dead(). Nothing
+    // reads x either, but its initialiser still calls twice() from top-level
+    // code: x, unused() and dead() are removed, twice() and add() lowered.
+    const auto lowered = lower(
+        "DIM x = twice(2)\n"
+        "FUNCTION twice(a AS INTEGER) AS INTEGER\n"
+        "    RETURN add(a, a)\n"
+        "END FUNCTION\n"
+        "FUNCTION add(a AS INTEGER, b AS INTEGER) AS INTEGER\n"
+        "    RETURN a + b\n"
+        "END FUNCTION\n"
+        "SUB unused()\n"
+        "    dead()\n"
+        "END SUB\n"
+        "SUB dead()\n"
+        "    unused()\n"
+        "END SUB\n",
+        Parser::Bodies::Eager
+    );
+    ASSERT_TRUE(lowered.has_value());
+    EXPECT_EQ(lowered->functions, 2U);
+    EXPECT_EQ(lowered->removed, 3U);
+}
+
+TEST(IrGenTests, UnreachableGlobalsAreNotLowered) {
+    // x reads used, unused is only read by a function nothing calls. x is
+    // not read either: x, unused and get() are removed.
+    const auto lowered = lower(
+        "DIM used AS INTEGER = 1\n"
+        "DIM unused AS INTEGER = 2\n"
+        "DIM x = used\n"
+        "FUNCTION get() AS INTEGER\n"
+        "    RETURN unused\n"
+        "END FUNCTION\n",
+        Parser::Bodies::Eager
+    );
+    ASSERT_TRUE(lowered.has_value());
+    EXPECT_EQ(lowered->globals, 1U);
+    EXPECT_EQ(lowered->functions, 0U);
+    EXPECT_EQ(lowered->removed, 3U);
+}
+
 } // namespace
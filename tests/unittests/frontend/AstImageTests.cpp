@@ -0,0 +1,183 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
+#include "Ast/AstCodePrinter.hpp"
+#include "Ast/AstImage.hpp"
+#include "Driver/Context.hpp"
+#include "IR/gen/IrGenerator.hpp"
+#include "IR/printer/Printer.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+#include "Symbol/Symbol.hpp"
+using namespace lbc;
+
+namespace {
+
+constexpr llvm::StringRef kSource = R"(extern "C" declare function printf(fmt as zstring, ...) as integer
+
+function add(a as integer, b as integer) as integer
+    return a + b
+end function
+
+sub say(prefix as zstring)
+    printf "%s, %d!\n", prefix, add(1, 2)
+end sub
+
+dim x as integer = add(3, 4)
+)";
+
+/** Add @param source to @param context as a new buffer and return its id. */
+auto addBuffer(Context& context, const llvm::StringRef source) -> unsigned {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    return context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+}
+
+/** Parse and analyse @param source, nullptr on failure. */
+auto compile(Context& context, const llvm::StringRef source) -> AstModule* {
+    Parser parser { context, addBuffer(context, source) };
+    const auto parsed = parser.parse();
+    if (!parsed.has_value()) {
+        return nullptr;
+    }
+    if (SemanticAnalyser sema { context }; !sema.analyse(**parsed)) {
+        return nullptr;
+    }
+    return *parsed;
+}
+
+/** Print @param module as source code. */
+auto print(const AstModule& module) -> std::string {
+    std::string output;
+    llvm::raw_string_ostream ss { output };
+    AstCodePrinter { ss }.print(module);
+    return output;
+}
+
+/** Lower @param module and print the IR without colors. */
+auto lower(Context& context, const AstModule& module) -> std::string {
+    ir::gen::IrGenerator gen { context };
+    const auto result = gen.generate(module);
+    if (!result.has_value()) {
+        return "<lowering failed>";
+    }
+    std::string output;
+    llvm::raw_string_ostream ss { output };
+    ir::printer::Printer { ss, false }.print(**result);
+    return output;
+}
+
+/** Temporary image file, removed on destruction. */
+struct ImageFile final {
+    explicit ImageFile(Context& context)
+    : path(context.createTempFile("lbca")) {}
+
+    ~ImageFile() { std::ignore = llvm::sys::fs::remove(path); }
+
+    ImageFile(const ImageFile&) = delete;
+    ImageFile(ImageFile&&) = delete;
+    auto operator=(const ImageFile&) -> ImageFile& = delete;
+    auto operator=(ImageFile&&) -> ImageFile& = delete;
+
+    std::string path;
+};
+
+} // namespace
+
+TEST(AstImageTests, LoadedModulePrintsAndLowersTheSame) {
+    Context original;
+    auto* module = compile(original, kSource);
+    ASSERT_NE(module, nullptr);
+    const auto source = print(*module);
+    const auto ir = lower(original, *module);
+
+    ImageFile file { original };
+    ASSERT_FALSE(file.path.empty());
+    AstImageWriter writer { original };
+    ASSERT_TRUE(writer.write(*module, file.path).has_value());
+
+    Context loaded;
+    AstImageReader reader { loaded };
+    const auto result = reader.load(file.path);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(print(**result), source);
+    EXPECT_EQ(lower(loaded, **result), ir);
+}
+
+TEST(AstImageTests, LoadedSymbolsUseTheContextTypes) {
+    Context original;
+    auto* module = compile(original, kSource);
+    ASSERT_NE(module, nullptr);
+    ImageFile file { original };
+    AstImageWriter writer { original };
+    ASSERT_TRUE(writer.write(*module, file.path).has_value());
+
+    Context loaded;
+    AstImageReader reader { loaded };
+    const auto result = reader.load(file.path);
+    ASSERT_TRUE(result.has_value());
+
+    const auto* table = (*result)->getStmtList()->getSymbolTable();
+    ASSERT_NE(table, nullptr);
+    const auto* add = table->find(loaded.getIdentifiers().get("ADD"));
+    ASSERT_NE(add, nullptr);
+    ASSERT_EQ(add->getRelatedSymbols().size(), 2U);
+
+    // Types are hash-consed again, so equal types are the same object
+    auto& factory = loaded.getTypeFactory();
+    std::array<const Type*, 2> params { factory.getInteger(), factory.getInteger() };
+    EXPECT_EQ(add->getType(), factory.getFunction(params, factory.getInteger()));
+    EXPECT_EQ(add->getRelatedSymbols()[0]->getType(), factory.getInteger());
+
+    const auto* printf = table->find(loaded.getIdentifiers().get("PRINTF"));
+    ASSERT_NE(printf, nullptr);
+    EXPECT_EQ(printf->getExternKind(), ExternKind::C);
+    EXPECT_EQ(printf->getAlias(), "printf");
+}
+
+TEST(AstImageTests, RangesMoveIntoTheGivenSource) {
+    Context original;
+    auto* module = compile(original, kSource);
+    ASSERT_NE(module, nullptr);
+    const auto* decl = module->getStmtList()->getDecls().back();
+    const auto expected = original.resolve(decl->getRange());
+    const auto text = std::string { expected.Start.getPointer(), expected.End.getPointer() };
+
+    ImageFile file { original };
+    AstImageWriter writer { original };
+    ASSERT_TRUE(writer.write(*module, file.path).has_value());
+
+    // Without the source, ranges are dropped
+    Context bare;
+    const auto dropped = AstImageReader { bare }.load(file.path);
+    ASSERT_TRUE(dropped.has_value());
+    EXPECT_FALSE((*dropped)->getStmtList()->getDecls().back()->getRange().isValid());
+
+    // With the source in another buffer, they move with it
+    Context loaded;
+    std::ignore = addBuffer(loaded, "dim unrelated = 1\n");
+    const auto id = addBuffer(loaded, kSource);
+    const auto result = AstImageReader { loaded }.load(file.path, id);
+    ASSERT_TRUE(result.has_value());
+    const auto resolved = loaded.resolve((*result)->getStmtList()->getDecls().back()->getRange());
+    EXPECT_EQ(std::string(resolved.Start.getPointer(), resolved.End.getPointer()), text);
+}
+
+TEST(AstImageTests, RejectsFilesThatAreNotImages) {
+    Context context;
+    context.getDiag().setAutoPrint(false);
+    ImageFile file { context };
+    {
+        std::error_code error;
+        llvm::raw_fd_ostream output { file.path, error };
+        ASSERT_FALSE(error);
+        output << kSource;
+    }
+
+    AstImageReader reader { context };
+    EXPECT_FALSE(reader.load(file.path).has_value());
+    EXPECT_FALSE(reader.load(file.path + ".missing").has_value());
+    EXPECT_EQ(context.getDiag().count(llvm::SourceMgr::DK_Error), 2U);
+}
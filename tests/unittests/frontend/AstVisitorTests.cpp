@@ -3,15 +3,28 @@
 //
 #include <gtest/gtest.h>
 #include "Ast/AstCodePrinter.hpp"
+#include "Ast/AstWalker.hpp"
+#include "Symbol/IdentifierTable.hpp"
 
 using namespace lbc;
 
+namespace {
+
+/** Identifier of @param name, interned in a table shared by the tests. */
+auto identifier(const llvm::StringRef name) -> Identifier {
+    static llvm::BumpPtrAllocator allocator;
+    static IdentifierTable table { allocator };
+    return table.get(name);
+}
+
+} // namespace
+
 // Validate visitor dispatches through multiple expression node types
 TEST(AstVisitorTests, ExprPrinterVisitsMultipleNodes) {
     // Build: foo(x + 42)
-    AstVarExpr callee({}, "foo");
-    AstVarExpr varX({}, "x");
-    AstLiteralExpr lit42({}, LiteralValue::from(std::uint64_t { 42 }));
+    AstVarExpr callee({}, identifier("foo"));
+    AstVarExpr varX({}, identifier("x"));
+    AstLiteralExpr lit42({}, LiteralValue::from(std::uint64_t { 42 }), TokenKind::Invalid);
     AstBinaryExpr binExpr({}, &varX, &lit42, TokenKind::Plus);
     AstExpr* args[] = { &binExpr };
     AstCallExpr callExpr({}, &callee, std::span(args));
@@ -20,5 +33,58 @@ TEST(AstVisitorTests, ExprPrinterVisitsMultipleNodes) {
     llvm::raw_string_ostream ss { output };
     AstCodePrinter printer { ss };
     printer.print(callExpr);
-    EXPECT_EQ(output, "foo((x + 42))");
+    EXPECT_EQ(output, "FOO((X + 42))");
+}
+
+// Walker hands out operands before the expressions using them, in source order
+TEST(AstVisitorTests, WalkerVisitsPostOrder) {
+    // Build: foo(x + 42, y)
+    AstVarExpr callee({}, identifier("foo"));
+    AstVarExpr varX({}, identifier("x"));
+    AstVarExpr varY({}, identifier("y"));
+    AstLiteralExpr lit42({}, LiteralValue::from(std::uint64_t { 42 }), TokenKind::Invalid);
+    AstBinaryExpr binExpr({}, &varX, &lit42, TokenKind::Plus);
+    AstExpr* args[] = { &binExpr, &varY };
+    AstCallExpr callExpr({}, &callee, std::span(args));
+
+    std::vector<const AstRoot*> order;
+    AstWalker walker;
+    const auto result = walker.postOrder(callExpr, [&](const AstRoot& node) -> DiagResult<void> {
+        order.push_back(&node);
+        return {};
+    });
+    ASSERT_TRUE(result.has_value());
+    const std::vector<const AstRoot*> expected { &callee, &varX, &lit42, &binExpr, &varY, &callExpr };
+    EXPECT_EQ(order, expected);
+}
+
+// A deep chain is walked without recursion, and stops at the first failure
+TEST(AstVisitorTests, WalkerHandlesDeepTrees) {
+    constexpr std::size_t depth = 100'000;
+    AstVarExpr var({}, identifier("x"));
+    std::vector<std::unique_ptr<AstBinaryExpr>> nodes;
+    AstExpr* lhs = &var;
+    for (std::size_t index = 0; index < depth; index++) {
+        nodes.push_back(std::make_unique<AstBinaryExpr>(SourceRange {}, lhs, &var, TokenKind::Plus));
+        lhs = nodes.back().get();
+    }
+
+    std::size_t count = 0;
+    AstWalker walker;
+    ASSERT_TRUE(walker.postOrder(*lhs, [&](const AstRoot&) -> DiagResult<void> {
+        count++;
+        return {};
+    }));
+    EXPECT_EQ(count, depth * 2 + 1);
+
+    count = 0;
+    const auto result = walker.postOrder(*lhs, [&](const AstRoot& node) -> DiagResult<void> {
+        count++;
+        if (&node == nodes.front().get()) {
+            return DiagError(DiagIndex {});
+        }
+        return {};
+    });
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(count, 3U);
 }
@@ -0,0 +1,92 @@
+#include "pch.hpp"
+#include <gtest/gtest.h>
+#include "Symbol/IdentifierTable.hpp"
+using namespace lbc;
+
+// ------------------------------------
+// Hashing
+// ------------------------------------
+
+TEST(IdentifierTableTests, HashIsCaseFolded) {
+    EXPECT_EQ(IdentifierTable::hash("hello"), IdentifierTable::hash("HELLO"));
+    EXPECT_EQ(IdentifierTable::hash("Foo_Bar1"), IdentifierTable::hash("fOO_bAR1"));
+    EXPECT_NE(IdentifierTable::hash("foo"), IdentifierTable::hash("fo"));
+    EXPECT_EQ(IdentifierTable::hash(""), IdentifierTable::kHashSeed);
+
+    // incremental hashing matches hashing the whole name
+    auto hash = IdentifierTable::kHashSeed;
+    for (const char ch : llvm::StringRef("MixedCase")) {
+        hash = IdentifierTable::hash(hash, ch);
+    }
+    EXPECT_EQ(hash, IdentifierTable::hash("mixedcase"));
+}
+
+// ------------------------------------
+// Interning
+// ------------------------------------
+
+TEST(IdentifierTableTests, InternsUpperCaseForm) {
+    llvm::BumpPtrAllocator allocator;
+    IdentifierTable table { allocator };
+
+    const auto first = table.intern("myVar");
+    EXPECT_EQ(first, "MYVAR");
+    // every spelling resolves to the same stored name
+    const auto second = table.intern("MYVAR");
+    const auto third = table.intern("myvar");
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_EQ(first.data(), third.data());
+    EXPECT_EQ(table.size(), 1U);
+
+    // distinct names stay distinct
+    EXPECT_NE(table.intern("myVar2").data(), first.data());
+    EXPECT_NE(table.intern("_myVar").data(), first.data());
+    EXPECT_EQ(table.size(), 3U);
+}
+
+TEST(IdentifierTableTests, GrowKeepsNamesStable) {
+    llvm::BumpPtrAllocator allocator;
+    IdentifierTable table { allocator };
+
+    std::vector<llvm::StringRef> names;
+    for (int idx = 0; idx < 2000; ++idx) {
+        names.push_back(table.intern("name" + std::to_string(idx)));
+    }
+    EXPECT_EQ(table.size(), 2000U);
+    for (int idx = 0; idx < 2000; ++idx) {
+        const auto name = table.intern("NAME" + std::to_string(idx));
+        EXPECT_EQ(name.data(), names[static_cast<std::size_t>(idx)].data());
+    }
+}
+
+// ------------------------------------
+// Identifier handles
+// ------------------------------------
+
+TEST(IdentifierTableTests, HandlesCompareByEntry) {
+    llvm::BumpPtrAllocator allocator;
+    IdentifierTable table { allocator };
+
+    const auto first = table.get("myVar");
+    EXPECT_TRUE(first.isValid());
+    EXPECT_EQ(first.str(), "MYVAR");
+    EXPECT_EQ(first, table.get("MYVAR"));
+    // interned names and the tokens holding them lead back to the same handle
+    EXPECT_EQ(first, Identifier::fromInterned(table.intern("myvar")));
+    EXPECT_NE(first, table.get("other"));
+
+    EXPECT_FALSE(Identifier {}.isValid());
+    EXPECT_TRUE(Identifier {}.str().empty());
+}
+
+TEST(IdentifierTableTests, HandlesAreIndexedDensely) {
+    llvm::BumpPtrAllocator allocator;
+    IdentifierTable table { allocator };
+
+    for (std::uint32_t idx = 0; idx < 1000; ++idx) {
+        EXPECT_EQ(table.get("name" + std::to_string(idx)).getIndex(), idx);
+    }
+    // growing the table keeps the entries, and with them the indices
+    EXPECT_EQ(table.get("NAME0").getIndex(), 0U);
+    EXPECT_EQ(table.get("Name999").getIndex(), 999U);
+}
@@ -0,0 +1,154 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "pch.hpp"
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include "Ast/AstImage.hpp"
+#include "Driver/Context.hpp"
+#include "IR/gen/IrGenerator.hpp"
+#include "IR/printer/Printer.hpp"
+#include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
+#include "Symbol/Symbol.hpp"
+using namespace lbc;
+
+namespace {
+
+constexpr llvm::StringRef kLibrary = R"(function add(a as integer, b as integer) as integer
+    return a + b
+end function
+
+sub reset()
+end sub
+)";
+
+/** Parse @param source, nullptr on failure. */
+auto parse(Context& context, const llvm::StringRef source) -> AstModule* {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id };
+    const auto parsed = parser.parse();
+    return parsed.has_value() ? *parsed : nullptr;
+}
+
+/** Directory holding the interface of kLibrary as mathlib.lbci, removed on destruction. */
+struct Library final {
+    Library() {
+        llvm::SmallString<128> path;
+        if (llvm::sys::fs::createUniqueDirectory("lbc", path)) {
+            return;
+        }
+        dir = std::string { path.data(), path.size() };
+
+        Context context;
+        auto* module = parse(context, kLibrary);
+        if (module == nullptr || !SemanticAnalyser { context }.analyse(*module).has_value()) {
+            return;
+        }
+        llvm::sys::path::append(path, "mathlib." + Context::kInterfaceExtension);
+        if (AstImageWriter { context }.writeInterface(*module, path).has_value()) {
+            interface = std::string { path.data(), path.size() };
+        }
+    }
+
+    ~Library() {
+        if (!dir.empty()) {
+            std::ignore = llvm::sys::fs::remove_directories(dir);
+        }
+    }
+
+    Library(const Library&) = delete;
+    Library(Library&&) = delete;
+    auto operator=(const Library&) -> Library& = delete;
+    auto operator=(Library&&) -> Library& = delete;
+
+    /** Options that find the interface through the include path. */
+    [[nodiscard]] auto options() const -> CompileOptions {
+        CompileOptions options;
+        options.addIncludePath(dir);
+        return options;
+    }
+
+    std::string dir;
+    std::string interface;
+};
+
+} // namespace
+
+TEST(ImportTests, ImportedFunctionsAreDeclaredAndCalled) {
+    const Library library;
+    ASSERT_FALSE(library.interface.empty());
+
+    Context context { library.options() };
+    EXPECT_EQ(context.findInterface("mathlib"), library.interface);
+    auto* module = parse(context, "import mathlib\ndim x as integer = add(1, 2)\nreset()\n");
+    ASSERT_NE(module, nullptr);
+    ASSERT_TRUE(SemanticAnalyser { context }.analyse(*module).has_value());
+
+    const auto* table = module->getStmtList()->getSymbolTable();
+    const auto* add = table->find(context.getIdentifiers().get("ADD"), false);
+    ASSERT_NE(add, nullptr);
+    EXPECT_TRUE(add->hasFlag(SymbolFlags::Function));
+    auto& factory = context.getTypeFactory();
+    std::array<const Type*, 2> params { factory.getInteger(), factory.getInteger() };
+    EXPECT_EQ(add->getType(), factory.getFunction(params, factory.getInteger()));
+
+    // Calls lower to the functions of the imported module, which are not defined here
+    ir::gen::IrGenerator gen { context };
+    const auto ir = gen.generate(*module);
+    ASSERT_TRUE(ir.has_value());
+    std::string output;
+    llvm::raw_string_ostream ss { output };
+    ir::printer::Printer { ss, false }.print(**ir);
+    EXPECT_NE(output.find("ADD"), std::string::npos);
+    EXPECT_NE(output.find("RESET"), std::string::npos);
+}
+
+TEST(ImportTests, ImportingTwiceDeclaresOnce) {
+    const Library library;
+    ASSERT_FALSE(library.interface.empty());
+
+    Context context { library.options() };
+    auto* module = parse(context, "import mathlib\nimport mathlib\nreset()\n");
+    ASSERT_NE(module, nullptr);
+    EXPECT_TRUE(SemanticAnalyser { context }.analyse(*module).has_value());
+}
+
+TEST(ImportTests, RejectsUnknownModules) {
+    Context context;
+    context.getDiag().setAutoPrint(false);
+    auto* module = parse(context, "import nosuchmodule\n");
+    ASSERT_NE(module, nullptr);
+    const auto result = SemanticAnalyser { context }.analyse(*module);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(context.getDiag().getKind(result.error()), DiagKind::moduleNotFound);
+}
+
+TEST(ImportTests, RejectsRedefinitionOfImportedFunctions) {
+    const Library library;
+    ASSERT_FALSE(library.interface.empty());
+
+    Context context { library.options() };
+    context.getDiag().setAutoPrint(false);
+    auto* module = parse(context, "import mathlib\nsub reset()\nend sub\n");
+    ASSERT_NE(module, nullptr);
+    const auto result = SemanticAnalyser { context }.analyse(*module);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(context.getDiag().getKind(result.error()), DiagKind::redefinition);
+}
+
+TEST(ImportTests, RejectsImportInsideFunctions) {
+    const Library library;
+    ASSERT_FALSE(library.interface.empty());
+
+    Context context { library.options() };
+    context.getDiag().setAutoPrint(false);
+    auto* module = parse(context, "sub run()\n    import mathlib\nend sub\n");
+    ASSERT_NE(module, nullptr);
+    const auto result = SemanticAnalyser { context }.analyse(*module);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(context.getDiag().getKind(result.error()), DiagKind::importOutsideModule);
+}
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include "Driver/Context.hpp"
 #include "Lexer/Lexer.hpp"
+#include "Lexer/Scan.hpp"
+#include "Lexer/TokenBuffer.hpp"
 #include "Lexer/TokenKind.hpp"
 using namespace lbc;
 
@@ -147,6 +149,93 @@ TEST(LexerTests, NumberLiterals) {
     EXPECT_FALSE(makeLexer(context, "123abc").next().has_value());
 }
 
+TEST(LexerTests, LongNumberLiterals) {
+    Context context;
+    // runs of eight digits are folded at once, the tail one by one
+    EXPECT_EQ(tok(makeLexer(context, "1234567890123").next()).getValue().get<std::uint64_t>(), 1234567890123U);
+    EXPECT_EQ(tok(makeLexer(context, "18446744073709551615").next()).getValue().get<std::uint64_t>(), 18446744073709551615U);
+    EXPECT_EQ(tok(makeLexer(context, "0000000000000000000000042").next()).getValue().get<std::uint64_t>(), 42U);
+    // overflow is an error
+    EXPECT_FALSE(makeLexer(context, "18446744073709551616").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "123456789012345678901234").next().has_value());
+    // too many digits for an exact mantissa takes the slow path
+    EXPECT_EQ(tok(makeLexer(context, "0.1234567890123456789012").next()).getValue().get<double>(), 0.1234567890123456789012);
+    EXPECT_EQ(tok(makeLexer(context, "123456789012345678901234.5").next()).getValue().get<double>(), 123456789012345678901234.5);
+}
+
+TEST(LexerTests, ExponentLiterals) {
+    Context context;
+    const auto value = [&](const llvm::StringRef source) {
+        const auto token = tok(makeLexer(context, source).next());
+        EXPECT_EQ(token.kind(), TokenKind::FloatLiteral);
+        return token.getValue().get<double>();
+    };
+    EXPECT_EQ(value("1E6"), 1e6);
+    EXPECT_EQ(value("2.5e-3"), 2.5e-3);
+    EXPECT_EQ(value("7e+2"), 7e2);
+    EXPECT_EQ(value(".5E1"), 5.0);
+    EXPECT_EQ(value("1e300"), 1e300);
+    EXPECT_EQ(value("4.9e-324"), 4.9e-324);
+    // missing exponent digits and out of range values are errors
+    EXPECT_FALSE(makeLexer(context, "1e").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "1e+").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "1e400").next().has_value());
+}
+
+TEST(LexerTests, RadixLiterals) {
+    Context context;
+    const auto value = [&](const llvm::StringRef source) {
+        const auto token = tok(makeLexer(context, source).next());
+        EXPECT_EQ(token.kind(), TokenKind::IntegerLiteral);
+        return token.getValue().get<std::uint64_t>();
+    };
+    EXPECT_EQ(value("&HFF"), 255U);
+    EXPECT_EQ(value("&hdeadBEEF"), 0xDEAD'BEEFU);
+    EXPECT_EQ(value("&HFFFFFFFFFFFFFFFF"), 0xFFFF'FFFF'FFFF'FFFFU);
+    EXPECT_EQ(value("&O777"), 0777U);
+    EXPECT_EQ(value("&O1777777777777777777777"), 0xFFFF'FFFF'FFFF'FFFFU);
+    EXPECT_EQ(value("&B1010"), 10U);
+    // no digits, digits outside the radix and overflow are errors
+    EXPECT_FALSE(makeLexer(context, "&H").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&B102").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&O8").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&H10000000000000000").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&O2000000000000000000000").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&X1").next().has_value());
+}
+
+TEST(LexerTests, TypeSuffixes) {
+    Context context;
+    const auto suffix = [&](const llvm::StringRef source) {
+        return tok(makeLexer(context, source).next()).getTypeSuffix();
+    };
+    EXPECT_EQ(suffix("1"), TokenKind::Invalid);
+    EXPECT_EQ(suffix("1%"), TokenKind::Integer);
+    EXPECT_EQ(suffix("1u"), TokenKind::UInteger);
+    EXPECT_EQ(suffix("1L"), TokenKind::Long);
+    EXPECT_EQ(suffix("1UL"), TokenKind::ULong);
+    EXPECT_EQ(suffix("1ll"), TokenKind::LongInt);
+    EXPECT_EQ(suffix("1ULL"), TokenKind::ULongInt);
+    EXPECT_EQ(suffix("&HFFU"), TokenKind::UInteger);
+    EXPECT_EQ(suffix("1.5F"), TokenKind::Single);
+    EXPECT_EQ(suffix("1.5!"), TokenKind::Single);
+    EXPECT_EQ(suffix("2e3D"), TokenKind::Double);
+    EXPECT_EQ(suffix("2#"), TokenKind::Double);
+
+    // a float suffix makes a float literal
+    const auto single = tok(makeLexer(context, "3f").next());
+    EXPECT_EQ(single.kind(), TokenKind::FloatLiteral);
+    EXPECT_EQ(single.getValue().get<double>(), 3.0);
+    EXPECT_EQ(single.lexeme(), "3f");
+
+    // suffixes that do not suit the literal, and trailing identifier characters
+    EXPECT_FALSE(makeLexer(context, "1.5U").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "&B1F").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "1ULX").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "1LLL").next().has_value());
+    EXPECT_FALSE(makeLexer(context, "1.5.2").next().has_value());
+}
+
 // ------------------------------------
 // Operators and symbols
 // ------------------------------------
@@ -222,6 +311,38 @@ TEST(LexerTests, Identifiers) {
     const auto t = tok(makeLexer(context, "_foo").next());
     EXPECT_EQ(t.kind(), TokenKind::Identifier);
     EXPECT_EQ(t.string(), "_FOO");
+    // every spelling of a name is interned once
+    const auto lower = tok(makeLexer(context, "counter").next());
+    const auto mixed = tok(makeLexer(context, "CoUnTeR").next());
+    EXPECT_EQ(lower.getValue().get<llvm::StringRef>(), "COUNTER");
+    EXPECT_EQ(lower.getValue().get<llvm::StringRef>().data(), mixed.getValue().get<llvm::StringRef>().data());
+}
+
+TEST(LexerTests, KeywordRecogniser) {
+    // every keyword, type and keyword-like operator round trips in any case
+    const auto check = [](const TokenKind kind) {
+        const auto upper = kind.string().str();
+        EXPECT_EQ(TokenKind::fromIdentifier(upper), kind) << upper;
+        EXPECT_EQ(TokenKind::fromIdentifier(llvm::StringRef(upper).lower()), kind) << upper;
+    };
+    for (const auto kind : TokenKind::allKeywords()) {
+        check(kind);
+    }
+    for (const auto kind : TokenKind::allTypes()) {
+        check(kind);
+    }
+    for (const auto kind : TokenKind::allOperatorKeywords()) {
+        check(kind);
+    }
+    // near misses are plain identifiers
+    for (const auto* str : { "FO", "FORX", "F0R", "_OR", "LONGINT1", "ZSTRINGS", "TYPE_", "X" }) {
+        EXPECT_EQ(TokenKind::fromIdentifier(str), TokenKind::Identifier) << str;
+    }
+    // the lexer keeps the source spelling of keywords
+    Context context;
+    const auto kw = tok(makeLexer(context, "uLongInt").next());
+    EXPECT_EQ(kw.kind(), TokenKind::ULongInt);
+    EXPECT_EQ(kw.lexeme(), "uLongInt");
 }
 
 // ------------------------------------
@@ -241,3 +362,135 @@ TEST(LexerTests, EmptyInputProducesEndOfFile) {
     Context context;
     EXPECT_EQ(tok(makeLexer(context, "").next()).kind(), TokenKind::EndOfFile);
 }
+
+// ------------------------------------
+// Trivia scanning
+// ------------------------------------
+
+TEST(LexerTests, TriviaScannersMatchScalar) {
+    // every start offset exercises the aligned first block and later full blocks
+    std::string source;
+    for (int idx = 0; idx < 4; ++idx) {
+        source += "  \t   x '/ comment /' nested '/ \"str\\\"ing\"\r\n";
+        source += std::string(40, ' ') + "\t\x01\x7F\xC3\xA9" + std::string(33, 'a') + "\n";
+    }
+    const char* const data = source.c_str();
+    for (std::size_t offset = 0; offset <= source.size(); ++offset) {
+        const char* ptr = data + offset; // NOLINT(*-pro-bounds-pointer-arithmetic)
+        EXPECT_EQ(scan::whiteSpaceEnd(ptr), scan::scalar::whiteSpaceEnd(ptr)) << "offset " << offset;
+        EXPECT_EQ(scan::lineEnd(ptr), scan::scalar::lineEnd(ptr)) << "offset " << offset;
+        EXPECT_EQ(scan::commentMarker(ptr), scan::scalar::commentMarker(ptr)) << "offset " << offset;
+        EXPECT_EQ(scan::stringMarker(ptr), scan::scalar::stringMarker(ptr)) << "offset " << offset;
+    }
+}
+
+TEST(LexerTests, LongTriviaRuns) {
+    Context context;
+    // whitespace and comments spanning several vector blocks
+    const auto blanks = std::string(100, ' ') + "\t\t" + std::string(70, ' ');
+    auto lexer = makeLexer(context, blanks + "42" + blanks + "' " + std::string(90, 'c') + "\n43");
+    EXPECT_EQ(tok(lexer.next()).kind(), TokenKind::IntegerLiteral);
+    EXPECT_EQ(tok(lexer.next()).kind(), TokenKind::EndOfStmt);
+    EXPECT_EQ(tok(lexer.next()).kind(), TokenKind::IntegerLiteral);
+    // nested multiline comment with markers far apart and stray quotes and slashes
+    const auto filler = std::string(64, '-');
+    const auto nested = "/' " + filler + " / ' /' " + filler + " '/ " + filler + " '/ 7";
+    EXPECT_EQ(tok(makeLexer(context, nested).next()).getValue().get<std::uint64_t>(), 7U);
+    // long string literal with an escape past the first block
+    const auto body = std::string(80, 's');
+    const auto str = tok(makeLexer(context, "\"" + body + "\\n" + body + "\"").next());
+    EXPECT_EQ(str.getValue().get<llvm::StringRef>(), body + "\n" + body);
+    // line continuation followed by a long tail
+    auto cont = makeLexer(context, "1 _ " + std::string(50, 'x') + "\r\n+ 2");
+    EXPECT_EQ(tok(cont.next()).kind(), TokenKind::IntegerLiteral);
+    EXPECT_EQ(tok(cont.next()).kind(), TokenKind::Plus);
+}
+
+// ------------------------------------
+// Token buffer
+// ------------------------------------
+
+namespace {
+auto makeBuffer(Context& context, const llvm::StringRef source) -> std::unique_ptr<TokenBuffer> {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    return std::make_unique<TokenBuffer>(context, id);
+}
+} // namespace
+
+TEST(LexerTests, TokenBufferLookahead) {
+    Context context;
+    auto tokens = makeBuffer(context, "dim x = \"str\" + 42");
+    // arbitrary lookahead lexes on demand
+    EXPECT_EQ(tokens->kind(5), TokenKind::IntegerLiteral);
+    EXPECT_EQ(tokens->size(), 6U);
+    EXPECT_FALSE(tokens->isComplete());
+    EXPECT_EQ(tokens->kind(0), TokenKind::Dim);
+    EXPECT_EQ(tokens->kind(4), TokenKind::Plus);
+    // literal values and ranges round trip through the side table
+    const auto str = tokens->token(3);
+    EXPECT_EQ(str.kind(), TokenKind::StringLiteral);
+    EXPECT_EQ(str.getValue().get<llvm::StringRef>(), "str");
+    EXPECT_EQ(str.lexeme(), "\"str\"");
+    EXPECT_EQ(tokens->token(1).string(), "X");
+    EXPECT_EQ(tokens->token(5).getValue().get<std::uint64_t>(), 42U);
+    // past the end keeps returning the final token
+    tokens->fill();
+    EXPECT_TRUE(tokens->isComplete());
+    EXPECT_EQ(tokens->kind(tokens->size() - 1), TokenKind::EndOfFile);
+    EXPECT_EQ(tokens->kind(100), TokenKind::EndOfFile);
+}
+
+TEST(LexerTests, TokenBufferStopsAtError) {
+    Context context;
+    context.getDiag().setAutoPrint(false);
+    auto tokens = makeBuffer(context, "1 .. 2");
+    tokens->fill();
+    EXPECT_EQ(tokens->size(), 2U);
+    EXPECT_EQ(tokens->kind(1), TokenKind::Invalid);
+    EXPECT_EQ(tokens->kind(10), TokenKind::Invalid);
+    EXPECT_TRUE(tokens->getError().isValid());
+    EXPECT_TRUE(context.getDiag().hasErrors());
+}
+
+TEST(LexerTests, TokenBufferParallelFillMatchesSequential) {
+    // big enough to be split into several chunks, with a nested comment and
+    // a line continuation crossing chunk boundaries
+    std::string source;
+    std::size_t line = 0;
+    const auto append = [&](const std::size_t until) {
+        while (source.size() < until) {
+            source += "dim v" + std::to_string(line++) + " as Integer = 42 + .5 ' note\n";
+            source += "print \"esc\\tstr\", V" + std::to_string(line) + "\r\n";
+        }
+    };
+    append(TokenBuffer::kChunkSize - 100);
+    source += "/' nested /' '/ ";
+    source += std::string(TokenBuffer::kChunkSize, 'c');
+    source += "\n'/ x = 1 _\n";
+    append((2 * TokenBuffer::kChunkSize) + 10);
+    source += "y = 2 _\n";
+    source += std::string(TokenBuffer::kChunkSize, ' ');
+    source += "+ 3\n";
+    append(TokenBuffer::kParallelThreshold + TokenBuffer::kChunkSize);
+    ASSERT_GE(source.size(), TokenBuffer::kParallelThreshold);
+
+    Context context;
+    auto parallel = makeBuffer(context, source);
+    auto sequential = makeBuffer(context, source);
+    parallel->fill();
+    ASSERT_TRUE(parallel->isComplete());
+    ASSERT_FALSE(parallel->getError().isValid());
+
+    for (std::size_t idx = 0; idx < parallel->size(); ++idx) {
+        const auto lhs = parallel->token(idx);
+        const auto rhs = sequential->token(idx);
+        ASSERT_EQ(lhs.kind(), rhs.kind()) << "token " << idx;
+        ASSERT_EQ(lhs.lexeme(), rhs.lexeme()) << "token " << idx;
+        if (lhs.kind().isOneOf(TokenKind::Identifier, TokenKind::StringLiteral)) {
+            ASSERT_EQ(lhs.getValue().get<llvm::StringRef>(), rhs.getValue().get<llvm::StringRef>()) << "token " << idx;
+        }
+    }
+    EXPECT_TRUE(sequential->isComplete());
+    EXPECT_EQ(sequential->size(), parallel->size());
+}
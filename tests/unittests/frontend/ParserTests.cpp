@@ -4,9 +4,12 @@
 #include "pch.hpp"
 #include <gtest/gtest.h>
 #include "Ast/Ast.hpp"
+#include "Ast/AstArena.hpp"
 #include "Ast/AstCodePrinter.hpp"
+#include "Ast/AstWalker.hpp"
 #include "Driver/Context.hpp"
 #include "Parser/Parser.hpp"
+#include "Sema/SemanticAnalyser.hpp"
 using namespace lbc;
 
 namespace {
@@ -144,3 +147,337 @@ TEST(ParserTests, FunctionCallMultipleArgs) {
 TEST(ParserTests, FunctionCallExprArg) {
     EXPECT_EQ(parseExpr("foo(a + b)"), "FOO((A + B))");
 }
+
+// ------------------------------------
+// Token buffering
+// ------------------------------------
+
+namespace {
+
+/**
+ * Parse a whole program with the given tokenise mode and return the printed module,
+ * or an empty string if parsing failed.
+ */
+auto parseProgram(Context& context, const llvm::StringRef source, const Parser::Tokenise tokenise) -> std::string {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id, tokenise };
+    auto result = parser.parse();
+    if (!result.has_value()) {
+        return "";
+    }
+    std::string output = "";
+    llvm::raw_string_ostream ss { output };
+    AstCodePrinter printer { ss };
+    printer.print(*result.value());
+    return output;
+}
+
+} // namespace
+
+TEST(ParserTests, UpfrontTokenisingMatchesOnDemand) {
+    constexpr auto source = R"(
+        DECLARE FUNCTION add(a AS INTEGER, b AS INTEGER) AS INTEGER
+        DIM x = add(1, 2) * 3, s = "text"
+        FUNCTION add(a AS INTEGER, b AS INTEGER) AS INTEGER
+            RETURN a + b
+        END FUNCTION
+    )";
+    Context lazy;
+    Context upfront;
+    const auto expected = parseProgram(lazy, source, Parser::Tokenise::OnDemand);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(parseProgram(upfront, source, Parser::Tokenise::Upfront), expected);
+}
+
+TEST(ParserTests, UpfrontTokenisingReportsLexerError) {
+    Context context;
+    context.getDiag().setAutoPrint(false);
+    EXPECT_EQ(parseProgram(context, "DIM x = 1 ..", Parser::Tokenise::Upfront), "");
+    EXPECT_EQ(context.getDiag().count(llvm::SourceMgr::DK_Error), 1U);
+}
+
+namespace {
+
+/**
+ * Program with enough SUB and FUNCTION definitions to parse their bodies in parallel,
+ * with nested blocks and statements around them. @param broken gets a syntax error
+ * in its body when in range.
+ */
+auto manyBodies(const std::size_t broken = std::numeric_limits<std::size_t>::max()) -> std::string {
+    std::string source = "DECLARE SUB none\n";
+    for (std::size_t index = 0; index < Parser::kParallelBodies * 2; index++) {
+        const auto name = std::to_string(index);
+        source += "DIM g" + name + " = " + name + "\n";
+        source += "FUNCTION f" + name + "(a AS INTEGER) AS INTEGER\n";
+        source += "    DIM x = a * " + name + " + g" + name + "\n";
+        source += index == broken ? "    x = = 1\n" : "    x = x + 1\n";
+        source += "    RETURN x\n";
+        source += "END FUNCTION\n";
+        source += "SUB s" + name + "\n";
+        source += "    EXTERN \"C\" DECLARE SUB puts(s AS ZSTRING)\n";
+        source += "    puts \"text\"\n";
+        source += "END SUB\n";
+    }
+    return source;
+}
+
+} // namespace
+
+TEST(ParserTests, ParallelBodiesMatchSerial) {
+    const auto source = manyBodies();
+    Context lazy;
+    Context upfront;
+    const auto expected = parseProgram(lazy, source, Parser::Tokenise::OnDemand);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(parseProgram(upfront, source, Parser::Tokenise::Upfront), expected);
+}
+
+TEST(ParserTests, ParallelBodiesReportErrorsSerially) {
+    const auto source = manyBodies(Parser::kParallelBodies);
+    Context lazy;
+    Context upfront;
+    lazy.getDiag().setAutoPrint(false);
+    upfront.getDiag().setAutoPrint(false);
+    EXPECT_EQ(parseProgram(lazy, source, Parser::Tokenise::OnDemand), "");
+    EXPECT_EQ(parseProgram(upfront, source, Parser::Tokenise::Upfront), "");
+    EXPECT_EQ(upfront.getDiag().count(llvm::SourceMgr::DK_Error), 1U);
+    EXPECT_EQ(upfront.getDiag().count(llvm::SourceMgr::DK_Error), lazy.getDiag().count(llvm::SourceMgr::DK_Error));
+}
+
+TEST(ParserTests, ParallelBodyErrorsMatchSerial) {
+    const auto source = manyBodies(Parser::kParallelBodies + 1);
+    const auto parseError = [&](Context& context, const Parser::Tokenise tokenise) -> std::pair<std::string, int> {
+        context.getDiag().setAutoPrint(false);
+        auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+        const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+        Parser parser { context, id, tokenise };
+        const auto result = parser.parse();
+        EXPECT_FALSE(result.has_value());
+        if (result.has_value() || not result.error().isValid()) {
+            return {};
+        }
+        const auto& diagnostic = context.getDiag().getDiagnostic(result.error());
+        return { diagnostic.getMessage().str(), diagnostic.getLineNo() };
+    };
+
+    // the error recorded by the worker is logged once the body is reached
+    Context lazy;
+    Context upfront;
+    const auto expected = parseError(lazy, Parser::Tokenise::OnDemand);
+    EXPECT_FALSE(expected.first.empty());
+    EXPECT_EQ(parseError(upfront, Parser::Tokenise::Upfront), expected);
+    EXPECT_EQ(upfront.getDiag().count(llvm::SourceMgr::DK_Error), 1U);
+}
+
+TEST(ParserTests, NodesAreAllocatedInTheirGroupPools) {
+    Context context;
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(manyBodies(), "test");
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id };
+    const auto result = parser.parse();
+    ASSERT_TRUE(result.has_value());
+
+    auto& arena = context.getAstArena();
+    std::size_t nodes = 0;
+    AstWalker walker;
+    const auto walked = walker.postOrder(**result, [&](const AstRoot& node) -> DiagResult<void> {
+        EXPECT_TRUE(arena.owns(node)) << node.getClassName().str();
+        nodes++;
+        return {};
+    });
+    EXPECT_TRUE(walked.has_value());
+    EXPECT_GT(nodes, Parser::kParallelBodies * 20);
+    EXPECT_GT(arena.getPool(AstPool::Expr).getBytesAllocated(), 0U);
+    EXPECT_GT(arena.getPool(AstPool::Stmt).getBytesAllocated(), 0U);
+}
+
+// ------------------------------------
+// Incremental reparse
+// ------------------------------------
+
+namespace {
+
+/** Add @param source to @param context as a new buffer and return its id. */
+auto addBuffer(Context& context, const llvm::StringRef source) -> unsigned {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    return context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+}
+
+/** Print @param module as source code. */
+auto print(const AstModule& module) -> std::string {
+    std::string output;
+    llvm::raw_string_ostream ss { output };
+    AstCodePrinter { ss }.print(module);
+    return output;
+}
+
+/** Source text @param range resolves to in @param context. */
+auto text(const Context& context, const SourceRange range) -> std::string {
+    const auto resolved = context.resolve(range);
+    return std::string { resolved.Start.getPointer(), resolved.End.getPointer() };
+}
+
+} // namespace
+
+TEST(ParserTests, ReparseReusesUntouchedStatements) {
+    constexpr llvm::StringRef before = "DIM a = 1\nSUB first\n    DIM x = a\nEND SUB\nSUB second\n    DIM y = 2\nEND SUB\n";
+    constexpr llvm::StringRef after = "DIM b = 0\nDIM a = 1\nSUB first\n    DIM x = a\nEND SUB\nSUB second\n    DIM y = 2 + 3\nEND SUB\n";
+    const std::array edits {
+        Parser::Edit { .offset = 0, .removed = 0, .inserted = 10 },
+        Parser::Edit { .offset = static_cast<std::uint32_t>(before.find("2\n")), .removed = 1, .inserted = 5 },
+    };
+
+    Context context;
+    const auto previousId = addBuffer(context, before);
+    Parser previousParser { context, previousId };
+    const auto previous = previousParser.parse();
+    ASSERT_TRUE(previous.has_value());
+    const auto oldStmts = (*previous)->getStmtList()->getStmts();
+
+    Parser parser { context, addBuffer(context, after) };
+    const auto module = parser.reparse(**previous, previousId, edits);
+    ASSERT_TRUE(module.has_value());
+    const auto stmts = (*module)->getStmtList()->getStmts();
+    ASSERT_EQ(stmts.size(), 4U);
+
+    // touched statements are parsed again, the rest is moved over
+    EXPECT_NE(stmts[1], oldStmts[0]);
+    EXPECT_EQ(stmts[2], oldStmts[1]);
+    EXPECT_NE(stmts[3], oldStmts[2]);
+    EXPECT_EQ(text(context, stmts[2]->getRange()), "SUB first\n    DIM x = a\nEND SUB");
+    const auto* first = llvm::cast<AstFuncStmt>(stmts[2]);
+    EXPECT_EQ(text(context, first->getStmtList()->getStmts()[0]->getRange()), "DIM x = a");
+
+    Context fresh;
+    Parser freshParser { fresh, addBuffer(fresh, after) };
+    const auto expected = freshParser.parse();
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_EQ(print(**module), print(**expected));
+}
+
+TEST(ParserTests, ReparseDropsStatementsCommentedOut) {
+    constexpr llvm::StringRef before = "DIM a = 1\n\nDIM b = 2\n";
+    constexpr llvm::StringRef after = "DIM a = 1\n/'\nDIM b = 2\n'/\n";
+    const std::array edits {
+        Parser::Edit { .offset = 10, .removed = 0, .inserted = 2 },
+        Parser::Edit { .offset = static_cast<std::uint32_t>(before.size()), .removed = 0, .inserted = 3 },
+    };
+
+    Context context;
+    const auto previousId = addBuffer(context, before);
+    Parser previousParser { context, previousId };
+    const auto previous = previousParser.parse();
+    ASSERT_TRUE(previous.has_value());
+
+    Parser parser { context, addBuffer(context, after) };
+    const auto module = parser.reparse(**previous, previousId, edits);
+    ASSERT_TRUE(module.has_value());
+    EXPECT_EQ((*module)->getStmtList()->getStmts().size(), 1U);
+}
+
+TEST(ParserTests, ReparseOfAnalysedModuleMatchesFreshAnalysis) {
+    // sema folds the constant into x, casts x for y, strips the cast in s and
+    // converts the folded value to DOUBLE, all of it stale once a changes
+    constexpr llvm::StringRef before = "CONST a = 2\nDIM x = a + 1\nDIM y AS LONG = x\nSUB s\n    DIM z AS DOUBLE = (a + 1) AS INTEGER\nEND SUB\n";
+    constexpr llvm::StringRef after = "CONST a = 5\nDIM x = a + 1\nDIM y AS LONG = x\nSUB s\n    DIM z AS DOUBLE = (a + 1) AS INTEGER\nEND SUB\n";
+    const std::array edits {
+        Parser::Edit { .offset = static_cast<std::uint32_t>(before.find('2')), .removed = 1, .inserted = 1 },
+    };
+
+    Context context;
+    const auto previousId = addBuffer(context, before);
+    Parser previousParser { context, previousId };
+    const auto previous = previousParser.parse();
+    ASSERT_TRUE(previous.has_value());
+    ASSERT_TRUE(SemanticAnalyser { context }.analyse(**previous).has_value());
+    const auto oldStmts = (*previous)->getStmtList()->getStmts();
+
+    Parser parser { context, addBuffer(context, after) };
+    const auto module = parser.reparse(**previous, previousId, edits);
+    ASSERT_TRUE(module.has_value());
+    const auto stmts = (*module)->getStmtList()->getStmts();
+    ASSERT_EQ(stmts.size(), 4U);
+    EXPECT_NE(stmts[0], oldStmts[0]);
+    EXPECT_EQ(stmts[1], oldStmts[1]);
+    EXPECT_EQ(stmts[3], oldStmts[3]);
+    ASSERT_TRUE(SemanticAnalyser { context }.analyse(**module).has_value());
+
+    Context fresh;
+    Parser freshParser { fresh, addBuffer(fresh, after) };
+    const auto expected = freshParser.parse();
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(SemanticAnalyser { fresh }.analyse(**expected).has_value());
+    EXPECT_EQ(print(**module), print(**expected));
+
+    const auto* init = llvm::cast<AstDimStmt>(stmts[1])->getDecls()[0]->getExpr();
+    const auto* literal = llvm::dyn_cast<AstLiteralExpr>(init);
+    ASSERT_NE(literal, nullptr);
+    EXPECT_EQ(literal->getValue().get<std::int64_t>(), 6);
+}
+
+// ------------------------------------
+// Source ranges
+// ------------------------------------
+
+namespace {
+
+/**
+ * Parse "DIM x = <expr>" as a new buffer of context and return the source text
+ * the initializer's range resolves to.
+ */
+auto initializerText(Context& context, const llvm::StringRef expr) -> std::string {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(("DIM x = " + expr).str(), "test");
+    auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id };
+    auto result = parser.parse();
+    if (!result.has_value()) {
+        return "";
+    }
+    auto* dim = llvm::cast<AstDimStmt>((*result)->getStmtList()->getStmts()[0]);
+    const auto range = context.resolve(dim->getDecls()[0]->getExpr()->getRange());
+    return std::string { range.Start.getPointer(), range.End.getPointer() };
+}
+
+} // namespace
+
+TEST(ParserTests, RangesResolveAcrossBuffers) {
+    Context context;
+    EXPECT_EQ(initializerText(context, "1"), "1");
+    EXPECT_EQ(initializerText(context, "a + b * 2"), "a + b * 2");
+    EXPECT_EQ(initializerText(context, "foo(1, 2)"), "foo(1, 2)");
+    EXPECT_EQ(context.getLocationBase(1), 1U);
+    EXPECT_EQ(context.getLocationBase(2), 1U + 9U + 1U);
+}
+
+TEST(ParserTests, InvalidRangeResolvesToEmpty) {
+    Context context;
+    EXPECT_FALSE(context.resolve(SourceRange {}).isValid());
+}
+
+// ------------------------------------
+// CONST declarations
+// ------------------------------------
+
+TEST(ParserTests, ConstStmtDeclaresEachConstant) {
+    Context context;
+    const auto id = addBuffer(context, "CONST a = 1, b AS BYTE = a + 2\n");
+    Parser parser { context, id };
+    const auto result = parser.parse();
+    ASSERT_TRUE(result.has_value());
+
+    const auto* list = (*result)->getStmtList();
+    const auto* stmt = llvm::dyn_cast<AstConstStmt>(list->getStmts()[0]);
+    ASSERT_NE(stmt, nullptr);
+    ASSERT_EQ(stmt->getDecls().size(), 2U);
+    EXPECT_EQ(stmt->getDecls()[0]->getTypeExpr(), nullptr);
+    EXPECT_NE(stmt->getDecls()[1]->getTypeExpr(), nullptr);
+    EXPECT_EQ(list->getDecls().size(), 2U);
+}
+
+TEST(ParserTests, ConstRequiresInitialiser) {
+    Context context;
+    context.getDiag().setAutoPrint(false);
+    Parser parser { context, addBuffer(context, "CONST a AS INTEGER\n") };
+    EXPECT_FALSE(parser.parse().has_value());
+}
@@ -2,6 +2,7 @@
 // Created by Albert Varaksin on 23/02/2026.
 //
 #include "pch.hpp"
+#include <algorithm>
 #include <gtest/gtest.h>
 #include "Ast/Ast.hpp"
 #include "Driver/Context.hpp"
@@ -134,6 +135,20 @@ TEST(SemaExprTests, StringLiteralDeducesZString) {
     EXPECT_TRUE(type->isZString());
 }
 
+TEST(SemaExprTests, SuffixedLiteralsDeduceSuffixType) {
+    EXPECT_TRUE(deduceExpr("42UL")->isULong());
+    EXPECT_TRUE(deduceExpr("&HFFU")->isUInteger());
+    EXPECT_TRUE(deduceExpr("7LL")->isLongInt());
+    EXPECT_TRUE(deduceExpr("1.5F")->isSingle());
+    EXPECT_TRUE(deduceExpr("2#")->isDouble());
+}
+
+TEST(SemaExprTests, SuffixedLiteralFixesBinaryType) {
+    // the unsuffixed literal adapts to the suffixed one
+    EXPECT_TRUE(deduceExpr("1 + 2UL")->isULong());
+    EXPECT_TRUE(deduceExpr("2.5 * 1.5F")->isSingle());
+}
+
 // =============================================================================
 // Explicit type on DIM coerces literal
 // =============================================================================
@@ -549,6 +564,315 @@ TEST(SemaExprTests, ComparisonIsValue) {
     EXPECT_TRUE(expr->getValueCategory().isValue());
 }
 
+// =============================================================================
+// Deferred literal coercion — literal subtrees take the type of their context
+// =============================================================================
+
+TEST(SemaExprTests, LiteralArithmeticCoercesToExplicitType) {
+    Context context;
+    auto* expr = dimInitExpr(context, "DIM x AS BYTE = 1 + 2 * 3", 0);
+    ASSERT_NE(expr, nullptr);
+    auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr);
+    ASSERT_NE(literal, nullptr); // re-typed, then folded, no cast
+    EXPECT_TRUE(literal->getType()->isByte());
+    EXPECT_EQ(literal->getValue().get<std::int64_t>(), 7);
+}
+
+TEST(SemaExprTests, NegatedLiteralCoercesToExplicitType) {
+    EXPECT_TRUE(deduceTypedExpr("Byte", "-1")->isByte());
+    EXPECT_TRUE(semaFails("DIM x AS UBYTE = -1"));
+}
+
+TEST(SemaExprTests, LiteralSubtreeAdoptsSiblingType) {
+    Context context;
+    auto* expr = dimInitExpr(context, "DIM b AS BYTE = 1\nDIM x = b + (2 + 3)", 1);
+    ASSERT_NE(expr, nullptr);
+    auto* binary = llvm::dyn_cast<AstBinaryExpr>(expr);
+    ASSERT_NE(binary, nullptr);
+    EXPECT_TRUE(binary->getType()->isByte());
+    EXPECT_TRUE(llvm::isa<AstLiteralExpr>(binary->getRight()));
+    EXPECT_TRUE(binary->getRight()->getType()->isByte());
+}
+
+TEST(SemaExprTests, TypedSubtreeIsCastNotCoerced) {
+    // a + 1 is typed by a, so narrowing it to BYTE is still rejected
+    EXPECT_TRUE(semaFails("DIM a = 1\nDIM x AS BYTE = a + 1"));
+}
+
+TEST(SemaExprTests, LiteralSubtreeFoldsInItsContextType) {
+    // 200 + 100 wraps in UBYTE, as it would at run time
+    Context context;
+    auto* expr = dimInitExpr(context, "DIM x AS UBYTE = (200 + 100) / 6", 0);
+    ASSERT_NE(expr, nullptr);
+    auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr);
+    ASSERT_NE(literal, nullptr);
+    EXPECT_EQ(literal->getValue().get<std::uint64_t>(), 7U);
+}
+
+TEST(SemaExprTests, TrappingOperationsAreNotFolded) {
+    Context context;
+    EXPECT_TRUE(llvm::isa<AstBinaryExpr>(dimInitExpr(context, "DIM x = 1 / 0", 0)));
+    Context other;
+    EXPECT_TRUE(llvm::isa<AstBinaryExpr>(dimInitExpr(other, "DIM y AS BYTE = -128 / -1", 0)));
+}
+
+// =============================================================================
+// Deep expressions — a chain on left operands is analysed without recursion
+// =============================================================================
+
+TEST(SemaExprTests, LongChainIsAnalysedIteratively) {
+    // Deeper than the native stack allows at a frame per term. Literal terms
+    // coerce to the variable's type, BYTE terms are cast to INTEGER.
+    constexpr std::size_t kTerms = 100'000;
+    std::string source = "SUB s\n    DIM a AS INTEGER\n    DIM b AS BYTE\n    DIM x = a";
+    for (std::size_t term = 0; term < kTerms; term++) {
+        source += term % 2 == 0 ? " + 1" : " - b";
+    }
+    source += "\nEND SUB\n";
+
+    Context context;
+    auto* module = analyse(context, source);
+    ASSERT_NE(module, nullptr);
+    const auto* func = llvm::cast<AstFuncStmt>(module->getStmtList()->getStmts()[0]);
+    const auto* dim = llvm::cast<AstDimStmt>(func->getStmtList()->getStmts()[2]);
+    const auto* expr = llvm::cast<AstBinaryExpr>(dim->getDecls()[0]->getExpr());
+    EXPECT_TRUE(expr->getType()->isInteger());
+    EXPECT_TRUE(llvm::isa<AstCastExpr>(expr->getRight()));
+    EXPECT_TRUE(llvm::cast<AstBinaryExpr>(expr->getLeft())->getRight()->getType()->isInteger());
+}
+
+// =============================================================================
+// CONST declarations
+// =============================================================================
+
+namespace {
+
+/** Analyse @p source and return the symbol of the module level declaration @p name. */
+auto moduleSymbol(Context& context, const llvm::StringRef source, const llvm::StringRef name) -> const Symbol* {
+    auto* module = analyse(context, source);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    return module->getStmtList()->getSymbolTable()->find(name, false);
+}
+
+} // namespace
+
+TEST(SemaExprTests, ConstantUsesFoldToItsValue) {
+    Context context;
+    auto* expr = dimInitExpr(context, "CONST n = 2 + 3\nDIM x = n * 2", 1);
+    ASSERT_NE(expr, nullptr);
+    auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr);
+    ASSERT_NE(literal, nullptr);
+    EXPECT_TRUE(literal->getType()->isInteger());
+    EXPECT_EQ(literal->getValue().get<std::int64_t>(), 10);
+}
+
+TEST(SemaExprTests, UntypedConstantCoercesLikeLiteral) {
+    EXPECT_FALSE(semaFails("CONST n = 5\nDIM x AS BYTE = n"));
+    EXPECT_TRUE(semaFails("CONST n AS INTEGER = 5\nDIM x AS BYTE = n"));
+
+    Context context;
+    const auto* symbol = moduleSymbol(context, "CONST n = -5", "N");
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_TRUE(symbol->hasFlag(SymbolFlags::Constant));
+    EXPECT_TRUE(symbol->hasFlag(SymbolFlags::Untyped));
+    EXPECT_TRUE(symbol->getType()->isInteger());
+}
+
+TEST(SemaExprTests, TypedConstantValueFitsItsType) {
+    Context context;
+    const auto* symbol = moduleSymbol(context, "CONST b AS BYTE = 200", "B");
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_TRUE(symbol->getType()->isByte());
+    EXPECT_FALSE(symbol->hasFlag(SymbolFlags::Untyped));
+    ASSERT_TRUE(symbol->hasValue());
+    EXPECT_EQ(symbol->getValue()->get<std::int64_t>(), -56);
+}
+
+TEST(SemaExprTests, ConstantFromConstantsFolds) {
+    Context context;
+    const auto* symbol = moduleSymbol(context, "CONST a AS UBYTE = 1\nCONST b AS DOUBLE = 2.5\nCONST c = a + b", "C");
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_TRUE(symbol->getType()->isDouble());
+    ASSERT_TRUE(symbol->hasValue());
+    EXPECT_EQ(symbol->getValue()->get<double>(), 3.5);
+}
+
+TEST(SemaExprTests, ConstantMustBeKnownAtCompileTime) {
+    EXPECT_TRUE(semaFails("DIM a = 1\nCONST n = a"));
+    EXPECT_TRUE(semaFails("CONST n = 1 / 0"));
+    EXPECT_TRUE(semaFails("CONST n AS INTEGER REF = 1"));
+}
+
+TEST(SemaExprTests, ConstantIsNotAssignable) {
+    EXPECT_TRUE(semaFails("CONST n = 1\nn = 2"));
+    EXPECT_TRUE(semaFails("CONST n = 1\nDIM p = @n"));
+}
+
+// =============================================================================
+// Compile-time evaluation of initialisers
+// =============================================================================
+
+TEST(SemaExprTests, ConstantCallsAreEvaluated) {
+    Context context;
+    const auto* symbol = moduleSymbol(
+        context,
+        "SUB noop()\n"
+        "    DIM unused AS INTEGER\n"
+        "    unused = 1\n"
+        "END SUB\n"
+        "FUNCTION add(a AS INTEGER, b AS INTEGER) AS INTEGER\n"
+        "    RETURN a + b\n"
+        "END FUNCTION\n"
+        "FUNCTION hash(seed AS INTEGER) AS INTEGER\n"
+        "    DIM h AS INTEGER = seed * 31\n"
+        "    noop()\n"
+        "    h = add(h, 7)\n"
+        "    RETURN h\n"
+        "END FUNCTION\n"
+        "CONST n = hash(3)",
+        "N"
+    );
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_TRUE(symbol->getType()->isInteger());
+    EXPECT_FALSE(symbol->hasFlag(SymbolFlags::Untyped));
+    ASSERT_TRUE(symbol->hasValue());
+    EXPECT_EQ(symbol->getValue()->get<std::int64_t>(), 100);
+}
+
+TEST(SemaExprTests, GlobalInitialiserCallIsEvaluated) {
+    Context context;
+    auto* expr = dimInitExpr(
+        context,
+        "FUNCTION square(n AS INTEGER) AS INTEGER\n"
+        "    RETURN n * n\n"
+        "END FUNCTION\n"
+        "DIM x AS LONG = square(-12)",
+        1
+    );
+    ASSERT_NE(expr, nullptr);
+    auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr);
+    ASSERT_NE(literal, nullptr);
+    EXPECT_TRUE(literal->getType()->isLong());
+    EXPECT_EQ(literal->getValue().get<std::int64_t>(), 144);
+}
+
+TEST(SemaExprTests, ImpureCallsAreNotEvaluated) {
+    // reads a global variable
+    EXPECT_TRUE(semaFails("DIM g AS INTEGER = 1\nFUNCTION get() AS INTEGER\n    RETURN g\nEND FUNCTION\nCONST n = get()"));
+    // body not analysed yet
+    EXPECT_TRUE(semaFails("CONST n = later()\nFUNCTION later() AS INTEGER\n    RETURN 1\nEND FUNCTION"));
+    // declared only
+    EXPECT_TRUE(semaFails("DECLARE FUNCTION external() AS INTEGER\nCONST n = external()"));
+
+    Context context;
+    auto* expr = dimInitExpr(context, "DIM g AS INTEGER = 1\nFUNCTION get() AS INTEGER\n    RETURN g\nEND FUNCTION\nDIM x = get()", 2);
+    EXPECT_TRUE(llvm::isa<AstCallExpr>(expr));
+}
+
+namespace {
+
+/** The value of the constant @p name declared in the body of the module's statement @p index. */
+auto bodyConstant(const AstModule& module, const std::size_t index, const llvm::StringRef name) -> std::optional<std::int64_t> {
+    const auto* func = llvm::cast<AstFuncStmt>(module.getStmtList()->getStmts()[index]);
+    const auto* symbol = func->getStmtList()->getSymbolTable()->find(name, false);
+    if (symbol == nullptr || not symbol->hasValue()) {
+        return std::nullopt;
+    }
+    return symbol->getValue()->get<std::int64_t>();
+}
+
+} // namespace
+
+TEST(SemaExprTests, ConstantsCallBodiesOfTheirRun) {
+    Context context;
+    auto* module = analyse(
+        context,
+        "FUNCTION twice(n AS INTEGER) AS INTEGER\n"
+        "    RETURN n * 2\n"
+        "END FUNCTION\n"
+        "FUNCTION get() AS INTEGER\n"
+        "    CONST k = twice(3) + thrice(1)\n"
+        "    RETURN k\n"
+        "END FUNCTION\n"
+        "FUNCTION thrice(n AS INTEGER) AS INTEGER\n"
+        "    RETURN n * 3\n"
+        "END FUNCTION"
+    );
+    ASSERT_NE(module, nullptr);
+    EXPECT_EQ(bodyConstant(*module, 1, "K"), 9);
+}
+
+TEST(SemaExprTests, ConstantsCallBodiesOfAParallelRun) {
+    // enough bodies around the one declaring a constant to analyse them in parallel
+    constexpr std::size_t kBodies = SemanticAnalyser::kParallelBodies * 2;
+    std::string source;
+    for (std::size_t index = 0; index < kBodies; index++) {
+        const auto name = "f" + std::to_string(index);
+        source += "FUNCTION " + name + "(n AS INTEGER) AS INTEGER\n    RETURN n + " + std::to_string(index) + "\nEND FUNCTION\n";
+        if (index == kBodies / 2) {
+            source += "FUNCTION get() AS INTEGER\n    CONST k = f0(1) + f" + std::to_string(kBodies - 1) + "(1)\n    RETURN k\nEND FUNCTION\n";
+        }
+    }
+
+    Context context;
+    auto* module = analyse(context, source);
+    ASSERT_NE(module, nullptr);
+    EXPECT_EQ(bodyConstant(*module, kBodies / 2 + 1, "K"), static_cast<std::int64_t>(kBodies + 1));
+}
+
+TEST(SemaExprTests, ConstantsCallDeferredBodies) {
+    Context context;
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(
+        "FUNCTION square(n AS INTEGER) AS INTEGER\n"
+        "    RETURN n * n\n"
+        "END FUNCTION\n"
+        "CONST n = square(5)\n"
+        "DIM x AS INTEGER = n",
+        "test"
+    );
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id, Parser::Tokenise::Upfront, Parser::Bodies::Lazy };
+    const auto parsed = parser.parse();
+    ASSERT_TRUE(parsed.has_value());
+
+    SemanticAnalyser sema { context };
+    const auto loader = [&](AstFuncStmt& ast) { return parser.parseBody(ast); };
+    ASSERT_TRUE(sema.analyse(**parsed, loader).has_value());
+
+    const auto* symbol = (*parsed)->getStmtList()->getSymbolTable()->find("N", false);
+    ASSERT_NE(symbol, nullptr);
+    ASSERT_TRUE(symbol->hasValue());
+    EXPECT_EQ(symbol->getValue()->get<std::int64_t>(), 25);
+}
+
+TEST(SemaExprTests, LongChainIsEvaluatedIteratively) {
+    // one step per operand and per operator, within kEvaluationSteps
+    constexpr std::size_t kTerms = 40'000;
+    std::string source = "FUNCTION count(a AS INTEGER) AS INTEGER\n    RETURN a";
+    for (std::size_t term = 1; term < kTerms; term++) {
+        source += " + a";
+    }
+    source += "\nEND FUNCTION\nDIM x = count(1)";
+
+    Context context;
+    auto* expr = dimInitExpr(context, source, 1);
+    ASSERT_NE(expr, nullptr);
+    auto* literal = llvm::dyn_cast<AstLiteralExpr>(expr);
+    ASSERT_NE(literal, nullptr);
+    EXPECT_EQ(literal->getValue().get<std::int64_t>(), 40'000);
+}
+
+TEST(SemaExprTests, EvaluationStopsAtItsLimits) {
+    constexpr auto forever = "FUNCTION forever(n AS INTEGER) AS INTEGER\n    RETURN forever(n + 1)\nEND FUNCTION\n";
+    EXPECT_TRUE(semaFails(std::string(forever) + "CONST n = forever(0)"));
+
+    Context context;
+    auto* expr = dimInitExpr(context, std::string(forever) + "DIM x = forever(0)", 1);
+    EXPECT_TRUE(llvm::isa<AstCallExpr>(expr));
+}
+
 // =============================================================================
 // EXTERN "C" linkage block (AstExtern) — verbatim symbol alias
 // =============================================================================
@@ -598,7 +922,7 @@ TEST(SemaExprTests, ExternCSetsVerbatimAlias) {
     EXPECT_TRUE(symbol->getExternKind() == ExternKind::C); // linkage is a symbol attribute
     EXPECT_EQ(symbol->getAlias(), "puts");                 // verbatim, case-preserved
     EXPECT_EQ(symbol->getSymbolName(), "puts");            // emitted name prefers the alias
-    EXPECT_EQ(symbol->getName(), "PUTS");                  // canonical name is still upper-cased
+    EXPECT_EQ(symbol->getName().str(), "PUTS");            // canonical name is still upper-cased
 }
 
 TEST(SemaExprTests, ExternCBlockFormAliasesAll) {
@@ -633,3 +957,112 @@ TEST(SemaExprTests, ExternUnsupportedLanguageRejected) {
     // Unsupported linkage is rejected by the parser.
     EXPECT_TRUE(parseFails("EXTERN \"Rust\" DECLARE SUB foo(x AS INTEGER)"));
 }
+
+// =============================================================================
+// Scopes — names resolve to the innermost declaration in scope
+// =============================================================================
+
+TEST(SemaExprTests, LocalShadowsGlobalInsideItsBody) {
+    Context context;
+    auto* module = analyse(context, "DIM x AS INTEGER = 1\n"
+                                    "FUNCTION f() AS DOUBLE\n"
+                                    "    DIM x AS DOUBLE = 2\n"
+                                    "    RETURN x\n"
+                                    "END FUNCTION\n"
+                                    "DIM y = x\n");
+    ASSERT_NE(module, nullptr);
+    const auto stmts = module->getStmtList()->getStmts();
+    ASSERT_EQ(stmts.size(), 3U);
+
+    // inside f, x is the local DOUBLE
+    auto* func = llvm::cast<AstFuncStmt>(stmts[1]);
+    auto* ret = llvm::cast<AstReturnStmt>(func->getStmtList()->getStmts()[1]);
+    EXPECT_TRUE(ret->getExpr()->getType()->isDouble());
+
+    // after f, x is the global INTEGER again
+    auto* dim = llvm::cast<AstDimStmt>(stmts[2]);
+    EXPECT_TRUE(dim->getDecls().front()->getType()->isInteger());
+}
+
+TEST(SemaExprTests, ParametersShareTheBodyScope) {
+    EXPECT_TRUE(semaFails("SUB s(a AS INTEGER)\n    DIM a = 1\nEND SUB\n"));
+    EXPECT_TRUE(semaFails("SUB s(a AS INTEGER, a AS INTEGER)\nEND SUB\n"));
+    EXPECT_FALSE(semaFails("DIM a = 1\nSUB s(a AS INTEGER)\nEND SUB\n"));
+}
+
+TEST(SemaExprTests, LocalsAreNotVisibleOutsideTheirBody) {
+    EXPECT_TRUE(semaFails("SUB s\n    DIM local = 1\nEND SUB\nDIM y = local\n"));
+    EXPECT_TRUE(semaFails("SUB s(a AS INTEGER)\nEND SUB\nDIM y = a\n"));
+}
+
+// =============================================================================
+// Parallel analysis of function bodies
+// =============================================================================
+
+namespace {
+
+/**
+ * Program with enough consecutive SUB and FUNCTION definitions to analyse their
+ * bodies in parallel. Bodies in @param broken use an undeclared identifier.
+ */
+auto manyBodies(const std::initializer_list<std::size_t> broken = {}) -> std::string {
+    std::string source = "DIM scale AS DOUBLE = 1.5\n";
+    for (std::size_t index = 0; index < SemanticAnalyser::kParallelBodies * 2; index++) {
+        const auto name = std::to_string(index);
+        source += "FUNCTION f" + name + "(a AS INTEGER) AS DOUBLE\n";
+        source += "    DIM x = a * " + name + " * scale\n";
+        source += std::ranges::contains(broken, index) ? "    x = missing" + name + "\n" : "    x = x + 1\n";
+        // declarations in a body allocate their parameter lists while workers run
+        source += "    DECLARE FUNCTION g" + name + "(b AS INTEGER, c AS DOUBLE) AS INTEGER\n";
+        source += "    RETURN x\n";
+        source += "END FUNCTION\n";
+    }
+    return source;
+}
+
+/** Parse and analyse @param source, expecting sema to fail, and get the error. */
+auto analyseFailure(Context& context, const llvm::StringRef source) -> DiagIndex {
+    context.getDiag().setAutoPrint(false);
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(source, "test");
+    const auto id = context.getSourceMgr().AddNewSourceBuffer(std::move(buffer), llvm::SMLoc {});
+    Parser parser { context, id };
+    const auto parsed = parser.parse();
+    EXPECT_TRUE(parsed.has_value()) << "parse failed";
+    if (!parsed.has_value()) {
+        return {};
+    }
+    const auto result = SemanticAnalyser { context }.analyse(**parsed);
+    EXPECT_FALSE(result.has_value()) << "sema succeeded";
+    return result.has_value() ? DiagIndex {} : result.error();
+}
+
+} // namespace
+
+TEST(SemaExprTests, ParallelBodiesAreAnalysed) {
+    Context context;
+    auto* module = analyse(context, manyBodies());
+    ASSERT_NE(module, nullptr);
+
+    std::size_t bodies = 0;
+    for (auto* stmt : module->getStmtList()->getStmts()) {
+        auto* func = llvm::dyn_cast<AstFuncStmt>(stmt);
+        if (func == nullptr) {
+            continue;
+        }
+        bodies++;
+        auto* dim = llvm::cast<AstDimStmt>(func->getStmtList()->getStmts().front());
+        const auto* symbol = dim->getDecls().front()->getSymbol();
+        ASSERT_NE(symbol, nullptr);
+        EXPECT_TRUE(symbol->getType()->isDouble()) << symbol->getName().str();
+    }
+    EXPECT_EQ(bodies, SemanticAnalyser::kParallelBodies * 2);
+}
+
+TEST(SemaExprTests, ParallelBodiesReportErrorsInSourceOrder) {
+    Context context;
+    const auto error = analyseFailure(context, manyBodies({ SemanticAnalyser::kParallelBodies + 3, 2 }));
+    EXPECT_EQ(context.getDiag().getKind(error), DiagKind::undeclaredIdentifier);
+    EXPECT_EQ(context.getDiag().count(llvm::SourceMgr::DK_Error), 1U);
+    // function f2 starts on line 14, its broken statement is the third in its body
+    EXPECT_EQ(context.getDiag().getDiagnostic(error).getLineNo(), 16);
+}
@@ -130,6 +130,32 @@ TEST_F(TypeComparisonTests, CrossSignImplicit) {
     }
 }
 
+// =============================================================================
+// Pointer width integrals: INTEGER and UINTEGER widen by the target's width
+// =============================================================================
+
+TEST_F(TypeComparisonTests, PointerWidthIntegralImplicit) {
+    for (const auto bitness : { CompileOptions::Bitness::Bits32, CompileOptions::Bitness::Bits64 }) {
+        CompileOptions options;
+        options.setBitness(bitness);
+        Context target { options };
+        auto& types = target.getTypeFactory();
+
+        const TypeIntegral* integrals[] = {
+            types.getByte(), types.getShort(), types.getInteger(), types.getLong(), types.getLongInt(),
+            types.getUByte(), types.getUShort(), types.getUInteger(), types.getULong(), types.getULongInt()
+        };
+        for (const auto* to : integrals) {
+            for (const auto* from : integrals) {
+                const auto widens = to->getBytes() > from->getBytes() && (to->isSigned() || !from->isSigned());
+                EXPECT_EQ(to->convertible(from, C::Implicit), to == from || widens)
+                    << to->string() << " <- " << from->string() << " on " << target.getTriple().str();
+                expectCast(to, from);
+            }
+        }
+    }
+}
+
 // =============================================================================
 // Integer <-> floating-point: rejected implicitly, allowed by cast
 // =============================================================================
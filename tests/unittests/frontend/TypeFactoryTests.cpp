@@ -1,5 +1,6 @@
 #include "pch.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 #include "Driver/Context.hpp"
 #include "Type/Aggregate.hpp"
 #include "Type/Compound.hpp"
@@ -193,3 +194,42 @@ TEST(TypeFactoryTests, FunctionDistinctParams) {
     std::array<const Type*, 1> p2 { tf.getBool() };
     EXPECT_NE(tf.getFunction(p1, tf.getVoid()), tf.getFunction(p2, tf.getVoid()));
 }
+
+// ------------------------------------
+// Concurrency
+// ------------------------------------
+
+TEST(TypeFactoryTests, ConcurrentCreationPreservesIdentity) {
+    Context context;
+    auto& tf = context.getTypeFactory();
+    constexpr std::size_t threads = 8;
+    const std::array<const Type*, 8> bases {
+        tf.getBool(), tf.getZString(), tf.getByte(), tf.getShort(), tf.getInteger(), tf.getULongInt(), tf.getSingle(), tf.getDouble()
+    };
+
+    /// Types one thread got, in creation order
+    using Created = std::vector<const Type*>;
+    std::array<Created, threads> created;
+    {
+        std::vector<std::jthread> workers;
+        for (auto& types : created) {
+            workers.emplace_back([&tf, &bases, &types] {
+                for (const auto* base : bases) {
+                    const auto* ptr = tf.getPointer(base);
+                    std::array<const Type*, 2> params { base, ptr };
+                    types.push_back(ptr);
+                    types.push_back(tf.getPointer(ptr));
+                    types.push_back(tf.getReference(base));
+                    types.push_back(tf.getConst(base));
+                    types.push_back(tf.getFunction(params, base));
+                }
+            });
+        }
+    }
+
+    // Every thread got the same objects, which later lookups find again
+    for (const auto& types : created) {
+        EXPECT_EQ(types, created.front());
+    }
+    EXPECT_EQ(tf.getPointer(bases.front()), created.front().front());
+}
@@ -15,7 +15,10 @@ AstGen::AstGen(
     StringRef ns,
     std::vector<StringRef> includes
 )
-: TreeGen(os, records, generator, "Ast", ns, std::move(includes)) {}
+: TreeGen(os, records, generator, "Ast", ns, std::move(includes))
+, m_layout(records, getRoot(), getKindEnumName()) {
+    applyLayout(m_layout);
+}
 
 auto AstGen::run() -> bool {
     header();
@@ -24,10 +27,39 @@ auto AstGen::run() -> bool {
     newline();
     treeForwardDeclare();
     treeGroups(getRoot());
+    nodeSizes();
+    nodePools();
     footer();
+    sizeReport();
     return false;
 }
 
+/**
+ * Generate node methods, followed by forEachField, which hands every data
+ * member of the node to a callable so AstImage can encode and fix up the
+ * members in place. Classes without own members inherit it.
+ */
+void AstGen::treeNodeMethods(const lib::TreeNode* node) {
+    TreeGen::treeNodeMethods(node);
+
+    const auto& members = node->getLayout();
+    if (members.empty()) {
+        return;
+    }
+    scope(Scope::Public);
+    comment("Call fn with every data member, base class members first");
+    line("template <typename Fn>", "");
+    block("constexpr void forEachField(Fn&& fn)", [&] {
+        if (not node->isRoot()) {
+            line(node->getParent()->getClassName() + "::forEachField(fn)");
+        }
+        for (const auto* member : members) {
+            line("fn(m_" + member->getName() + ")");
+        }
+    });
+    newline();
+}
+
 /**
  * Generate forward declarations of types required by ast
  */
@@ -40,3 +72,93 @@ void AstGen::forwardDecls() {
     });
     newline();
 }
+
+/**
+ * Assert the computed node sizes, so the layout and the size report never
+ * drift from what the compiler does. MSVC does not reuse base tail padding,
+ * so the check is limited to Itanium ABI 64-bit targets.
+ */
+void AstGen::nodeSizes() {
+    section("Node sizes");
+    line("#if INTPTR_MAX == INT64_MAX && !defined(_MSC_VER)", "");
+    getRoot()->visit([&](const lib::TreeNode* node) {
+        const auto& name = node->getClassName();
+        line("static_assert(sizeof(" + name + ") == " + std::to_string(m_layout.get(node).size) + ", \"" + name + " layout differs from Ast.td\")");
+    });
+    line("#endif", "");
+    newline();
+}
+
+/**
+ * Generate the slab pools nodes are allocated from, one per top level group
+ * and one for leaves directly under the root, with lookups by kind and by
+ * class. AstArena allocates from them.
+ */
+void AstGen::nodePools() {
+    std::vector<const lib::TreeNode*> groups;
+    for (const auto& child : getRoot()->getChildren()) {
+        if (child->isGroup()) {
+            groups.push_back(child.get());
+        }
+    }
+
+    section("Node pools");
+    doc("Slab pools nodes are allocated from. Each top level group has its own,\n"
+        "so nodes of one group are contiguous in memory.");
+    block("enum class AstPool : std::uint8_t", true, [&] {
+        line(getRoot()->getEnumName(), ",");
+        for (const auto* group : groups) {
+            line(group->getEnumName(), ",");
+        }
+    });
+    newline();
+
+    comment("Number of node pools");
+    line("inline constexpr std::size_t AST_POOL_COUNT = " + std::to_string(groups.size() + 1));
+    newline();
+
+    doc("Get the pool nodes of given kind are allocated from");
+    block("[[nodiscard]] constexpr auto getAstPool(const AstKind kind) -> AstPool", [&] {
+        for (const auto* group : groups) {
+            const auto range = group->getLeafRange();
+            if (not range) {
+                continue;
+            }
+            block("if (kind >= AstKind::" + range->first->getEnumName() + " && kind <= AstKind::" + range->second->getEnumName() + ")", [&] {
+                line("return AstPool::" + group->getEnumName());
+            });
+        }
+        line("return AstPool::" + getRoot()->getEnumName());
+    });
+    newline();
+
+    doc("Get the pool nodes of class T are allocated from");
+    line("template <std::derived_from<AstRoot> T>", "");
+    block("[[nodiscard]] consteval auto getAstPool() -> AstPool", [&] {
+        for (const auto* group : groups) {
+            block("if constexpr (std::derived_from<T, " + group->getClassName() + ">)", [&] {
+                line("return AstPool::" + group->getEnumName());
+            });
+        }
+        line("return AstPool::" + getRoot()->getEnumName());
+    });
+    newline();
+}
+
+/**
+ * Print size and padding of every concrete node to the build log.
+ */
+void AstGen::sizeReport() const {
+    auto& os = llvm::errs();
+    os << "AST node sizes (64-bit):\n";
+    getRoot()->visit(lib::TreeNode::Kind::Leaf, [&](const lib::TreeNode* node) {
+        std::size_t used = 0;
+        for (const auto* klass = node; klass != nullptr; klass = klass->getParent()) {
+            for (const auto& field : m_layout.get(klass).fields) {
+                used += field.size;
+            }
+        }
+        const auto size = m_layout.get(node).size;
+        os << std::format("  {:<20} {:>4} bytes, {:>2} padding\n", node->getClassName(), size, size - used);
+    });
+}
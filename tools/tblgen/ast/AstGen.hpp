@@ -14,7 +14,11 @@ using namespace llvm;
  * TableGen backend that reads Ast.td and emits Ast.hpp. Uses default
  * TreeGen tree-loading and code generation for: AstKind enum, forward
  * declarations, and complete C++ class definitions with constructors,
- * accessors, and data members. Only adds AST-specific forward declarations.
+ * accessors, and data members. Adds AST-specific forward declarations, and
+ * orders data members to minimise padding. The resulting node sizes are
+ * printed during the build and checked by static asserts in Ast.hpp.
+ * Emits the per-group slab pools used by AstArena, and forEachField on
+ * every node for the module image reader and writer.
  */
 class AstGen : public lib::TreeGen<> {
 public:
@@ -26,12 +30,20 @@ public:
         StringRef generator = genName,
         StringRef ns = "lbc",
         std::vector<StringRef> includes = {
-            "pch.hpp", "Symbol/LiteralValue.hpp", "Lexer/TokenKind.hpp", "Ast/ValueCategory.hpp", "Symbol/ExternKind.hpp" }
+            "pch.hpp", "Diag/SourceRange.hpp", "Symbol/LiteralValue.hpp", "Lexer/TokenKind.hpp", "Ast/ValueCategory.hpp", "Symbol/ExternKind.hpp", "Symbol/Identifier.hpp" }
     );
 
     [[nodiscard]] auto run() -> bool override;
 
+protected:
+    void treeNodeMethods(const lib::TreeNode* node) override;
+
 private:
     void forwardDecls();
+    void nodeSizes();
+    void nodePools();
+    void sizeReport() const;
+
+    lib::TreeLayout m_layout;
 };
 } // namespace ast
@@ -16,6 +16,7 @@ auto AstVisitorGen::run() -> bool {
     visitorBaseClass();
     visitorClasses();
     visitFunction();
+    childFunction();
     footer();
     return false;
 }
@@ -190,3 +191,81 @@ void AstVisitorGen::caseForward(const lib::TreeNode* klass) {
     line("case AstKind::" + klass->getEnumName(), ":");
     line("    return std::forward<Callable>(callable)(llvm::cast<" + klass->getClassName() + ">(ast))");
 }
+
+/**
+ * Generate forEachChild, which enumerates the nodes owned by a node
+ */
+void AstVisitorGen::childFunction() {
+    newline();
+    doc([&] {
+        line("Call a callable with every node owned by the given node, in source order.", "");
+        line("Null children are skipped. Non-owning links (Ref in Ast.td) are not", "");
+        line("enumerated, so a walk built on this reaches every node exactly once.", "");
+        newline();
+        line("@code", "");
+        line("forEachChild(ast, [&](AstRoot& child) { stack.push_back(&child); })");
+        line("@endcode", "");
+    });
+
+    line("template <typename Callable>", "");
+    block("constexpr void forEachChild(const AstRoot& ast, Callable&& callable)", [&] {
+        block("switch (ast.getKind())", [&] {
+            getRoot()->visit(lib::TreeNode::Kind::Leaf, [&](const lib::TreeNode* node) {
+                caseChildren(node);
+            });
+            line("default", ":");
+            line("    break");
+        });
+    });
+}
+
+/**
+ * Generate case statement enumerating the children of given node
+ */
+void AstVisitorGen::caseChildren(const lib::TreeNode* klass) {
+    // owned node links, from the root class down, in .td order
+    std::vector<const lib::TreeNodeArg*> children;
+    std::vector<const lib::TreeNode*> chain;
+    for (const auto* node = klass; node != nullptr; node = node->getParent()) {
+        chain.insert(chain.begin(), node);
+    }
+    for (const auto* node : chain) {
+        for (const auto& arg : node->getArgs()) {
+            if (isChild(*arg)) {
+                children.push_back(arg.get());
+            }
+        }
+    }
+    if (children.empty()) {
+        return;
+    }
+
+    block("case AstKind::" + klass->getEnumName() + ":", [&] {
+        line("const auto& node = llvm::cast<" + klass->getClassName() + ">(ast)");
+        for (const auto* arg : children) {
+            const auto getter = "node.get" + ucfirst(arg->getName()) + "()";
+            if (arg->getType().starts_with("std::span<")) {
+                block("for (auto* child : " + getter + ")", [&] {
+                    line("callable(*child)");
+                });
+            } else {
+                block("if (auto* child = " + getter + ")", [&] {
+                    line("callable(*child)");
+                });
+            }
+        }
+        line("break");
+    });
+}
+
+/**
+ * Check if given member links to nodes owned by its node
+ */
+auto AstVisitorGen::isChild(const lib::TreeNodeArg& arg) -> bool {
+    if (not arg.isOwned()) {
+        return false;
+    }
+    const StringRef type = arg.getType();
+    return (type.starts_with("Ast") && type.ends_with("*"))
+        || (type.starts_with("std::span<Ast") && type.ends_with("*>"));
+}
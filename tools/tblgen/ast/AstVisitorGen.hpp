@@ -7,7 +7,8 @@ namespace ast {
 /**
  * TableGen backend that reads Ast.td and emits AstVisitor.hpp.
  * Generates a CRTP-free visitor base class using C++23 deducing this,
- * with a switch-based dispatch method and per-node accept handlers.
+ * with a switch-based dispatch method and per-node accept handlers,
+ * and forEachChild for walking the tree without recursion.
  */
 class AstVisitorGen final : public AstGen {
 public:
@@ -30,5 +31,9 @@ private:
 
     void visitFunction();
     void caseForward(const lib::TreeNode* klass);
+
+    void childFunction();
+    void caseChildren(const lib::TreeNode* klass);
+    [[nodiscard]] static auto isChild(const lib::TreeNodeArg& arg) -> bool;
 };
 } // namespace ast
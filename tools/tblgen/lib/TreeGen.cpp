@@ -5,6 +5,16 @@
 using namespace lib;
 using namespace std::string_literals;
 
+void TreeGenBase::applyLayout(const TreeLayout& layout) {
+    const auto apply = [&](this auto&& self, TreeNode* node) -> void {
+        node->setLayout(layout.order(node));
+        for (const auto& child : node->getChildren()) {
+            self(child.get());
+        }
+    };
+    apply(m_root.get());
+}
+
 void TreeGenBase::treeKindEnum() {
     doc("Enumerates all concrete tree nodes");
     block("enum class " + getKindEnumName() + " : std::uint8_t", true, [&] {
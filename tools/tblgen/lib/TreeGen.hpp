@@ -4,6 +4,7 @@
 #pragma once
 #include <concepts>
 #include "GeneratorBase.hpp"
+#include "TreeLayout.hpp"
 #include "TreeNode.hpp"
 namespace lib {
 class TreeGenBase : public GeneratorBase {
@@ -41,6 +42,9 @@ public:
 protected:
     void setRoot(std::unique_ptr<TreeNode> root) { m_root = std::move(root); }
 
+    /** Declare the data members of every node in the order given by @param layout. */
+    void applyLayout(const TreeLayout& layout);
+
     virtual void treeKindEnum();
     virtual void treeForwardDeclare();
     virtual void treeGroups(const TreeNode* node);
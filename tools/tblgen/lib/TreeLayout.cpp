@@ -0,0 +1,101 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#include "TreeLayout.hpp"
+#include <algorithm>
+#include <cassert>
+#include <llvm/Support/MathExtras.h>
+#include <llvm/TableGen/Error.h>
+#include <llvm/TableGen/Record.h>
+using namespace lib;
+
+namespace {
+/// Pointers are 8 bytes on every supported 64-bit target
+constexpr std::size_t kPointerSize = 8;
+} // namespace
+
+TreeLayout::TreeLayout(const llvm::RecordKeeper& records, const TreeNode* root, const llvm::StringRef kindEnum)
+: m_kindEnum(kindEnum) {
+    for (const auto* record : records.getAllDerivedDefinitions("Storage")) {
+        m_storage[record->getValueAsString("type")] = {
+            .size = static_cast<std::size_t>(record->getValueAsInt("size")),
+            .align = static_cast<std::size_t>(record->getValueAsInt("align")),
+        };
+    }
+    layout(root, nullptr);
+}
+
+auto TreeLayout::get(const TreeNode* node) const -> const Layout& {
+    const auto iter = m_layouts.find(node);
+    assert(iter != m_layouts.end() && "node has no layout");
+    return iter->second;
+}
+
+auto TreeLayout::order(const TreeNode* node) const -> std::vector<const TreeNodeArg*> {
+    std::vector<const TreeNodeArg*> args;
+    for (const auto& field : get(node).fields) {
+        if (field.arg != nullptr) {
+            args.push_back(field.arg);
+        }
+    }
+    return args;
+}
+
+auto TreeLayout::storage(const TreeNode* node, const llvm::StringRef type) const -> Storage {
+    if (type.back() == '*') {
+        return { .size = kPointerSize, .align = kPointerSize };
+    }
+    // a template is looked up by its name
+    const auto name = type.take_until([](const char ch) { return ch == '<'; });
+    const auto iter = m_storage.find(name);
+    if (iter == m_storage.end()) {
+        llvm::PrintFatalError(node->getRecord()->getLoc(), "No Storage defined for member type '" + type.str() + "'");
+    }
+    return iter->second;
+}
+
+void TreeLayout::layout(const TreeNode* node, const Layout* base) {
+    Layout result {
+        .fields = {},
+        .dataSize = base != nullptr ? base->dataSize : 0,
+        .size = 0,
+        .align = base != nullptr ? base->align : 1,
+    };
+
+    const auto place = [&](const TreeNodeArg* arg, const Storage& store) {
+        const auto offset = llvm::alignTo(result.dataSize, store.align);
+        result.fields.push_back({ .arg = arg, .offset = offset, .size = store.size });
+        result.dataSize = offset + store.size;
+        result.align = std::max(result.align, store.align);
+    };
+
+    if (node->isRoot()) {
+        place(nullptr, storage(node, m_kindEnum));
+    }
+
+    std::vector<std::pair<const TreeNodeArg*, Storage>> pending;
+    for (const auto& arg : node->getArgs()) {
+        pending.emplace_back(arg.get(), storage(node, arg->getType()));
+    }
+
+    while (!pending.empty()) {
+        // lowest offset first, stricter alignment on ties, min_element keeps .td order after that
+        const auto next = std::ranges::min_element(pending, [&](const auto& lhs, const auto& rhs) {
+            const auto lhsOffset = llvm::alignTo(result.dataSize, lhs.second.align);
+            const auto rhsOffset = llvm::alignTo(result.dataSize, rhs.second.align);
+            if (lhsOffset != rhsOffset) {
+                return lhsOffset < rhsOffset;
+            }
+            return lhs.second.align > rhs.second.align;
+        });
+        place(next->first, next->second);
+        pending.erase(next);
+    }
+
+    result.size = llvm::alignTo(result.dataSize, result.align);
+    const auto& placed = m_layouts.emplace(node, std::move(result)).first->second;
+
+    for (const auto& child : node->getChildren()) {
+        layout(child.get(), &placed);
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created by Albert Varaksin on 18/10/2026.
+//
+#pragma once
+#include <cstddef>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <unordered_map>
+#include <vector>
+#include "TreeNode.hpp"
+
+namespace llvm {
+class RecordKeeper;
+} // namespace llvm
+namespace lib {
+
+/**
+ * Lays out the data members of a tree node hierarchy the way the Itanium
+ * C++ ABI does on 64-bit targets, from the Storage records in the .td file.
+ *
+ * Members of each class are placed greedily: the next member is the one that
+ * lands at the lowest offset, preferring stricter alignment on ties and .td
+ * order after that. Bases are not POD, so a derived class starts at the data
+ * size of its base and small members fill the base's tail padding.
+ *
+ * The root class additionally holds the kind enum, always at offset 0.
+ */
+class TreeLayout final {
+public:
+    /// A placed data member
+    struct Field final {
+        const TreeNodeArg* arg; ///< member, nullptr for the root kind
+        std::size_t offset;     ///< byte offset in the complete object
+        std::size_t size;       ///< storage size
+    };
+
+    /// Layout of one class
+    struct Layout final {
+        std::vector<Field> fields; ///< own members in declaration order
+        std::size_t dataSize;      ///< size without tail padding
+        std::size_t size;          ///< sizeof
+        std::size_t align;         ///< alignof
+    };
+
+    TreeLayout(const llvm::RecordKeeper& records, const TreeNode* root, llvm::StringRef kindEnum);
+
+    /** Get the layout computed for @param node. */
+    [[nodiscard]] auto get(const TreeNode* node) const -> const Layout&;
+
+    /** Get own members of @param node in declaration order. */
+    [[nodiscard]] auto order(const TreeNode* node) const -> std::vector<const TreeNodeArg*>;
+
+private:
+    /// Storage requirements of a member type
+    struct Storage final {
+        std::size_t size;
+        std::size_t align;
+    };
+
+    [[nodiscard]] auto storage(const TreeNode* node, llvm::StringRef type) const -> Storage;
+    void layout(const TreeNode* node, const Layout* base);
+
+    llvm::StringMap<Storage> m_storage;
+    std::unordered_map<const TreeNode*, Layout> m_layouts;
+    std::string m_kindEnum;
+};
+
+} // namespace lib
@@ -2,6 +2,7 @@
 // Created by Albert Varaksin on 01/03/2026.
 //
 #include "TreeNode.hpp"
+#include <cassert>
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/TableGen/Record.h>
 #include "GeneratorBase.hpp"
@@ -36,12 +37,22 @@ TreeNode::TreeNode(TreeNode* parent, const TreeGenBase& ctx, const Record* recor
 
     // class args
     for (const auto& member : record->getValueAsListOfDefs("members")) {
-        if (member->hasDirectSuperClass(ctx.getArgClass())) {
+        if (member->isSubClassOf(ctx.getArgClass())) {
             m_args.emplace_back(ctx.makeArg(member));
         } else if (member->hasDirectSuperClass(ctx.getFuncClass())) {
             m_functions.emplace_back(unindent(member->getValueAsString("func")));
         }
     }
+
+    m_layout.reserve(m_args.size());
+    for (const auto& arg : m_args) {
+        m_layout.push_back(arg.get());
+    }
+}
+
+void TreeNode::setLayout(std::vector<const TreeNodeArg*> layout) {
+    assert(layout.size() == m_args.size() && "layout must hold every member");
+    m_layout = std::move(layout);
 }
 
 /**
@@ -149,10 +160,10 @@ auto TreeNode::ctorInitParams() const -> std::vector<std::string> {
         init.emplace_back(m_parent->getClassName() + "(" + super + ")");
     }
 
-    // class args
-    for (const auto& args : m_args) {
-        if (args->hasCtorParam()) {
-            init.emplace_back("m_" + args->getName() + "(" + args->getName() + ")");
+    // class args, in declaration order
+    for (const auto* arg : m_layout) {
+        if (arg->hasCtorParam()) {
+            init.emplace_back("m_" + arg->getName() + "(" + arg->getName() + ")");
         }
     }
 
@@ -161,7 +172,7 @@ auto TreeNode::ctorInitParams() const -> std::vector<std::string> {
 
 auto TreeNode::classArgs() const -> std::vector<std::string> {
     std::vector<std::string> args;
-    for (const auto& arg : m_args) {
+    for (const auto* arg : m_layout) {
         std::string decl = arg->getType() + " m_" + arg->getName();
         if (not arg->getDefault().empty()) {
             decl += " = " + arg->getDefault();
@@ -56,6 +56,10 @@ public:
     /** Whether this class introduces any new constructor parameters beyond its parent. */
     [[nodiscard]] auto hasOwnCtorParams() const -> bool;
     [[nodiscard]] auto getArgs() const -> const std::vector<std::unique_ptr<TreeNodeArg>>& { return m_args; }
+    /** Data members in declaration order. Defaults to the .td order. */
+    [[nodiscard]] auto getLayout() const -> const std::vector<const TreeNodeArg*>& { return m_layout; }
+    /** Reorder data members. @param layout must hold every arg of this node. */
+    void setLayout(std::vector<const TreeNodeArg*> layout);
     [[nodiscard]] auto getVisitorName() const -> std::string;
 
     [[nodiscard]] virtual auto getBaseClassName() const -> std::string;
@@ -93,6 +97,7 @@ private:
     std::string m_enumName;
     std::vector<std::unique_ptr<TreeNode>> m_children;
     std::vector<std::unique_ptr<TreeNodeArg>> m_args;
+    std::vector<const TreeNodeArg*> m_layout;
     std::vector<std::string> m_functions;
     Kind m_kind;
 };
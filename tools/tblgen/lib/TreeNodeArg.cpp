@@ -11,4 +11,5 @@ TreeNodeArg::TreeNodeArg(const llvm::Record* record)
 , m_default(record->getValueAsString("default"))
 , m_mutable(record->getValueAsBit("mutable"))
 , m_reference(record->getValueAsBit("reference"))
+, m_owned(record->getValue("owned") == nullptr || record->getValueAsBit("owned"))
 , m_ctorParam(m_default.empty()) {}
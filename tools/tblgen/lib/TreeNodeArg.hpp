@@ -10,8 +10,9 @@ class Record;
 namespace lib {
 /**
  * Wraps a TableGen Member record. Determines whether the member is a
- * constructor parameter (no default value) or an initialized field, and
- * whether a setter should be generated (mutable bit).
+ * constructor parameter (no default value) or an initialized field,
+ * whether a setter should be generated (mutable bit), and whether the
+ * member owns what it points to (cleared by Ref in .td).
  */
 class TreeNodeArg {
 public:
@@ -29,6 +30,8 @@ public:
         return m_type.back() != '*';
     }
     [[nodiscard]] auto passAsRef() const -> bool { return m_reference; }
+    /// Whether pointed to nodes belong to this node, false for back and cross references
+    [[nodiscard]] auto isOwned() const -> bool { return m_owned; }
 
 private:
     std::string m_name;
@@ -36,6 +39,7 @@ private:
     std::string m_default;
     bool m_mutable;
     bool m_reference;
+    bool m_owned;
     bool m_ctorParam;
 };
 } // namespace lib
@@ -1,6 +1,7 @@
 // Custom TableGen backend for generating token definitions.
 // Reads Tokens.td and emits TokenKinds.inc
 #include "TokensGen.hpp"
+#include <map>
 using namespace tokens;
 
 TokensGen::TokensGen(raw_ostream& os, const RecordKeeper& records)
@@ -300,10 +301,71 @@ auto TokensGen::run() -> bool {
             }
         }
 
+        // --------------------------------------------------------------------
+        // keyword recogniser
+        // --------------------------------------------------------------------
+        {
+            // keywords, type names and keyword-like operators, bucketed by
+            // length and then by first letter
+            std::map<std::size_t, std::map<char, std::vector<const Record*>>> buckets;
+            for (const auto* token : tokens) {
+                const auto str = token->getValueAsString("str");
+                const auto group = token->getValueAsDef("group")->getName();
+                if (group == "Keyword" || group == "Type" || (group == "Operator" && std::isalpha(str.front()) != 0)) {
+                    buckets[str.size()][str.front()].push_back(token);
+                }
+            }
+
+            doc("Recognise a keyword, type name or keyword-like operator from identifier\n"
+                "text, ignoring ASCII case. Dispatches on length and first letter, then\n"
+                "compares the remaining bytes in place. Returns Identifier if there is no match.");
+            block("[[nodiscard]] static constexpr auto fromIdentifier(const llvm::StringRef str) -> TokenKind", [&] {
+                line("// NOLINTBEGIN(*-magic-numbers)", "");
+                block("switch (str.size())", [&] {
+                    for (const auto& [length, letters] : buckets) {
+                        line("case " + std::to_string(length), ":");
+                        indent(false, [&] {
+                            block("switch (str[0])", [&] {
+                                for (const auto& [letter, candidates] : letters) {
+                                    const auto lower = static_cast<char>(std::tolower(letter));
+                                    line(std::format("case '{}': case '{}'", letter, lower), ":");
+                                    for (const auto* token : candidates) {
+                                        const auto str = quoted(token->getValueAsString("str"));
+                                        line("    if (equalsKeyword(str, " + str + ")) { return " + token->getName().str() + "; }", "");
+                                    }
+                                    line("    break");
+                                }
+                                line("default", ":");
+                                line("    break");
+                            });
+                            line("break");
+                        });
+                    }
+                    line("default", ":");
+                    line("    break");
+                });
+                line("// NOLINTEND(*-magic-numbers)", "");
+                line("return Identifier");
+            });
+            newline();
+        }
+
         // --------------------------------------------------------------------
         // value field
         // --------------------------------------------------------------------
         line("private:", "");
+        doc("Compare identifier text against an upper case keyword of the same length\n"
+            "and first letter. Identifier characters are letters, digits and '_', so\n"
+            "clearing bit 5 folds letters to upper case and never aliases the others.");
+        block("[[nodiscard]] static constexpr auto equalsKeyword(const llvm::StringRef str, const llvm::StringRef keyword) -> bool", [&] {
+            block("for (std::size_t idx = 1; idx < keyword.size(); ++idx)", [&] {
+                block("if ((static_cast<unsigned>(str[idx]) & 0xDFU) != static_cast<unsigned>(keyword[idx]))", [&] {
+                    line("return false");
+                }, "*-magic-numbers");
+            });
+            line("return true");
+        });
+        newline();
         line("Value m_value");
     });
     closeNamespace();
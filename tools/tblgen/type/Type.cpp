@@ -31,3 +31,7 @@ auto Type::getBackingClassName() const -> std::optional<llvm::StringRef> {
     }
     return value;
 }
+
+auto Type::getBytes() const -> std::int64_t {
+    return m_record->getValueAsInt("bytes");
+}
@@ -54,6 +54,9 @@ public:
     /** Get the backing C++ class name, if specified (e.g. "TypeIntegral"). */
     [[nodiscard]] auto getBackingClassName() const -> std::optional<llvm::StringRef>;
 
+    /** Get the size of a numeric type in bytes, 0 if it follows the target pointer width. */
+    [[nodiscard]] auto getBytes() const -> std::int64_t;
+
 private:
     /// The TableGen record defining this type
     const Record* m_record;
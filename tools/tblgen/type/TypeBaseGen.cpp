@@ -32,6 +32,7 @@ TypeBaseGen::TypeBaseGen(
 auto TypeBaseGen::run() -> bool {
     header();
     typeKind();
+    typeConversions();
     typeBaseClass();
     footer();
     return false;
@@ -60,6 +61,81 @@ void TypeBaseGen::typeKind() {
     });
 }
 
+void TypeBaseGen::typeConversions() {
+    doc("Conversion allowed from one singleton type kind to another");
+    block("enum class TypeConversion : std::uint8_t", true, [&] {
+        comment("Not convertible");
+        line("None", ",");
+        comment("Only by an explicit cast");
+        line("Cast", ",");
+        comment("Implicit if the target is wider, which depends on the target pointer width, otherwise by a cast");
+        line("ByWidth", ",");
+        comment("Implicit, and so by a cast as well");
+        line("Implicit", ",");
+    });
+    newline();
+
+    const auto count = std::to_string(m_singles.size());
+    doc("Conversions between singleton type kinds, indexed [to][from]");
+    space();
+    add("inline constexpr auto kTypeConversions = [] ");
+    indent(true, [&] {
+        line("using enum TypeConversion");
+        line("using Row = std::array<TypeConversion, " + count + ">");
+        block("return std::array<Row, " + count + ">", true, [&] {
+            line("// " + join(m_singles | std::views::transform(&Type::getEnumName)), "");
+            for (const auto* to : m_singles) {
+                const auto cells = m_singles | std::views::transform([&](const Type* from) {
+                    return conversion(to, from);
+                });
+                line("Row { " + join(cells) + " }", ", // " + to->getEnumName().str());
+            }
+        });
+    });
+    add("();\n");
+    newline();
+}
+
+auto TypeBaseGen::conversion(const Type* to, const Type* from) -> StringRef {
+    if (to == from) {
+        return "Implicit";
+    }
+
+    // numeric categories, by the names Types.td gives them
+    const auto family = [](const Type* type) { return type->getCategory()->getRecord()->getName(); };
+    const auto isNumeric = [](const StringRef name) {
+        return name == "SignedIntegral" || name == "UnsignedIntegral" || name == "FloatingPoint";
+    };
+    const auto toFamily = family(to);
+    const auto fromFamily = family(from);
+    if (not isNumeric(toFamily) || not isNumeric(fromFamily)) {
+        return "None";
+    }
+
+    // widening within a family, or from unsigned to a wider signed integral
+    const auto widens = [&](const std::int64_t pointerBytes) {
+        const auto toBytes = to->getBytes() == 0 ? pointerBytes : to->getBytes();
+        const auto fromBytes = from->getBytes() == 0 ? pointerBytes : from->getBytes();
+        if (toBytes <= fromBytes) {
+            return false;
+        }
+        if (toFamily == "FloatingPoint" || fromFamily == "FloatingPoint") {
+            return toFamily == fromFamily;
+        }
+        return toFamily == "SignedIntegral" || fromFamily == "UnsignedIntegral";
+    };
+
+    const auto narrow = widens(4);
+    const auto wide = widens(8);
+    if (narrow && wide) {
+        return "Implicit";
+    }
+    if (narrow || wide) {
+        return "ByWidth";
+    }
+    return "Cast";
+}
+
 void TypeBaseGen::typeBaseClass() {
     doc("Base class for types");
     block("class TypeBase", true, [&] {
@@ -138,6 +214,12 @@ void TypeBaseGen::typeQueryMethods() {
         }
         newline();
     }
+
+    if (not m_singles.empty()) {
+        comment("Types with a single instance, the kinds kTypeConversions covers");
+        predicate("singleton", true, "m_kind <= TypeKind::" + m_singles.back()->getEnumName());
+        newline();
+    }
 }
 
 void TypeBaseGen::typeToKeyword() {
@@ -8,7 +8,8 @@ namespace type {
  * TableGen backend that reads Types.td and emits TypeBase.hpp.
  *
  * Generates the TypeKind enum, the TypeBase class with per-kind and
- * per-category query predicates, and a keyword-to-type mapping.
+ * per-category query predicates, a keyword-to-type mapping, and the
+ * table of conversions between singleton types.
  * Singleton types are partitioned to the front of the category list
  * so their TypeKind ordinals form a contiguous range.
  */
@@ -60,6 +61,12 @@ private:
     /** Emit the TypeKind enum. */
     void typeKind();
 
+    /** Emit the TypeConversion enum and the kTypeConversions table. */
+    void typeConversions();
+
+    /** Get the TypeConversion enumerator for converting @p from to @p to. */
+    [[nodiscard]] static auto conversion(const Type* to, const Type* from) -> StringRef;
+
     /** Emit the TypeBase class definition. */
     void typeBaseClass();
 